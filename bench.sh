@@ -0,0 +1,305 @@
+#!/bin/bash
+# Benchmarks and equivalence checks of analysis options.
+# type './bench.sh <experiment> [module.bc ...]', e.g., './bench.sh cycles foo.bc bar.bc'
+# The SVF executables are taken from $PTABIN (set by setup.sh), or from $SVFHOME/Release-build/bin.
+# Checks without modules run over the .ll files of the Test-Suite.
+#
+# benchmarks (print the stats of each run, times in secs):
+#   ptset     points-to set representations (-ptset) of -ander
+#   worklist  worklist strategies (-worklist) of -nander, -ander and -fspta
+#   cycles    online cycle detection (-cycle-detection) of -nander and -ander
+#   varsubst  offline variable substitution (-ander-var-subst) of the Andersen variants
+#   densemap  -nander and -ander of $PTABIN/wpa against $WPA_BASE, a wpa built with map node storage
+#   pagsnap   startup without PAG snapshots, writing a snapshot (cold) and restoring it (warm)
+#   cond      condition backends (-cond-backend) of the saber memory leak checker
+# checks (compare the points-to sets of two runs, exit non-zero if any differ):
+#   vfs       -vfspta against -fspta
+#   varsubst-check  the Andersen variants with -ander-var-subst on and off
+#   dda       -dfs and -cxt queries answered on all hardware threads (-dda-threads=0) against one
+
+#########
+# VARs
+########
+if [ -z "$PTABIN" ]
+then
+    PTABIN=$SVFHOME/Release-build/bin
+fi
+WPA=$PTABIN/wpa
+SABER=$PTABIN/saber
+DDA=$PTABIN/dda
+SVFTests=$SVFHOME/Test-Suite
+
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+FAILED=0
+
+if [ $# -lt 1 ]
+then
+    sed -n '2,/^$/p' "$0" | sed 's/^# \{0,1\}//'
+    exit 1
+fi
+EXPERIMENT=$1
+shift
+
+# Benchmarks need modules
+function need_modules {
+    if [ $# -eq 0 ]
+    then
+        echo "usage: $0 $EXPERIMENT module.bc [module.bc ...]"
+        exit 1
+    fi
+}
+
+# Fails unless executable $1 exists
+function check_exe {
+    if [ ! -x "$1" ]
+    then
+        echo "$(basename "$1") not found at '$1', set PTABIN or SVFHOME"
+        exit 1
+    fi
+}
+
+# Prints the last value of stat $1 in $OUT, i.e., the one of the analysis itself
+function stat_of {
+    echo "$OUT" | awk -v key="$1" '$1 == key { v = $2 } END { print v }'
+}
+
+# Runs "$@" into $OUT, sets $WALL to its wall time and returns its status
+function run {
+    local start=$(date +%s.%N)
+    OUT=$("$@" 2>&1)
+    local status=$?
+    local end=$(date +%s.%N)
+    WALL=$(echo "$start $end" | awk '{ printf "%.2f", $2 - $1 }')
+    return $status
+}
+
+# Prints a row of fixed width columns, the module and the options first
+function row {
+    printf "%-30s %-34s" "$1" "$2"
+    shift 2
+    printf " %-14s" "$@"
+    printf "\n"
+}
+
+# Runs wpa with options $2 on module $1 for each stat name in the rest
+function wpa_stats {
+    local module=$1
+    local opts=$2
+    shift 2
+    if ! run "$WPA" $opts -marked-clocks-only "$module"
+    then
+        row "$(basename "$module")" "$opts" "wpa failed"
+        return
+    fi
+    local values=()
+    for key in "$@"
+    do
+        values+=("$(stat_of "$key")")
+    done
+    row "$(basename "$module")" "$opts" "${values[@]}"
+}
+
+# Compares the points-to sets (printed by option $3) of module $2 with executable $1
+# under options $4 and $5
+function compare_pts {
+    local exe=$1
+    local module=$2
+    local print=$3
+    "$exe" $4 $print -stat=false "$module" > "$TMP/a.out" 2>/dev/null
+    local a=$?
+    "$exe" $5 $print -stat=false "$module" > "$TMP/b.out" 2>/dev/null
+    local b=$?
+    if [ $a -ne 0 ] || [ $b -ne 0 ]
+    then
+        row "$(basename "$module")" "$4" "$(basename "$exe") failed"
+        FAILED=1
+    elif cmp -s "$TMP/a.out" "$TMP/b.out"
+    then
+        row "$(basename "$module")" "$4" "ok"
+    else
+        row "$(basename "$module")" "$4" "differ"
+        diff "$TMP/a.out" "$TMP/b.out" | head -20
+        FAILED=1
+    fi
+}
+
+# Modules of a check, the Test-Suite by default
+function check_modules {
+    if [ $# -eq 0 ]
+    then
+        find "$SVFTests" -name '*.ll' | sort
+    else
+        printf "%s\n" "$@"
+    fi
+}
+
+case $EXPERIMENT in
+ptset)
+    need_modules "$@"
+    check_exe "$WPA"
+    row "module" "options" "TotalTime" "PeakMem(KB)" "PtsSetMem(KB)"
+    for MODULE in "$@"
+    do
+        for TYPE in sbv cbv fsv
+        do
+            wpa_stats "$MODULE" "-ander -ptset=$TYPE" TotalTime "PeakMem(KB)" "PtsSetMem(KB)"
+        done
+    done
+    ;;
+worklist)
+    need_modules "$@"
+    check_exe "$WPA"
+    row "module" "options" "TotalTime" "WorklistPops"
+    for MODULE in "$@"
+    do
+        for PTA in nander ander fspta
+        do
+            for WL in fifo dfifo lrf topo
+            do
+                wpa_stats "$MODULE" "-$PTA -worklist=$WL" TotalTime WorklistPops
+            done
+        done
+    done
+    ;;
+cycles)
+    need_modules "$@"
+    check_exe "$WPA"
+    row "module" "options" "TotalTime" "SCCDetectTime" "SCCMergeTime" "NumOfSCCDetect"
+    for MODULE in "$@"
+    do
+        for PTA in nander ander
+        do
+            for CD in none lazy hybrid hybrid-lazy
+            do
+                wpa_stats "$MODULE" "-$PTA -cycle-detection=$CD" TotalTime SCCDetectTime SCCMergeTime NumOfSCCDetect
+            done
+        done
+        # selective cycle detection, for reference
+        for PTA in sander sfrander
+        do
+            wpa_stats "$MODULE" "-$PTA" TotalTime SCCDetectTime SCCMergeTime NumOfSCCDetect
+        done
+    done
+    ;;
+varsubst)
+    need_modules "$@"
+    check_exe "$WPA"
+    row "module" "options" "TotalTime" "VarSubstTime" "VarSubstNodes" "VarSubstEdges" "WorklistPops"
+    for MODULE in "$@"
+    do
+        for PTA in nander ander lander hander sander
+        do
+            for VS in false true
+            do
+                wpa_stats "$MODULE" "-$PTA -ander-var-subst=$VS" TotalTime VarSubstTime VarSubstNodes VarSubstEdges WorklistPops
+            done
+        done
+    done
+    ;;
+densemap)
+    need_modules "$@"
+    check_exe "$WPA"
+    check_exe "$WPA_BASE"
+    row "module" "options" "TotalTime" "SCCDetectTime" "CopyGepTime" "Wall"
+    for MODULE in "$@"
+    do
+        for PTA in nander ander
+        do
+            for NODES in map dense
+            do
+                BIN=$WPA
+                if [ $NODES == map ]
+                then
+                    BIN=$WPA_BASE
+                fi
+                if run "$BIN" -$PTA "$MODULE"
+                then
+                    row "$(basename "$MODULE")" "-$PTA ($NODES)" "$(stat_of TotalTime)" "$(stat_of SCCDetectTime)" "$(stat_of CopyGepTime)" "$WALL"
+                else
+                    row "$(basename "$MODULE")" "-$PTA ($NODES)" "wpa failed"
+                fi
+            done
+        done
+    done
+    ;;
+pagsnap)
+    need_modules "$@"
+    check_exe "$WPA"
+    # -nander, whose solving is short
+    row "module" "none" "cold" "warm" "SnapKB"
+    for MODULE in "$@"
+    do
+        rm -rf "$TMP/snap" && mkdir "$TMP/snap"
+        TIMES=()
+        for OPTS in "" "-pag-snapshot-dir=$TMP/snap" "-pag-snapshot-dir=$TMP/snap"
+        do
+            if run "$WPA" -nander -stat=false $OPTS "$MODULE"
+            then
+                TIMES+=("$WALL")
+            else
+                TIMES+=("failed")
+            fi
+        done
+        row "$(basename "$MODULE")" "${TIMES[@]}" "$(du -k "$TMP/snap" | awk '{ print $1 }')"
+    done
+    ;;
+cond)
+    need_modules "$@"
+    check_exe "$SABER"
+    # fewer reports with the same Approx mean guards reduced more precisely
+    row "module" "options" "Wall" "CondMem" "CondNum" "Approx" "NeverFree" "PartialLeak"
+    for MODULE in "$@"
+    do
+        for BACKEND in bdd dag
+        do
+            if ! run "$SABER" -leak -guard-stat -cond-backend=$BACKEND "$MODULE"
+            then
+                row "$(basename "$MODULE")" "-cond-backend=$BACKEND" "saber failed"
+                continue
+            fi
+            MEM=$(echo "$OUT" | awk -F': ' '/^BDD Mem usage/ { v = $2 } END { print v }')
+            NUM=$(echo "$OUT" | awk -F': ' '/^BDD Number/ { v = $2 } END { print v }')
+            APPROX=$(echo "$OUT" | awk -F': ' '/^Over-approximated conditions/ { v = $2 } END { print v }')
+            row "$(basename "$MODULE")" "-cond-backend=$BACKEND" "$WALL" "$MEM" "$NUM" "$APPROX" \
+                "$(echo "$OUT" | grep -c "NeverFree :")" "$(echo "$OUT" | grep -c "PartialLeak :")"
+        done
+    done
+    ;;
+vfs)
+    check_exe "$WPA"
+    row "module" "options" "pts"
+    for MODULE in $(check_modules "$@")
+    do
+        compare_pts "$WPA" "$MODULE" -print-pts -vfspta -fspta
+    done
+    ;;
+varsubst-check)
+    check_exe "$WPA"
+    row "module" "options" "pts"
+    for MODULE in $(check_modules "$@")
+    do
+        for PTA in nander ander lander hander sander
+        do
+            compare_pts "$WPA" "$MODULE" -print-all-pts "-$PTA -ander-var-subst=true" "-$PTA -ander-var-subst=false"
+        done
+    done
+    ;;
+dda)
+    check_exe "$DDA"
+    row "module" "options" "pts"
+    for MODULE in $(check_modules "$@")
+    do
+        for PTA in dfs cxt
+        do
+            compare_pts "$DDA" "$MODULE" -print-query-pts "-$PTA -dda-threads=0" "-$PTA -dda-threads=1"
+        done
+    done
+    ;;
+*)
+    echo "unknown experiment '$EXPERIMENT', type '$0' for the list"
+    exit 1
+    ;;
+esac
+
+exit $FAILED
@@ -76,6 +76,16 @@ public:
 private:
     /// Print queries' pts
     void printQueryPTS();
+    /// Answer queries from stdin or a socket (-dda-server)
+    void serveQueries();
+    /// Create a demand-driven analysis of the given kind
+    PointerAnalysis* createDDA(PAG* pag, u32_t kind);
+    /// Answer the client's queries on several threads (-dda-threads)
+    void answerQueriesInParallel(PAG* pag, u32_t kind);
+    /// Create the field objects and field-insensitive objects the workers may need
+    void prepareSharedPAG(PAG* pag, BVDataPTAImpl* ander);
+    /// Add the points-to set of a query answered by another instance to _pta
+    void mergeQueryPts(PointerAnalysis* worker, NodeID id);
     /// Create pointer analysis according to specified kind and analyze the module.
     void runPointerAnalysis(SVFModule* module, u32_t kind);
     /// Context insensitive Edge for DDA
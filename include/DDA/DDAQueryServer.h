@@ -0,0 +1,76 @@
+/*
+ * DDAQueryServer.h
+ *
+ * Long-running query mode of demand-driven analysis: the PAG, the Andersen
+ * pre-analysis, the SVFG and the solver caches are built once, then points-to
+ * and alias queries are answered one line at a time over stdin or a Unix socket.
+ *
+ * Requests (PAG node IDs, one request per line):
+ *  - pts <id>             points-to set of a top-level pointer
+ *  - alias <id1> <id2>    alias result of two pointers
+ *  - stat                 number of queries answered so far and their time
+ *  - quit                 close the connection (stop serving on stdin)
+ *  - shutdown             stop the server
+ * Each request gets exactly one reply line, "ok ..." or "error <message>".
+ */
+
+#ifndef DDAQUERYSERVER_H_
+#define DDAQUERYSERVER_H_
+
+#include "MemoryModel/PointerAnalysis.h"
+#include <iostream>
+
+namespace SVF
+{
+
+class DDAClient;
+
+/*!
+ * Query server over a demand-driven pointer analysis
+ */
+class DDAQueryServer
+{
+public:
+    /// Constructor, pta must have been initialized
+    DDAQueryServer(PointerAnalysis* p, DDAClient* c) : pta(p), client(c),
+        shutdown(false), numOfQueries(0), numOfCachedQueries(0), queryTime(0) {}
+
+    /// Answer the requests read from in until "quit" or end of input
+    void serve(std::istream& in, std::ostream& out);
+
+    /// Answer the requests of the connections to a Unix socket at path, one connection
+    /// at a time, until a client sends "shutdown". Return false if the socket cannot be set up
+    /// or stops accepting connections
+    bool serveSocket(const std::string& path);
+
+    /// Answer one request, return false if the connection should be closed
+    bool handleRequest(const std::string& request, std::string& reply);
+
+private:
+    /// Make sure the points-to set of id has been computed
+    void computePts(NodeID id);
+
+    /// Points-to set and alias result of pointers computed before
+    //@{
+    PointsTo getQueryPts(NodeID id);
+    AliasResult queryAlias(NodeID id1, NodeID id2);
+    //@}
+
+    /// Parse a PAG node ID
+    bool parseNodeID(std::istream& is, NodeID& id, std::string& reply) const;
+
+    static const u32_t MaxAcceptFailures = 60;	///< consecutive failed accepts before giving up
+
+    PointerAnalysis* pta;	///< demand-driven analysis answering the queries
+    DDAClient* client;		///< client informed of the pointer being queried
+    NodeBS answered;		///< pointers whose points-to sets have been computed
+    bool shutdown;		///< whether a client has asked the server to stop
+
+    u32_t numOfQueries;		///< pts/alias requests answered
+    u32_t numOfCachedQueries;	///< pointers queried again
+    double queryTime;		///< time of computing points-to sets
+};
+
+} // End namespace SVF
+
+#endif /* DDAQUERYSERVER_H_ */
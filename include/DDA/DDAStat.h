@@ -52,6 +52,9 @@ public:
 
     void getNumOfOOBQuery();
 
+    /// Add the numbers of another instance answering queries of the same run
+    void mergeStat(const DDAStat* other);
+
     inline void setMemUsageBefore(u32_t vmrss, u32_t vmsize)
     {
         _vmrssUsageBefore = vmrss;
@@ -36,6 +36,12 @@
 namespace SVF
 {
 
+/// Constraint nodes share the dense IDs of PAG nodes, keep them in a vector
+template<> struct GenericGraphNodeStorage<ConstraintNode>
+{
+    typedef DenseNodeMap<ConstraintNode> IDToNodeMapTy;
+};
+
 /*!
  * Constraint graph for Andersen's analysis
  * ConstraintNodes are same as PAGNodes
@@ -45,7 +51,7 @@ class ConstraintGraph :  public GenericGraph<ConstraintNode,ConstraintEdge>
 {
 
 public:
-    typedef Map<NodeID, ConstraintNode *> ConstraintNodeIDToNodeMapTy;
+    typedef GenericGraph<ConstraintNode,ConstraintEdge>::IDToNodeMapTy ConstraintNodeIDToNodeMapTy;
     typedef ConstraintEdge::ConstraintEdgeSetTy::iterator ConstraintNodeIter;
     typedef Map<NodeID, NodeID> NodeToRepMap;
     typedef Map<NodeID, NodeBS> NodeToSubsMap;
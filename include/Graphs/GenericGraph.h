@@ -319,6 +319,131 @@ public:
     //@}
 };
 
+/*!
+ * NodeID to node map for graphs whose node IDs are dense (numbered from 0).
+ *
+ * Nodes are kept in a vector indexed by ID, so looking up a node is an array
+ * access and iterating over nodes is a linear scan, instead of hashing and
+ * walking the buckets of a Map. Removed nodes leave an empty slot.
+ *
+ * The interface is the subset of Map used by GenericGraph. Iterators yield
+ * (ID, node) pairs in ID order and refer to the map and a position, so they
+ * stay valid when nodes are added or removed during an iteration.
+ */
+template<class NodeTy>
+class DenseNodeMap
+{
+public:
+    typedef std::vector<NodeTy*> NodeVector;
+
+    class iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef std::pair<NodeID, NodeTy*> value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const value_type* pointer;
+        typedef const value_type& reference;
+
+        iterator(): nodes(NULL), pos(0) {}
+        iterator(const NodeVector* n, size_t p): nodes(n), pos(p)
+        {
+            skipEmpty();
+        }
+
+        inline reference operator*() const
+        {
+            return cur;
+        }
+        inline pointer operator->() const
+        {
+            return &cur;
+        }
+        inline iterator& operator++()
+        {
+            ++pos;
+            skipEmpty();
+            return *this;
+        }
+        inline iterator operator++(int)
+        {
+            iterator old = *this;
+            ++*this;
+            return old;
+        }
+        /// Any position at or past the last slot is end(), also after the map grew or shrank
+        inline bool operator==(const iterator& rhs) const
+        {
+            if (atEnd() || rhs.atEnd())
+                return atEnd() && rhs.atEnd();
+            return pos == rhs.pos;
+        }
+        inline bool operator!=(const iterator& rhs) const
+        {
+            return !(*this == rhs);
+        }
+
+    private:
+        friend class DenseNodeMap;
+
+        inline bool atEnd() const
+        {
+            return nodes == NULL || pos >= nodes->size();
+        }
+
+        inline void skipEmpty()
+        {
+            while (pos < nodes->size() && (*nodes)[pos] == NULL)
+                ++pos;
+            if (pos < nodes->size())
+                cur = value_type(pos, (*nodes)[pos]);
+        }
+
+        const NodeVector* nodes;
+        size_t pos;
+        value_type cur;
+    };
+    typedef iterator const_iterator;
+
+    inline iterator begin() const
+    {
+        return iterator(&nodes, 0);
+    }
+    inline iterator end() const
+    {
+        return iterator(&nodes, nodes.size());
+    }
+    inline iterator find(NodeID id) const
+    {
+        if (id < nodes.size() && nodes[id] != NULL)
+            return iterator(&nodes, id);
+        return end();
+    }
+    inline NodeTy*& operator[](NodeID id)
+    {
+        if (id >= nodes.size())
+            nodes.resize(id + 1, NULL);
+        return nodes[id];
+    }
+    inline void erase(iterator it)
+    {
+        nodes[it.pos] = NULL;
+    }
+
+private:
+    NodeVector nodes;
+};
+
+/*!
+ * Node storage of GenericGraph, a Map by default.
+ * Graphs with dense node IDs select DenseNodeMap by specialising it for their node type.
+ */
+template<class NodeTy>
+struct GenericGraphNodeStorage
+{
+    typedef Map<NodeID, NodeTy*> IDToNodeMapTy;
+};
+
 /*
  * Generic graph for program representation
  * It is base class and needs to be instantiated
@@ -331,7 +456,7 @@ public:
     typedef NodeTy NodeType;
     typedef EdgeTy EdgeType;
     /// NodeID to GenericNode map
-    typedef Map<NodeID, NodeType*> IDToNodeMapTy;
+    typedef typename GenericGraphNodeStorage<NodeTy>::IDToNodeMapTy IDToNodeMapTy;
 
     /// Node Iterators
     //@{
@@ -0,0 +1,143 @@
+//===- GraphStreamer.h -- Streaming export of SVF graphs ---------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * GraphStreamer.h
+ *
+ * Export of ICFG, PAG, constraint graph and SVFG with memory independent of the
+ * graph size. Unlike the dot writers and ICFGPrinter::printICFGToJson, which
+ * build a whole document before writing it, every node and edge is written as
+ * soon as it is visited, in one of two formats:
+ *
+ *  - NDJSON: one JSON object per line,
+ *      {"t":"n","id":1,"kind":0,"fun":"main"}       a node (fun omitted for globals)
+ *      {"t":"e","src":1,"dst":2,"kind":0}           an edge
+ *  - EdgeList: a binary header (magic "SVFE", version) followed by one record
+ *    of three u32_t words (src, dst, kind) per edge, in host byte order.
+ *
+ * With a function filter only the nodes of those functions are written, together
+ * with all their outgoing edges (so calls and returns leaving the slice are kept).
+ *
+ * -stream-graphs=icfg,pag,consg,svfg writes the named graphs next to their dot
+ * dumps, -stream-graph-format and -stream-graph-funs select format and filter.
+ */
+
+#ifndef GRAPHSTREAMER_H_
+#define GRAPHSTREAMER_H_
+
+#include "Graphs/ICFG.h"
+#include "Graphs/PAG.h"
+#include "Graphs/ConsG.h"
+#include "Graphs/SVFG.h"
+#include <fstream>
+
+namespace SVF
+{
+
+/*!
+ * Write the nodes and edges of a graph one by one
+ */
+class GraphStreamer
+{
+public:
+    enum Format
+    {
+        NDJSON, EdgeList
+    };
+
+    typedef Set<std::string> FunctionNameSet;
+
+    /// Constructor, opens filename for writing. An empty function filter writes whole graphs
+    GraphStreamer(const std::string& filename, Format format, const FunctionNameSet& funs = FunctionNameSet());
+
+    /// Destructor, flushes and closes the file
+    ~GraphStreamer();
+
+    /// Whether the file could be opened
+    inline bool good() const
+    {
+        return out.good();
+    }
+
+    /// Write a graph
+    //@{
+    void write(ICFG* icfg);
+    void write(PAG* pag);
+    void write(ConstraintGraph* consCG);
+    void write(SVFG* svfg);
+    //@}
+
+    /// Number of nodes and edges written so far
+    //@{
+    inline u32_t getNumOfNodes() const
+    {
+        return numOfNodes;
+    }
+    inline u32_t getNumOfEdges() const
+    {
+        return numOfEdges;
+    }
+    //@}
+
+    /// Write a graph to name plus the extension of the format if -stream-graphs names it
+    /// (graphName is one of icfg, pag, consg, svfg)
+    template<class GraphType>
+    static void stream(GraphType* graph, const std::string& graphName, const std::string& name)
+    {
+        if (!isEnabled(graphName))
+            return;
+        GraphStreamer streamer(name + getExtension(getDefaultFormat()), getDefaultFormat(), getDefaultFunctions());
+        if (streamer.good())
+            streamer.write(graph);
+    }
+
+    /// Command line settings
+    //@{
+    static bool isEnabled(const std::string& graphName);
+    static Format getDefaultFormat();
+    static FunctionNameSet getDefaultFunctions();
+    static std::string getExtension(Format format);
+    //@}
+
+private:
+    /// Write all kept nodes of a graph, getFunName returns the function name of a node
+    /// or an empty string for global nodes
+    template<class GraphType, class FunNameFn>
+    void writeGraph(GraphType* graph, FunNameFn getFunName);
+
+    /// Records
+    //@{
+    void writeNode(NodeID id, u32_t kind, const std::string& fun);
+    void writeEdge(NodeID src, NodeID dst, u32_t kind);
+    void writeJsonString(const std::string& str);
+    //@}
+
+    std::ofstream out;
+    Format format;
+    FunctionNameSet funs;
+    u32_t numOfNodes;
+    u32_t numOfEdges;
+};
+
+} // End namespace SVF
+
+#endif /* GRAPHSTREAMER_H_ */
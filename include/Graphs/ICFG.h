@@ -39,6 +39,12 @@ namespace SVF
 
 class PTACallGraph;
 
+/// ICFG nodes are numbered from 0, keep them in a vector
+template<> struct GenericGraphNodeStorage<ICFGNode>
+{
+    typedef DenseNodeMap<ICFGNode> IDToNodeMapTy;
+};
+
 /*!
  * Interprocedural Control-Flow Graph (ICFG)
  */
@@ -48,7 +54,7 @@ class ICFG : public GenericICFGTy
 
 public:
 
-    typedef Map<NodeID, ICFGNode *> ICFGNodeIDToNodeMapTy;
+    typedef GenericICFGTy::IDToNodeMapTy ICFGNodeIDToNodeMapTy;
     typedef ICFGEdge::ICFGEdgeSetTy ICFGEdgeSetTy;
     typedef ICFGNodeIDToNodeMapTy::iterator iterator;
     typedef ICFGNodeIDToNodeMapTy::const_iterator const_iterator;
@@ -175,6 +181,26 @@ public:
     }
     //@}
 
+    /// Get the ICFGNode of an instruction without adding one, NULL if it has none
+    /// (safe to call from threads sharing the ICFG)
+    //@{
+    inline ICFGNode* findBlockICFGNode(const Instruction* inst) const
+    {
+        if (SVFUtil::isNonInstricCallSite(inst))
+        {
+            CSToCallNodeMapTy::const_iterator it = CSToCallNodeMap.find(inst);
+            return it == CSToCallNodeMap.end() ? NULL : it->second;
+        }
+        InstToBlockNodeMapTy::const_iterator it = InstToBlockNodeMap.find(inst);
+        return it == InstToBlockNodeMap.end() ? NULL : it->second;
+    }
+    inline CallBlockNode* findCallBlockNode(const Instruction* inst) const
+    {
+        CSToCallNodeMapTy::const_iterator it = CSToCallNodeMap.find(inst);
+        return it == CSToCallNodeMap.end() ? NULL : it->second;
+    }
+    //@}
+
 private:
     /// Get/Add IntraBlock ICFGNode
     inline IntraBlockNode* getIntraBlockICFGNode(const Instruction* inst)
@@ -45,6 +45,7 @@ namespace SVF
  */
 class PAG : public GenericGraph<PAGNode,PAGEdge>
 {
+    friend class PAGSnapshot;
 
 public:
     typedef Set<const CallBlockNode*> CallSiteSet;
@@ -158,6 +159,17 @@ public:
             delete pag;
         pag = NULL;
     }
+    /// Discard a partly built PAG but not the symbol table it is built from, return a new empty PAG
+    static PAG* resetPAG()
+    {
+        if (pag)
+        {
+            pag->symInfo = NULL;
+            delete pag;
+            pag = NULL;
+        }
+        return getPAG();
+    }
     //@}
 
     /// Destructor
@@ -175,6 +187,9 @@ public:
     //@{
     /// Whether to handle blackhole edge
     static void handleBlackHole(bool b);
+    static bool isHandlingBlackHole();
+    /// Whether the first field of an object is the object itself (-ff-eq-base)
+    static bool isFirstFieldEqBase();
     //@}
     /// Get LLVM Module
     inline SVFModule* getModule()
@@ -220,6 +235,13 @@ public:
     {
         return inst2PTAPAGEdgesMap[inst];
     }
+    /// Find the (PTA) PAGEdges of an instruction without inserting, NULL if it has none
+    inline const PAGEdgeList* findInstPAGEdgeList(const ICFGNode* inst, bool ptaOnly) const
+    {
+        const Inst2PAGEdgesMap& edgesMap = ptaOnly ? inst2PTAPAGEdgesMap : inst2PAGEdgesMap;
+        Inst2PAGEdgesMap::const_iterator it = edgesMap.find(inst);
+        return it == edgesMap.end() ? NULL : &it->second;
+    }
     /// Add a PAGEdge into instruction map
     inline void addToInstPAGEdgeList(ICFGNode* inst, PAGEdge* edge)
     {
@@ -414,6 +414,12 @@ public:
         return ls.getOffset();
     }
 
+    /// location set of the base value node
+    inline const LocationSet& getLocationSet() const
+    {
+        return ls;
+    }
+
     /// Return name of a LLVM value
     inline const std::string getValueName() const
     {
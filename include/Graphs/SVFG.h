@@ -104,6 +104,7 @@ protected:
     SVFGStat * stat;
     MemSSA* mssa;
     PointerAnalysis* pta;
+    u32_t numOfThreads;	///< number of threads collecting intra-procedural indirect edges
 
     /// Clean up memory
     void destroy();
@@ -127,6 +128,13 @@ public:
         return stat;
     }
 
+    /// Set the number of threads used by buildSVFG (0: all hardware threads).
+    /// The SVFG built is the same whatever the number is.
+    inline void setNumOfThreads(u32_t num)
+    {
+        numOfThreads = num;
+    }
+
     /// Clear MSSA
     inline void clearMSSA()
     {
@@ -377,6 +385,13 @@ protected:
     /// Connect indirect SVFG edges from global initializers (store) to main function entry
     void connectFromGlobalToProgEntry();
 
+    /// Intra-procedural indirect value-flows into a node, each given by its def node and points-to set
+    typedef std::vector<std::pair<NodeID, const PointsTo*> > IntraIndirectUses;
+    /// Collect the intra-procedural indirect value-flows into node (read only, may run in parallel)
+    void collectIntraIndirectUses(const SVFGNode* node, IntraIndirectUses& uses) const;
+    /// Connect the inter-procedural indirect edges of a formal-in/out node to its call sites
+    void connectInterIndirectSVFGEdges(const SVFGNode* node);
+
     /// Add SVFG node
     virtual inline void addSVFGNode(SVFGNode* node, ICFGNode* icfgNode)
     {
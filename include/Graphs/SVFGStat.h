@@ -54,6 +54,7 @@ public:
     static const char* TimeOfCreateMUCHI;	///< Time for generating mu/chi for load/store/calls
     static const char* TimeOfInsertingPHI;	///< Time for inserting phis
     static const char* TimeOfSSARenaming;	///< Time for SSA rename
+    static const char* TimeOfParallelBuild;	///< Time for building memory SSA on multiple threads
 
     static const char* NumOfMaxRegion;	///< Number of max points-to set in region.
     static const char* NumOfAveragePtsInRegion;	///< Number of average points-to set in region.
@@ -41,6 +41,12 @@ class PointerAnalysis;
 class VFGStat;
 class CallBlockNode;
 
+/// VFG and SVFG nodes are numbered from 0, keep them in a vector
+template<> struct GenericGraphNodeStorage<VFGNode>
+{
+    typedef DenseNodeMap<VFGNode> IDToNodeMapTy;
+};
+
 /*!
  * Interprocedural Control-Flow Graph (VFG)
  */
@@ -55,7 +61,7 @@ public:
         ORIGSVFGK, PTRONLYSVFGK
     };
 
-    typedef Map<NodeID, VFGNode *> VFGNodeIDToNodeMapTy;
+    typedef GenericVFGTy::IDToNodeMapTy VFGNodeIDToNodeMapTy;
     typedef Set<VFGNode*> VFGNodeSet;
     typedef Map<const PAGNode*, NodeID> PAGNodeToDefMapTy;
     typedef Map<std::pair<NodeID,const CallBlockNode*>, ActualParmVFGNode *> PAGNodeToActualParmMapTy;
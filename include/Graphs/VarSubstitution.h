@@ -0,0 +1,130 @@
+//===- VarSubstitution.h -- Offline variable substitution of a constraint graph //
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * VarSubstitution.h
+ *
+ * Hash-based value numbering (HVN) of a constraint graph before solving, see
+ * "Exploiting Pointer and Location Equivalence to Optimize Pointer Analysis"
+ * (Hardekopf and Lin, SAS'07).
+ *
+ * Every pointer gets a set of labels describing where its points-to set comes
+ * from, in topological order of the SCCs over copy and gep edges:
+ *  - addr edge from o:          the label o
+ *  - copy edge from p:          the labels of p
+ *  - gep edge from p:           a label per (value number of p, field offset)
+ *  - load edge from p:          a label per value number of p
+ *  - indirect node:             a fresh label
+ * Nodes with equal label sets are pointer equivalent and have the same value
+ * number; the empty set (value number 0) means a node never points to anything.
+ *
+ * Indirect nodes are those whose incoming constraints are not all in the graph
+ * before solving: objects (stored into), formal parameters of address-taken
+ * functions and return values of indirect callsites (connected on the fly).
+ * Nodes in a cycle with a gep edge (positive weight cycles) get fresh labels too.
+ */
+
+#ifndef VARSUBSTITUTION_H_
+#define VARSUBSTITUTION_H_
+
+#include "Graphs/ConsG.h"
+#include "Util/SCC.h"
+
+namespace SVF
+{
+
+/*!
+ * Pointer equivalence of constraint nodes
+ */
+class VarSubstitution
+{
+public:
+    typedef SCCDetection<ConstraintGraph*> CGSCC;
+    typedef std::vector<std::pair<NodeID, NodeID> > NodeRepPairs;
+
+    /// Constructor
+    VarSubstitution(ConstraintGraph* g, PAG* p) : consCG(g), pag(p), nextLabel(0)
+    {
+    }
+
+    /// Compute value numbers and the nodes to be merged
+    void solve();
+
+    /// Pairs of (node, rep), each node is pointer equivalent to its rep.
+    /// A rep is the smallest node of its value number and never merged itself.
+    inline const NodeRepPairs& getMerges() const
+    {
+        return merges;
+    }
+
+    /// Number of distinct value numbers, including the empty one
+    inline u32_t getNumOfValueNumbers() const
+    {
+        return vnLabels.size();
+    }
+
+private:
+    /// Nodes whose points-to sets may grow by constraints added while solving
+    void collectIndirectNodes();
+
+    /// Label set of the SCC of rep, or fresh labels for the nodes of a gep cycle
+    void numberSCC(CGSCC& scc, NodeID rep);
+
+    /// Labels
+    //@{
+    inline NodeID newLabel()
+    {
+        return nextLabel++;
+    }
+    NodeID getLabel(Map<NodePair, NodeID>& labels, NodeID first, NodeID second);
+    //@}
+
+    /// Value number of a label set
+    u32_t getValueNumber(const NodeBS& labels);
+
+    inline bool isNumbered(NodeID id) const
+    {
+        return id < nodeToVN.size() && nodeToVN[id] != Unnumbered;
+    }
+
+    static const u32_t Unnumbered = ~0U;
+    static const u32_t VariantOffset = ~0U;	///< offset key of variant geps
+
+    ConstraintGraph* consCG;
+    PAG* pag;
+    NodeBS indirectNodes;
+    NodeID nextLabel;	///< labels above all node IDs, the IDs of objects are their addr labels
+
+    std::vector<u32_t> nodeToVN;	///< value number of every node, indexed by node ID
+    std::vector<NodeBS> vnLabels;	///< label set of every value number
+    std::map<std::vector<NodeID>, u32_t> labelsToVN;
+
+    Map<NodePair, NodeID> gepLabels;	///< (value number, offset) of a gep to its label
+    Map<NodePair, NodeID> loadLabels;	///< (value number, 0) of a load pointer to its label
+    Map<NodePair, NodeID> pendingLoadLabels;	///< (SCC rep, 0) of a load pointer numbered later to its label
+
+    NodeRepPairs merges;
+};
+
+} // End namespace SVF
+
+#endif /* VARSUBSTITUTION_H_ */
@@ -54,11 +54,25 @@ private:
     MSSADef* def;
 public:
     /// Constructor
-    MRVer(const MemRegion* m, MRVERSION v, MSSADef* d) :
-        mr(m), version(v), vid(totalVERNum++),def(d)
+    /// A version created while functions are built concurrently defers its ID (deferID),
+    /// which is given later by assignID() in a fixed order
+    MRVer(const MemRegion* m, MRVERSION v, MSSADef* d, bool deferID = false) :
+        mr(m), version(v), vid(deferID ? 0 : totalVERNum++),def(d)
     {
     }
 
+    /// Give a version created with a deferred ID the next ID
+    inline void assignID()
+    {
+        vid = totalVERNum++;
+    }
+
+    /// Return the ID
+    inline MRVERID getID() const
+    {
+        return vid;
+    }
+
     /// Return the memory region
     inline const MemRegion* getMR() const
     {
@@ -49,7 +49,7 @@ class MemRegion
 {
 
 public:
-    typedef DdNode* Condition;
+    typedef CondExpr* Condition;
 private:
     /// region ID 0 is reserved
     static Size_t totalMRNum;
@@ -347,13 +347,13 @@ protected:
     {
         storesToPointsToMap[st] = cpts;
         funToPointsToMap[fun].insert(cpts);
-        addModSideEffectOfFunction(fun,cpts);
+        addModSideEffectOfFunction(fun,cpts.toNodeBS());
     }
     inline void addCPtsToLoad(PointsTo& cpts, const LoadPE *ld, const SVFFunction* fun)
     {
         loadsToPointsToMap[ld] = cpts;
         funToPointsToMap[fun].insert(cpts);
-        addRefSideEffectOfFunction(fun,cpts);
+        addRefSideEffectOfFunction(fun,cpts.toNodeBS());
     }
     inline void addCPtsToCallSiteRefs(PointsTo& cpts, const CallBlockNode* cs)
     {
@@ -449,6 +449,14 @@ public:
     {
         return funToMRsMap[fun];
     }
+    inline bool hasLoadMRSet(const LoadPE* load) const
+    {
+        return loadsToMRsMap.find(load)!=loadsToMRsMap.end();
+    }
+    inline bool hasStoreMRSet(const StorePE* store) const
+    {
+        return storesToMRsMap.find(store)!=storesToMRsMap.end();
+    }
     inline MRSet& getLoadMRSet(const LoadPE* load)
     {
         return loadsToMRsMap[load];
@@ -474,6 +482,38 @@ public:
         return callsiteToModMRsMap[cs];
     }
     //@}
+    /// Look-ups which never insert into the maps, for memory SSA built in parallel;
+    /// NULL if there is no entry
+    //@{
+    inline const MRSet* findLoadMRSet(const LoadPE* load) const
+    {
+        LoadsToMRsMap::const_iterator it = loadsToMRsMap.find(load);
+        return it == loadsToMRsMap.end() ? NULL : &it->second;
+    }
+    inline const MRSet* findStoreMRSet(const StorePE* store) const
+    {
+        StoresToMRsMap::const_iterator it = storesToMRsMap.find(store);
+        return it == storesToMRsMap.end() ? NULL : &it->second;
+    }
+    inline const MRSet* findCallSiteRefMRSet(const CallBlockNode* cs) const
+    {
+        CallSiteToMRsMap::const_iterator it = callsiteToRefMRsMap.find(cs);
+        return it == callsiteToRefMRsMap.end() ? NULL : &it->second;
+    }
+    inline const MRSet* findCallSiteModMRSet(const CallBlockNode* cs) const
+    {
+        CallSiteToMRsMap::const_iterator it = callsiteToModMRsMap.find(cs);
+        return it == callsiteToModMRsMap.end() ? NULL : &it->second;
+    }
+    /// Instructions in unreachable blocks and intrinsics have no ICFGNode, hence no PAGEdges
+    inline const PAGEdgeList* findPAGEdgesFromInst(const Instruction* inst) const
+    {
+        PAG* pag = pta->getPAG();
+        const ICFGNode* node = pag->getICFG()->findBlockICFGNode(inst);
+        return node ? pag->findInstPAGEdgeList(node, ptrOnlyMSSA) : NULL;
+    }
+    //@}
+
     /// Whether this instruction has PAG Edge
     inline bool hasPAGEdgeList(const Instruction* inst)
     {
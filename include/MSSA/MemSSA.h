@@ -102,6 +102,7 @@ public:
     static double timeOfCreateMUCHI;	///< Time for generating mu/chi for load/store/calls
     static double timeOfInsertingPHI;	///< Time for inserting phis
     static double timeOfSSARenaming;	///< Time for SSA rename
+    static double timeOfParallelBuild;	///< Time for building the functions on multiple threads (all three phases)
     //@}
 
 protected:
@@ -132,6 +133,9 @@ private:
     MemRegToVerStackMap mr2VerStackMap;
     MemRegToCounterMap mr2CounterMap;
 
+    /// Versions created for the current function, whose IDs are deferred (worker only)
+    std::vector<MRVer*>* deferredVers;
+
     /// The following three set are used for prune SSA phi insertion
     // (see algorithm in book Engineering A Compiler section 9.3)
     ///@{
@@ -146,6 +150,12 @@ private:
     /// Release the memory
     void destroy();
 
+    /// Worker building functions on behalf of master, sharing its analysis and memory regions
+    MemSSA(MemSSA* master);
+
+    /// Move the mus/chis/phis built by worker into this MemSSA
+    void mergeFrom(MemSSA* worker);
+
     /// Get a new SSA name of a memory region
     MRVer* newSSAName(const MemRegion* mr, MSSADEF* def);
 
@@ -320,6 +330,10 @@ public:
     /// We start from here
     virtual void buildMemSSA(const SVFFunction& fun,DominanceFrontier*, DominatorTree*);
 
+    /// Build memory SSA for funs using numOfThreads threads.
+    /// The result, including the IDs of the versions, is the same as building them one by one in order.
+    void buildMemSSA(const std::vector<const SVFFunction*>& funs, u32_t numOfThreads);
+
     /// Perform statistics
     void performStat();
 
@@ -37,6 +37,7 @@ public:
 
     typedef std::pair<const StmtSVFGNode*, LockAnalysis::LockSpan> SVFGNodeLockSpanPair;
     typedef Map<SVFGNodeLockSpanPair, bool> PairToBoolMap;
+    typedef Map<NodeID, SVFGNodeIDSet> ObjToSVFGNodesMap;
     /// Constructor
     MTASVFGBuilder(MHP* m, LockAnalysis* la) : SVFGBuilder(), mhp(m), lockana(la)
     {
@@ -50,6 +51,13 @@ public:
     static u32_t numOfRemovedSVFGEdges;
     static u32_t numOfRemovedPTS;
 
+    /// Pairs of loads/stores checked when connecting MHP edges, out of all pairs (64-bit, as
+    /// all pairs grow quadratically with the loads/stores)
+    static u64_t numOfCheckedPairs;
+    static u64_t numOfAllPairs;
+    /// Time of connecting MHP edges
+    static double connectMHPEdgesTime;
+
 protected:
     /// Re-write create SVFG method
     virtual void buildSVFG();
@@ -91,10 +99,26 @@ private:
     /// Collect all loads/stores SVFGNodes
     void collectLoadStoreSVFGNodes();
 
+    /// Index loads/stores by the objects they may access
+    //@{
+    void indexLoadStoreSVFGNodes(BVDataPTAImpl* pta);
+    void getAliasCandidates(const StmtSVFGNode* n, BVDataPTAImpl* pta, SVFGNodeIDSet& loads, SVFGNodeIDSet& stores);
+    //@}
+
     /// all stores/loads SVFGNodes
     SVFGNodeSet stnodeSet;
     SVFGNodeSet ldnodeSet;
 
+    /// loads/stores accessing an object, and those which may access any object (black hole)
+    //@{
+    ObjToSVFGNodesMap objToLoads;
+    ObjToSVFGNodesMap objToStores;
+    SVFGNodeIDSet anyObjLoads;
+    SVFGNodeIDSet anyObjStores;
+    SVFGNodeIDSet allLoads;
+    SVFGNodeIDSet allStores;
+    //@}
+
     /// MHP class
     MHP* mhp;
     LockAnalysis* lockana;
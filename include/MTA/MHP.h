@@ -11,6 +11,7 @@
 #include "MTA/TCT.h"
 #include <set>
 #include <vector>
+#include <mutex>
 
 namespace SVF
 {
@@ -52,6 +53,9 @@ public:
     /// Analyze thread interleaving
     void analyzeInterleaving();
 
+    /// Analyze thread interleaving, the TCT nodes being distributed over numOfThreads workers
+    void analyzeInterleavingInParallel(u32_t numOfThreads);
+
     /// Get ThreadCallGraph
     inline ThreadCallGraph* getThreadCallGraph() const
     {
@@ -114,6 +118,21 @@ public:
     void printInterleaving();
 
 private:
+    /// Worker of the parallel interleaving analysis, sharing the fork-join analysis of its master
+    MHP(TCT* t, ForkJoinAnalysis* f, std::mutex* m);
+
+    /// Propagate the interleaving of a TCT node to the statements it may reach
+    void analyzeRootThread(NodeID rootTid);
+
+    /// Process the worklist until it is empty
+    void solveCTSWorkList(NodeID rootTid);
+
+    /// Merge the interleavings computed by a worker
+    void mergeInterleaving(const MHP& worker);
+
+    /// Propagate once more from every statement, return the number of interleavings updated
+    u32_t recheckInterleaving();
+
     /// Update non-candidate functions' interleaving.
     /// Copy interleaving threads of the entry inst to other insts.
     void updateNonCandidateFunInterleaving();
@@ -145,6 +164,7 @@ private:
     {
         if(threadStmtToTheadInterLeav[tgr].test_and_set(tid))
         {
+            numOfInterleavingUpdates++;
             instToTSMap[tgr.getStmt()].insert(tgr);
             pushToCTSWorkList(tgr);
         }
@@ -154,6 +174,7 @@ private:
         bool changed = threadStmtToTheadInterLeav[tgr] |= threadStmtToTheadInterLeav[src];
         if(changed)
         {
+            numOfInterleavingUpdates++;
             instToTSMap[tgr.getStmt()].insert(tgr);
             pushToCTSWorkList(tgr);
         }
@@ -168,6 +189,7 @@ private:
         }
         if(threadStmtToTheadInterLeav[tgr].intersectWithComplement(joinedTids))
         {
+            numOfInterleavingUpdates++;
             pushToCTSWorkList(tgr);
         }
     }
@@ -199,7 +221,14 @@ private:
     /// Push calling context
     inline void pushCxt(CallStrCxt& cxt, const Instruction* call, const Function* callee)
     {
-        tct->pushCxt(cxt,call,callee);
+        /// TCT records the longest context
+        if(sharedMutex)
+        {
+            std::lock_guard<std::mutex> lock(*sharedMutex);
+            tct->pushCxt(cxt,call,callee);
+        }
+        else
+            tct->pushCxt(cxt,call,callee);
     }
     /// Match context
     inline bool matchCxt(CallStrCxt& cxt, const Instruction* call, const Function* callee)
@@ -246,12 +275,19 @@ private:
     ThreadStmtToThreadInterleav threadStmtToTheadInterLeav; /// Map a statement to its thread interleavings
     InstToThreadStmtSetMap instToTSMap; ///< Map an instruction to its ThreadStmtSet
     FuncPairToBool nonCandidateFuncMHPRelMap;
+    std::mutex* sharedMutex;			///< guards the caches of fja and tct filled by parallel workers, NULL unless a worker
 
 
 public:
-    u32_t numOfTotalQueries;		///< Total number of queries
-    u32_t numOfMHPQueries;			///< Number of queries are answered as may-happen-in-parallel
+    u64_t numOfTotalQueries;		///< Total number of queries
+    u64_t numOfMHPQueries;			///< Number of queries are answered as may-happen-in-parallel
+    u32_t numOfInterleavingUpdates;	///< Number of times an interleaving set changed
+    u32_t numOfInterleavingThreads;	///< Number of threads of the interleaving analysis
+    u32_t numOfRecheckUpdates;		///< Number of interleavings updated by the fixpoint re-check
+    double forkJoinTime;
     double interleavingTime;
+    double interleavingMergeTime;
+    double interleavingRecheckTime;
     double interleavingQueriesTime;
 };
 
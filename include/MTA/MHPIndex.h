@@ -0,0 +1,137 @@
+/*
+ * MHPIndex.h
+ *
+ * Index over the results of MHP and lock analysis answering pair queries in
+ * constant time.
+ *
+ * Instructions are grouped into MHP classes: instructions whose thread
+ * statements pair the same threads with the same interleaving threads may
+ * happen in parallel with exactly the same instructions. Likewise, instructions
+ * with the same intra-procedural and context-sensitive lock sets form a lock
+ * class (lock span ID). A pair query looks up the two classes and the relation
+ * between them, computed once per pair of classes.
+ */
+
+#ifndef MHPINDEX_H_
+#define MHPINDEX_H_
+
+#include "MTA/MHP.h"
+#include <functional>
+
+namespace SVF
+{
+
+class LockAnalysis;
+
+/*!
+ * Precomputed may-happen-in-parallel index
+ */
+class MHPIndex
+{
+public:
+    typedef std::function<bool(const Instruction*, const Instruction*)> RacingPairVisitor;
+
+    /// Constructor, mhp must have analyzed interleavings and lsa (optional) lock spans
+    MHPIndex(MHP* m, LockAnalysis* l = NULL);
+
+    /// Whether two instructions may happen in parallel (MHP::mayHappenInParallelInst)
+    inline bool mayHappenInParallel(const Instruction* i1, const Instruction* i2)
+    {
+        numOfQueries++;
+        u32_t c1 = getMHPClass(i1);
+        u32_t c2 = getMHPClass(i2);
+        if(c1 == NoClass || c2 == NoClass)
+            return false;
+        return mhpRelation(c1, c2);
+    }
+
+    /// Whether two instructions are protected by a common lock (LockAnalysis::isProtectedByCommonLock)
+    bool isProtectedByCommonLock(const Instruction* i1, const Instruction* i2);
+
+    /// Whether two instructions may happen in parallel without a common lock
+    inline bool mayRace(const Instruction* i1, const Instruction* i2)
+    {
+        return mayHappenInParallel(i1, i2) && !isProtectedByCommonLock(i1, i2);
+    }
+
+    /// Stream the racing pairs of accesses to a memory object, at least one of them being
+    /// a store, until visit returns false. Return the number of pairs visited
+    u32_t forEachRacingPair(NodeID obj, RacingPairVisitor visit);
+
+    /// Number of MHP pairs between two sets of instructions, without enumerating the pairs
+    u64_t countMHPPairs(const MHP::InstSet& set1, const MHP::InstSet& set2);
+
+    /// Statistics
+    //@{
+    inline u32_t getNumOfMHPClasses() const
+    {
+        return mhpClasses.size();
+    }
+    inline u32_t getNumOfLockClasses() const
+    {
+        return lockReps.size();
+    }
+    u32_t numOfQueries;	///< pair queries answered
+    double buildTime;	///< time of building the index
+    //@}
+
+private:
+    struct KeyHash
+    {
+        size_t operator()(const std::vector<u64_t>& key) const;
+    };
+    typedef Map<std::vector<u64_t>, u32_t, KeyHash> ClassMap;
+    typedef Map<u64_t, bool> PairToBoolMap;
+
+    /// An instruction reading or writing a memory object
+    struct Access
+    {
+        const Instruction* inst;
+        bool isWrite;
+    };
+    typedef std::vector<Access> AccessVec;
+
+    static const u32_t NoClass = ~0u;
+
+    /// Build the MHP classes
+    void buildMHPClasses();
+    /// Lock class of an instruction, computed on demand
+    u32_t getLockClass(const Instruction* inst);
+    /// Collect the loads and stores of every object
+    void buildAccesses();
+
+    inline u32_t getMHPClass(const Instruction* inst) const
+    {
+        Map<const Instruction*, u32_t>::const_iterator it = instToMHPClass.find(inst);
+        return it == instToMHPClass.end() ? NoClass : it->second;
+    }
+
+    /// Relations between classes, cached in a dense matrix when there are few classes
+    //@{
+    bool mhpRelation(u32_t c1, u32_t c2);
+    bool lockRelation(u32_t c1, u32_t c2);
+    //@}
+
+    MHP* mhp;
+    LockAnalysis* lsa;
+
+    Map<const Instruction*, u32_t> instToMHPClass;
+    std::vector<std::vector<u64_t> > mhpClasses;	///< sorted (tid, interleaving tid) pairs of a class
+    std::vector<std::vector<u64_t> > mhpClassesT;	///< the same pairs transposed
+    std::vector<unsigned char> mhpDense;	///< 0: unknown, 1: no MHP, 2: MHP
+    PairToBoolMap mhpSparse;
+
+    Map<const Instruction*, u32_t> instToLockClass;
+    Map<CxtStmt, u32_t> cxtLockIds;	///< ID of a context-sensitive lock
+    ClassMap lockSetIds;	///< ID of a set of context-sensitive locks
+    ClassMap lockClassIds;
+    std::vector<std::pair<const Instruction*, const Instruction*> > lockReps;	///< two members of a lock class
+    PairToBoolMap lockCache;
+
+    Map<NodeID, AccessVec> objToAccesses;
+    bool accessesBuilt;
+};
+
+} // End namespace SVF
+
+#endif /* MHPINDEX_H_ */
@@ -28,7 +28,7 @@ public:
     typedef Set<const Instruction*> InstSet;
 
     /// Constructor
-    MTAStat():PTAStat(NULL),TCTTime(0),MHPTime(0),FSMPTATime(0),AnnotationTime(0)
+    MTAStat():PTAStat(NULL),TCTTime(0),MHPTime(0),LockTime(0),FSMPTATime(0),AnnotationTime(0)
     {
     }
     /// Statistics for thread call graph
@@ -37,11 +37,14 @@ public:
     void performTCTStat(TCT* tct);
     /// Statistics for MHP statement pairs
     void performMHPPairStat(MHP* mhp, LockAnalysis* lsa);
+    /// Time of each phase (TCT, fork-join, interleaving and lock analysis)
+    void performPhaseTimeStat(MHP* mhp);
     /// Statistics for annotation
     void performAnnotationStat(MTAAnnotator* anno);
 
     double TCTTime;
     double MHPTime;
+    double LockTime;
     double FSMPTATime;
     double AnnotationTime;
 };
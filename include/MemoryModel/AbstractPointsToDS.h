@@ -9,12 +9,15 @@
 ///       |                 ^                      |
 ///       |                 |                      |
 /// MutablePTData      [DiffPTData]            [DFPTData]
-///                         ^                      ^
+/// PersistentPTData        ^                      ^
 ///                         |                      |
-///                 MutableDiffPTData        MutableDFPTData
-///                                                ^
-///                                                |
-///                                        IncMutableDFPTData
+///                 MutableDiffPTData        MutableDFPTData    PersistentDFPTData
+///                 PersistentDiffPTData           ^                    ^
+///                                                |                    |
+///                                        IncMutableDFPTData   PersistentIncDFPTData
+///
+/// Mutable* structures give every key its own points-to set (MutablePointsToDS.h);
+/// Persistent* structures share hash-consed sets between keys (PersistentPointsToDS.h).
 
 #ifndef ABSTRACT_POINTSTO_H_
 #define ABSTRACT_POINTSTO_H_
@@ -49,6 +52,10 @@ public:
         DataFlow,
         MutDataFlow,
         IncMutDataFlow,
+        PersBase,
+        PersDiff,
+        PersDataFlow,
+        PersIncDataFlow,
     };
 
     PTData(PTDataTy ty = PTDataTy::Base) : ptdTy(ty) { }
@@ -126,7 +133,8 @@ public:
     }
     static inline bool classof(const PTData<Key, Datum, Data>* ptd)
     {
-        return ptd->getPTDTY() == PTDataTy::Diff || ptd->getPTDTY() == PTDataTy::MutDiff;
+        return ptd->getPTDTY() == PTDataTy::Diff || ptd->getPTDTY() == PTDataTy::MutDiff
+               || ptd->getPTDTY() == PTDataTy::PersDiff;
     }
     ///@}
 };
@@ -200,7 +208,9 @@ public:
     {
         return ptd->getPTDTY() == BasePTData::DataFlow
                || ptd->getPTDTY() == BasePTData::MutDataFlow
-               || ptd->getPTDTY() == BasePTData::IncMutDataFlow;
+               || ptd->getPTDTY() == BasePTData::IncMutDataFlow
+               || ptd->getPTDTY() == BasePTData::PersDataFlow
+               || ptd->getPTDTY() == BasePTData::PersIncDataFlow;
     }
     ///@}
 };
@@ -0,0 +1,110 @@
+//===- FrozenPTA.h -- Immutable snapshot of pointer analysis results ---------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * FrozenPTA.h
+ *
+ * The query functions of PointerAnalysis are not thread safe: getPts inserts
+ * empty sets into the points-to map on a miss and alias expands field-insensitive
+ * objects through PAG maps which also insert on a miss.
+ *
+ * FrozenPTA copies the results of a finished analysis once, with every set the
+ * queries can touch computed up front. Afterwards all its member functions are
+ * const and only read, so any number of threads can query one snapshot without
+ * locking, as long as neither the analysis nor the PAG is modified.
+ */
+
+#ifndef FROZENPTA_H_
+#define FROZENPTA_H_
+
+#include "MemoryModel/PointerAnalysis.h"
+#include "MemoryModel/PersistentPointsToCache.h"
+
+namespace SVF
+{
+
+/*!
+ * Read-only, thread-safe snapshot of points-to and call graph results
+ */
+class FrozenPTA
+{
+public:
+    typedef PTACallGraph::FunctionSet FunctionSet;
+
+    /// Take the snapshot, pta must have finished its analysis
+    FrozenPTA(PointerAnalysis* p);
+
+    /// Points-to set of a PAG node (empty for unknown nodes)
+    inline const PointsTo& getPts(NodeID id) const
+    {
+        return ptsCache.getActualPts(id < nodeToPts.size() ? nodeToPts[id] : PersistentPointsToCache<PointsTo>::emptyPointsToId());
+    }
+
+    /// Alias results, the same as BVDataPTAImpl::alias
+    //@{
+    AliasResult alias(NodeID node1, NodeID node2) const;
+    AliasResult alias(const Value* V1, const Value* V2) const;
+    //@}
+
+    /// Callees of a call site, direct or indirect
+    const FunctionSet& getCallees(const CallBlockNode* cs) const;
+
+    /// Whether a function is in a cycle of the call graph
+    bool isInRecursion(const SVFFunction* fun) const;
+
+    /// The PAG the snapshot refers to
+    inline PAG* getPAG() const
+    {
+        return pag;
+    }
+
+    /// Statistics
+    //@{
+    inline u32_t getNumOfNodes() const
+    {
+        return nodeToPts.size();
+    }
+    inline u32_t getNumOfUniquePts() const
+    {
+        return ptsCache.getNumOfUniquePts();
+    }
+    double buildTime;	///< time of taking the snapshot
+    //@}
+
+private:
+    PAG* pag;
+
+    /// Points-to sets and their field-expanded versions, stored once per distinct set
+    //@{
+    PersistentPointsToCache<PointsTo> ptsCache;
+    std::vector<PointsToID> nodeToPts;
+    std::vector<PointsToID> nodeToExpandedPts;
+    std::vector<bool> mayAliasAll;	///< whether an expanded set contains the black hole object
+    //@}
+
+    Map<const CallBlockNode*, FunctionSet> callSiteToCallees;
+    Set<const SVFFunction*> recursiveFuns;
+};
+
+} // End namespace SVF
+
+#endif /* FROZENPTA_H_ */
@@ -227,6 +227,9 @@ public:
         return computeAllLocations().intersects(RHS.computeAllLocations());
     }
 
+    /// Whether a location set keeps a single stride (-stride-only)
+    static bool isSingleStride();
+
     /// Check relations of two location sets
     static inline LSRelation checkRelation(const LocationSet& LHS, const LocationSet& RHS)
     {
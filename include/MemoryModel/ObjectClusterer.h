@@ -0,0 +1,78 @@
+//===- ObjectClusterer.h -- Renumbering objects inside points-to sets--------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * ObjectClusterer.h
+ *
+ * Object IDs are handed out in PAG construction order, so objects pointed to
+ * together are usually far apart and a points-to set spreads over many bit vector
+ * elements. Given the (approximate) points-to sets of an auxiliary analysis, the
+ * clusterer gives objects co-occurring in points-to sets consecutive bit positions
+ * and returns that numbering as a node mapping, which the analysis applies to the
+ * points-to sets it creates (PointsTo::NodeMappingScope). Object IDs seen by clients are unchanged.
+ */
+
+#ifndef OBJECTCLUSTERER_H_
+#define OBJECTCLUSTERER_H_
+
+#include "Util/BasicTypes.h"
+#include "Util/PointsTo.h"
+
+namespace SVF
+{
+
+class BVDataPTAImpl;
+
+class ObjectClusterer
+{
+public:
+    /// Compute a numbering of objects from the points-to sets of aux and return it as a
+    /// node mapping, or NULL unless it reduces the estimated number of bit vector elements.
+    static const PointsTo::NodeMapping* cluster(BVDataPTAImpl* aux);
+
+    /// Compute the numbering (original ID -> bit position) of every PAG node from the
+    /// points-to sets of aux, without installing it.
+    static void computeMapping(BVDataPTAImpl* aux, std::vector<NodeID>& mapping);
+
+    /// Statistics of the last call to cluster() in the current analysis run
+    //@{
+    static bool hasClustered()
+    {
+        return numOfDistinctPts != 0 || numOfClusteredObjs != 0;
+    }
+    static void resetStat();
+    static u32_t numOfClusteredObjs;    ///< objects placed by the points-to sets they occur in
+    static u32_t numOfDistinctPts;      ///< distinct non-singleton points-to sets of aux
+    static u32_t numOfElementsBefore;   ///< bit vector elements needed by those sets, originally
+    static u32_t numOfElementsAfter;    ///< ... and after renumbering
+    static bool mappingInstalled;
+    static double timeOfClustering;
+    //@}
+
+private:
+    /// Number of bit vector elements covering the IDs of pts (under mapping, if any).
+    static u32_t numOfElements(const PointsTo& pts, const std::vector<NodeID>* mapping);
+};
+
+} // End namespace SVF
+
+#endif /* OBJECTCLUSTERER_H_ */
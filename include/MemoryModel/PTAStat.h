@@ -103,6 +103,8 @@ public:
     static const char* AveragePointsToSetSize;		///< Average points-to size of all variables
     static const char* AverageTopLevPointsToSetSize; ///< Average points-to size of top-level variables
     static const char* MaxPointsToSetSize;			///< Max points-to size
+    static const char* PointsToSetMemUsage;		///< Approximate memory held by all points-to sets (KB)
+    static const char* PeakMemUsage;			///< Peak resident memory of the process (KB)
 
     static const char* NumOfIterations;	///< Number of iterations during resolution
 
@@ -124,7 +126,7 @@ public:
     /// Does not affect CLOCK_IN_MS.
     static bool markedClocksOnly;
 
-    typedef Map<const char*,u32_t> NUMStatMap;
+    typedef Map<const char*,u64_t> NUMStatMap;
 
     typedef Map<const char*,double> TIMEStatMap;
 
@@ -170,6 +172,13 @@ public:
     virtual void printStatPerQuery(NodeID, const PointsTo&) {}
 
     virtual void callgraphStat();
+
+    /// Statistics of the shared points-to set table, if the analysis uses one.
+    void ptCacheStat();
+    /// Statistics of the object renumbering, if objects were clustered.
+    void clusterStat();
+    /// Statistics of the alias query cache, if the analysis uses one.
+    void aliasCacheStat();
 private:
     void bitcastInstStat();
     void branchStat();
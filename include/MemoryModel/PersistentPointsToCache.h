@@ -0,0 +1,270 @@
+/// Hash-consed table of points-to sets shared by the persistent PTData
+/// implementations (PersistentPointsToDS.h).
+///
+/// Every distinct points-to set is stored exactly once and named by a PointsToID.
+/// Sets are never modified once stored: an "update" creates (or finds) the
+/// resulting set and hands back its ID. Because the table is canonical, two IDs are
+/// equal iff their sets are, so results of binary operations can be memoised per
+/// pair of IDs and repeated operations are answered by a single lookup.
+
+#ifndef PERSISTENT_POINTSTO_CACHE_H_
+#define PERSISTENT_POINTSTO_CACHE_H_
+
+#include "Util/BasicTypes.h"
+
+namespace SVF
+{
+
+typedef u32_t PointsToID;
+
+template <typename Data>
+class PersistentPointsToCache
+{
+public:
+    typedef std::pair<PointsToID, PointsToID> OpPair;
+    typedef Map<Data, PointsToID> PtsToIDMap;
+    typedef Map<OpPair, PointsToID> OpCache;
+
+    /// ID of the empty set, which every cache contains.
+    static inline PointsToID emptyPointsToId()
+    {
+        return 0;
+    }
+
+    PersistentPointsToCache()
+    {
+        reset();
+    }
+
+    /// Forget all sets and memoised operations.
+    void reset()
+    {
+        idToPts.clear();
+        ptsToId.clear();
+        unionCache.clear();
+        complementCache.clear();
+        intersectionCache.clear();
+
+        totalUnions = propertyUnions = lookupUnions = uniqueUnions = 0;
+        totalComplements = propertyComplements = lookupComplements = uniqueComplements = 0;
+        totalIntersections = propertyIntersections = lookupIntersections = uniqueIntersections = 0;
+
+        PointsToID empty = emplacePts(Data());
+        assert(empty == emptyPointsToId() && "first set is not the empty set!");
+        (void)empty;
+    }
+
+    /// Returns the ID of pts, adding pts to the table when it is new.
+    PointsToID emplacePts(const Data& pts)
+    {
+        typename PtsToIDMap::const_iterator it = ptsToId.find(pts);
+        if (it != ptsToId.end())
+            return it->second;
+
+        PointsToID id = idToPts.size();
+        it = ptsToId.emplace(pts, id).first;
+        /// nodes of the map are stable, so the key can be referenced directly
+        idToPts.push_back(&it->first);
+        return id;
+    }
+
+    /// As above, but takes ownership of a newly computed set.
+    PointsToID emplacePts(Data&& pts)
+    {
+        typename PtsToIDMap::const_iterator it = ptsToId.find(pts);
+        if (it != ptsToId.end())
+            return it->second;
+
+        PointsToID id = idToPts.size();
+        it = ptsToId.emplace(std::move(pts), id).first;
+        idToPts.push_back(&it->first);
+        return id;
+    }
+
+    /// Returns the set named by id.
+    inline const Data& getActualPts(PointsToID id) const
+    {
+        assert(id < idToPts.size() && "unknown points-to set ID!");
+        return *idToPts[id];
+    }
+
+    /// Returns the ID of lhs U rhs.
+    PointsToID unionPts(PointsToID lhs, PointsToID rhs)
+    {
+        ++totalUnions;
+
+        /// Union is commutative, so only one order is cached.
+        if (lhs > rhs)
+            std::swap(lhs, rhs);
+
+        /// Properties: x U x = x, x U {} = x.
+        if (lhs == rhs || rhs == emptyPointsToId())
+        {
+            ++propertyUnions;
+            return lhs;
+        }
+        if (lhs == emptyPointsToId())
+        {
+            ++propertyUnions;
+            return rhs;
+        }
+
+        OpPair operands = std::make_pair(lhs, rhs);
+        typename OpCache::const_iterator it = unionCache.find(operands);
+        if (it != unionCache.end())
+        {
+            ++lookupUnions;
+            return it->second;
+        }
+
+        ++uniqueUnions;
+        Data result = getActualPts(lhs);
+        result |= getActualPts(rhs);
+        PointsToID resultId = emplacePts(std::move(result));
+        unionCache[operands] = resultId;
+
+        /// Both operands are subsets of the result, so their union with it is free.
+        if (resultId != lhs)
+            unionCache[orderedPair(lhs, resultId)] = resultId;
+        if (resultId != rhs)
+            unionCache[orderedPair(rhs, resultId)] = resultId;
+
+        return resultId;
+    }
+
+    /// Returns the ID of lhs - rhs.
+    PointsToID complementPts(PointsToID lhs, PointsToID rhs)
+    {
+        ++totalComplements;
+
+        /// Properties: x - x = {}, {} - x = {}, x - {} = x.
+        if (lhs == rhs || lhs == emptyPointsToId())
+        {
+            ++propertyComplements;
+            return emptyPointsToId();
+        }
+        if (rhs == emptyPointsToId())
+        {
+            ++propertyComplements;
+            return lhs;
+        }
+
+        OpPair operands = std::make_pair(lhs, rhs);
+        typename OpCache::const_iterator it = complementCache.find(operands);
+        if (it != complementCache.end())
+        {
+            ++lookupComplements;
+            return it->second;
+        }
+
+        ++uniqueComplements;
+        Data result = getActualPts(lhs);
+        result.intersectWithComplement(getActualPts(rhs));
+        PointsToID resultId = emplacePts(std::move(result));
+        complementCache[operands] = resultId;
+
+        return resultId;
+    }
+
+    /// Returns the ID of lhs & rhs.
+    PointsToID intersectPts(PointsToID lhs, PointsToID rhs)
+    {
+        ++totalIntersections;
+
+        /// Intersection is commutative, so only one order is cached.
+        if (lhs > rhs)
+            std::swap(lhs, rhs);
+
+        /// Properties: x & x = x, x & {} = {}.
+        if (lhs == rhs)
+        {
+            ++propertyIntersections;
+            return lhs;
+        }
+        if (lhs == emptyPointsToId())
+        {
+            ++propertyIntersections;
+            return emptyPointsToId();
+        }
+
+        OpPair operands = std::make_pair(lhs, rhs);
+        typename OpCache::const_iterator it = intersectionCache.find(operands);
+        if (it != intersectionCache.end())
+        {
+            ++lookupIntersections;
+            return it->second;
+        }
+
+        ++uniqueIntersections;
+        Data result = getActualPts(lhs);
+        result &= getActualPts(rhs);
+        PointsToID resultId = emplacePts(std::move(result));
+        intersectionCache[operands] = resultId;
+
+        return resultId;
+    }
+
+    /// Statistics
+    //@{
+    /// Number of distinct points-to sets stored (including the empty set).
+    inline u32_t getNumOfUniquePts() const
+    {
+        return idToPts.size();
+    }
+    inline u32_t getNumOfUnions() const
+    {
+        return totalUnions;
+    }
+    /// Unions answered from the op cache or by a set property, without a set operation.
+    inline u32_t getNumOfCheapUnions() const
+    {
+        return propertyUnions + lookupUnions;
+    }
+    inline u32_t getNumOfComplements() const
+    {
+        return totalComplements;
+    }
+    inline u32_t getNumOfCheapComplements() const
+    {
+        return propertyComplements + lookupComplements;
+    }
+    inline u32_t getNumOfIntersections() const
+    {
+        return totalIntersections;
+    }
+    inline u32_t getNumOfCheapIntersections() const
+    {
+        return propertyIntersections + lookupIntersections;
+    }
+    //@}
+
+private:
+    static inline OpPair orderedPair(PointsToID a, PointsToID b)
+    {
+        return a < b ? std::make_pair(a, b) : std::make_pair(b, a);
+    }
+
+    /// Points-to set of each ID.
+    std::vector<const Data*> idToPts;
+    /// ID of each points-to set; owns the sets.
+    PtsToIDMap ptsToId;
+
+    /// Memoised operations: (lhs ID, rhs ID) -> result ID.
+    //@{
+    OpCache unionCache;
+    OpCache complementCache;
+    OpCache intersectionCache;
+    //@}
+
+    /// Operation counts: total, answered by a set property, answered by the cache,
+    /// and actually computed.
+    //@{
+    u32_t totalUnions, propertyUnions, lookupUnions, uniqueUnions;
+    u32_t totalComplements, propertyComplements, lookupComplements, uniqueComplements;
+    u32_t totalIntersections, propertyIntersections, lookupIntersections, uniqueIntersections;
+    //@}
+};
+
+} // End namespace SVF
+
+#endif  // PERSISTENT_POINTSTO_CACHE_H_
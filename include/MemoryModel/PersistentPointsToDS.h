@@ -0,0 +1,676 @@
+/// PTData (AbstractPointsToDS.h) implementations with a persistent backend.
+/// Each Key is given a PointsToID into a shared PersistentPointsToCache rather than
+/// its own points-to set, so equal points-to sets are stored once and repeated set
+/// operations are answered from the cache's operation memo.
+
+#ifndef PERSISTENT_POINTSTO_H_
+#define PERSISTENT_POINTSTO_H_
+
+#include "MemoryModel/PersistentPointsToCache.h"
+
+namespace SVF
+{
+
+template <typename Key, typename Datum, typename Data>
+class PersistentDiffPTData;
+template <typename Key, typename Datum, typename Data>
+class PersistentDFPTData;
+template <typename Key, typename Datum, typename Data>
+class PersistentIncDFPTData;
+
+/// PTData backed by a PersistentPointsToCache.
+template <typename Key, typename Datum, typename Data>
+class PersistentPTData : public PTData<Key, Datum, Data>
+{
+    friend class PersistentDiffPTData<Key, Datum, Data>;
+    friend class PersistentDFPTData<Key, Datum, Data>;
+    friend class PersistentIncDFPTData<Key, Datum, Data>;
+public:
+    typedef PTData<Key, Datum, Data> BasePTData;
+    typedef typename BasePTData::PTDataTy PTDataTy;
+    typedef typename BasePTData::KeySet KeySet;
+
+    typedef Map<Key, PointsToID> KeyToIDMap;
+    typedef Map<Datum, KeySet> RevPtsMap;
+    typedef typename Data::iterator iterator;
+
+    /// Constructor
+    PersistentPTData(PersistentPointsToCache<Data>& cache, PTDataTy ty = PTDataTy::PersBase)
+        : BasePTData(ty), ptCache(cache) { }
+
+    virtual ~PersistentPTData() { }
+
+    /// Return the map from keys to points-to set IDs
+    virtual inline const KeyToIDMap& getPtsMap() const
+    {
+        return ptsMap;
+    }
+
+    virtual inline void clear() override
+    {
+        ptsMap.clear();
+        revPtsMap.clear();
+    }
+
+    virtual inline const Data& getPts(const Key& var) override
+    {
+        return ptCache.getActualPts(getPtsId(var));
+    }
+
+    virtual inline const KeySet& getRevPts(const Datum& datum) override
+    {
+        return revPtsMap[datum];
+    }
+
+    virtual inline bool addPts(const Key &dstKey, const Datum& element) override
+    {
+        revPtsMap[element].insert(dstKey);
+        return unionPtsFromId(dstKey, getSingletonId(element));
+    }
+
+    virtual inline bool unionPts(const Key& dstKey, const Key& srcKey) override
+    {
+        PointsToID srcId = getPtsId(srcKey);
+        addRevPts(ptCache.getActualPts(srcId), dstKey);
+        return unionPtsFromId(dstKey, srcId);
+    }
+
+    virtual inline bool unionPts(const Key& dstKey, const Data& srcData) override
+    {
+        addRevPts(srcData, dstKey);
+        return unionPtsFromId(dstKey, ptCache.emplacePts(srcData));
+    }
+
+    virtual void clearPts(const Key& var, const Datum& element) override
+    {
+        PointsToID& id = ptsMap[var];
+        id = ptCache.complementPts(id, getSingletonId(element));
+    }
+
+    virtual void clearFullPts(const Key& var) override
+    {
+        ptsMap[var] = PersistentPointsToCache<Data>::emptyPointsToId();
+    }
+
+    virtual inline void dumpPTData() override
+    {
+        for (typename KeyToIDMap::const_iterator it = ptsMap.begin(), eit = ptsMap.end(); it != eit; ++it)
+        {
+            const Data& pts = ptCache.getActualPts(it->second);
+            if (pts.empty())
+                continue;
+            SVFUtil::outs() << it->first << " ==> { ";
+            for (iterator cit = pts.begin(), ecit = pts.end(); cit != ecit; ++cit)
+                SVFUtil::outs() << *cit << " ";
+            SVFUtil::outs() << "}\n";
+        }
+    }
+
+    /// Methods to support type inquiry through isa, cast, and dyn_cast:
+    ///@{
+    static inline bool classof(const PersistentPTData<Key, Datum, Data> *)
+    {
+        return true;
+    }
+
+    static inline bool classof(const PTData<Key, Datum, Data>* ptd)
+    {
+        return ptd->getPTDTY() == PTDataTy::PersBase;
+    }
+    ///@}
+
+protected:
+    /// ID of var's points-to set, without creating an entry for var.
+    inline PointsToID getPtsId(const Key& var) const
+    {
+        typename KeyToIDMap::const_iterator it = ptsMap.find(var);
+        if (it == ptsMap.end())
+            return PersistentPointsToCache<Data>::emptyPointsToId();
+        return it->second;
+    }
+
+    /// ID of the set {element}.
+    inline PointsToID getSingletonId(const Datum& element)
+    {
+        Data singleton;
+        singleton.set(element);
+        return ptCache.emplacePts(std::move(singleton));
+    }
+
+    /// pts(dstKey) = pts(dstKey) U set(srcId). Returns true if pts(dstKey) changed.
+    /// Reverse points-to is not updated.
+    inline bool unionPtsFromId(const Key& dstKey, PointsToID srcId)
+    {
+        PointsToID& dstId = ptsMap[dstKey];
+        PointsToID newId = ptCache.unionPts(dstId, srcId);
+        bool changed = newId != dstId;
+        dstId = newId;
+        return changed;
+    }
+
+    inline void addRevPts(const Data &ptsData, const Key& tgr)
+    {
+        for (iterator it = ptsData.begin(), eit = ptsData.end(); it != eit; ++it)
+            revPtsMap[*it].insert(tgr);
+    }
+
+    PersistentPointsToCache<Data>& ptCache;
+    KeyToIDMap ptsMap;
+    RevPtsMap revPtsMap;
+};
+
+/// DiffPTData backed by a PersistentPointsToCache.
+template <typename Key, typename Datum, typename Data>
+class PersistentDiffPTData : public DiffPTData<Key, Datum, Data>
+{
+public:
+    typedef PTData<Key, Datum, Data> BasePTData;
+    typedef DiffPTData<Key, Datum, Data> BaseDiffPTData;
+    typedef typename BasePTData::PTDataTy PTDataTy;
+    typedef typename BasePTData::KeySet KeySet;
+
+    typedef typename PersistentPTData<Key, Datum, Data>::KeyToIDMap KeyToIDMap;
+
+    /// Constructor
+    PersistentDiffPTData(PersistentPointsToCache<Data>& cache, PTDataTy ty = PTDataTy::PersDiff)
+        : BaseDiffPTData(ty), ptCache(cache), persPTData(cache) { }
+
+    virtual ~PersistentDiffPTData() { }
+
+    virtual inline const KeyToIDMap& getPtsMap() const
+    {
+        return persPTData.getPtsMap();
+    }
+
+    virtual inline void clear() override
+    {
+        persPTData.clear();
+        diffPtsMap.clear();
+        propaPtsMap.clear();
+    }
+
+    virtual inline const Data& getPts(const Key& var) override
+    {
+        return persPTData.getPts(var);
+    }
+
+    virtual inline const KeySet& getRevPts(const Datum& datum) override
+    {
+        return persPTData.getRevPts(datum);
+    }
+
+    virtual inline bool addPts(const Key &dstKey, const Datum& element) override
+    {
+        return persPTData.addPts(dstKey, element);
+    }
+
+    virtual inline bool unionPts(const Key& dstKey, const Key& srcKey) override
+    {
+        return persPTData.unionPts(dstKey, srcKey);
+    }
+
+    virtual inline bool unionPts(const Key& dstKey, const Data& srcData) override
+    {
+        return persPTData.unionPts(dstKey, srcData);
+    }
+
+    virtual void clearPts(const Key& var, const Datum& element) override
+    {
+        persPTData.clearPts(var, element);
+    }
+
+    virtual void clearFullPts(const Key& var) override
+    {
+        persPTData.clearFullPts(var);
+    }
+
+    virtual inline void dumpPTData() override
+    {
+        persPTData.dumpPTData();
+    }
+
+    virtual inline const Data &getDiffPts(Key &var) override
+    {
+        return ptCache.getActualPts(diffPtsMap[var]);
+    }
+
+    virtual inline bool computeDiffPts(Key &var, const Data &all) override
+    {
+        /// all is almost always var's own points-to set, whose ID is known already.
+        PointsToID allId = persPTData.getPtsId(var);
+        if (&all != &ptCache.getActualPts(allId))
+            allId = ptCache.emplacePts(all);
+
+        PointsToID& propaId = propaPtsMap[var];
+        PointsToID diffId = ptCache.complementPts(allId, propaId);
+        diffPtsMap[var] = diffId;
+        propaId = allId;
+
+        return diffId != PersistentPointsToCache<Data>::emptyPointsToId();
+    }
+
+    virtual inline void updatePropaPtsMap(Key &src, Key &dst) override
+    {
+        PointsToID srcId = propaPtsMap[src];
+        PointsToID& dstId = propaPtsMap[dst];
+        dstId = ptCache.intersectPts(dstId, srcId);
+    }
+
+    virtual inline void clearPropaPts(Key &var) override
+    {
+        propaPtsMap[var] = PersistentPointsToCache<Data>::emptyPointsToId();
+    }
+
+    /// Methods to support type inquiry through isa, cast, and dyn_cast:
+    ///@{
+    static inline bool classof(const PersistentDiffPTData<Key, Datum, Data> *)
+    {
+        return true;
+    }
+
+    static inline bool classof(const PTData<Key, Datum, Data>* ptd)
+    {
+        return ptd->getPTDTY() == PTDataTy::PersDiff;
+    }
+    ///@}
+
+private:
+    PersistentPointsToCache<Data>& ptCache;
+    /// Backing to implement the basic PTData methods. This allows us to avoid multiple-inheritance.
+    PersistentPTData<Key, Datum, Data> persPTData;
+    /// Diff points-to to be propagated.
+    KeyToIDMap diffPtsMap;
+    /// Points-to already propagated.
+    KeyToIDMap propaPtsMap;
+};
+
+/// DFPTData backed by a PersistentPointsToCache.
+template <typename Key, typename Datum, typename Data>
+class PersistentDFPTData : public DFPTData<Key, Datum, Data>
+{
+public:
+    typedef PTData<Key, Datum, Data> BasePTData;
+    typedef PersistentPTData<Key, Datum, Data> BasePersPTData;
+    typedef DFPTData<Key, Datum, Data> BaseDFPTData;
+    typedef typename BasePTData::PTDataTy PTDataTy;
+    typedef typename BasePTData::KeySet KeySet;
+
+    typedef typename BaseDFPTData::LocID LocID;
+    typedef typename BasePersPTData::KeyToIDMap KeyToIDMap;
+    typedef Map<LocID, KeyToIDMap> DFKeyToIDMap;	///< Data-flow point-to map
+    typedef typename DFKeyToIDMap::iterator DFKeyToIDMapIter;
+    typedef typename DFKeyToIDMap::const_iterator DFKeyToIDMapConstIter;
+
+    /// Constructor
+    PersistentDFPTData(PersistentPointsToCache<Data>& cache, PTDataTy ty = BaseDFPTData::PersDataFlow)
+        : BaseDFPTData(ty), ptCache(cache), persPTData(cache) { }
+
+    virtual ~PersistentDFPTData() { }
+
+    virtual inline const KeyToIDMap& getPtsMap() const
+    {
+        return persPTData.getPtsMap();
+    }
+
+    virtual inline void clear() override
+    {
+        persPTData.clear();
+        dfInPtsMap.clear();
+        dfOutPtsMap.clear();
+    }
+
+    virtual inline const Data& getPts(const Key& var) override
+    {
+        return persPTData.getPts(var);
+    }
+
+    virtual inline const KeySet& getRevPts(const Datum& datum) override
+    {
+        return persPTData.getRevPts(datum);
+    }
+
+    virtual inline bool hasDFInSet(LocID loc) const override
+    {
+        return dfInPtsMap.find(loc) != dfInPtsMap.end();
+    }
+
+    virtual inline bool hasDFOutSet(LocID loc) const override
+    {
+        return dfOutPtsMap.find(loc) != dfOutPtsMap.end();
+    }
+
+    virtual inline bool hasDFInSet(LocID loc, const Key& var) const override
+    {
+        DFKeyToIDMapConstIter it = dfInPtsMap.find(loc);
+        if (it == dfInPtsMap.end())
+            return false;
+        return it->second.find(var) != it->second.end();
+    }
+
+    virtual inline bool hasDFOutSet(LocID loc, const Key& var) const override
+    {
+        DFKeyToIDMapConstIter it = dfOutPtsMap.find(loc);
+        if (it == dfOutPtsMap.end())
+            return false;
+        return it->second.find(var) != it->second.end();
+    }
+
+    virtual inline const Data& getDFInPtsSet(LocID loc, const Key& var) override
+    {
+        return ptCache.getActualPts(dfInPtsMap[loc][var]);
+    }
+
+    virtual inline const Data& getDFOutPtsSet(LocID loc, const Key& var) override
+    {
+        return ptCache.getActualPts(dfOutPtsMap[loc][var]);
+    }
+
+    virtual inline bool updateDFInFromIn(LocID srcLoc, const Key& srcVar, LocID dstLoc, const Key& dstVar) override
+    {
+        return unionPtsThroughIds(dfInPtsMap[dstLoc][dstVar], dfInPtsMap[srcLoc][srcVar]);
+    }
+
+    virtual inline bool updateDFInFromOut(LocID srcLoc, const Key& srcVar, LocID dstLoc, const Key& dstVar) override
+    {
+        return unionPtsThroughIds(dfInPtsMap[dstLoc][dstVar], dfOutPtsMap[srcLoc][srcVar]);
+    }
+
+    virtual inline bool updateDFOutFromIn(LocID srcLoc, const Key& srcVar, LocID dstLoc, const Key& dstVar) override
+    {
+        return unionPtsThroughIds(dfOutPtsMap[dstLoc][dstVar], dfInPtsMap[srcLoc][srcVar]);
+    }
+
+    virtual inline bool updateAllDFInFromOut(LocID srcLoc, const Key& srcVar, LocID dstLoc, const Key& dstVar) override
+    {
+        return this->updateDFInFromOut(srcLoc, srcVar, dstLoc, dstVar);
+    }
+
+    virtual inline bool updateAllDFInFromIn(LocID srcLoc, const Key& srcVar, LocID dstLoc, const Key& dstVar) override
+    {
+        return this->updateDFInFromIn(srcLoc, srcVar, dstLoc, dstVar);
+    }
+
+    virtual inline bool updateAllDFOutFromIn(LocID loc, const Key& singleton, bool strongUpdates) override
+    {
+        bool changed = false;
+        if (this->hasDFInSet(loc))
+        {
+            /// Copy the keys: updating OUT may insert into the IN maps of other locations.
+            std::vector<Key> vars;
+            const KeyToIDMap& inMap = dfInPtsMap[loc];
+            for (typename KeyToIDMap::const_iterator it = inMap.begin(), eit = inMap.end(); it != eit; ++it)
+                vars.push_back(it->first);
+
+            for (const Key& var : vars)
+            {
+                /// Enable strong updates if it is required to do so
+                if (strongUpdates && var == singleton)
+                    continue;
+                if (updateDFOutFromIn(loc, var, loc, var))
+                    changed = true;
+            }
+        }
+        return changed;
+    }
+
+    virtual inline bool updateTLVPts(LocID srcLoc, const Key& srcVar, const Key& dstVar) override
+    {
+        return persPTData.unionPtsFromId(dstVar, dfInPtsMap[srcLoc][srcVar]);
+    }
+
+    virtual inline bool updateATVPts(const Key& srcVar, LocID dstLoc, const Key& dstVar) override
+    {
+        return unionPtsThroughIds(dfOutPtsMap[dstLoc][dstVar], persPTData.getPtsId(srcVar));
+    }
+
+    virtual inline void clearAllDFOutUpdatedVar(LocID) override
+    {
+    }
+
+    /// Override the methods defined in PTData.
+    /// Union/add points-to without adding reverse points-to, used internally
+    ///@{
+    virtual inline bool addPts(const Key &dstKey, const Datum& element) override
+    {
+        return persPTData.unionPtsFromId(dstKey, persPTData.getSingletonId(element));
+    }
+    virtual inline bool unionPts(const Key& dstKey, const Key& srcKey) override
+    {
+        return persPTData.unionPtsFromId(dstKey, persPTData.getPtsId(srcKey));
+    }
+    virtual inline bool unionPts(const Key& dstKey, const Data& srcData) override
+    {
+        return persPTData.unionPtsFromId(dstKey, ptCache.emplacePts(srcData));
+    }
+    virtual void clearPts(const Key& var, const Datum& element) override
+    {
+        persPTData.clearPts(var, element);
+    }
+    virtual void clearFullPts(const Key& var) override
+    {
+        persPTData.clearFullPts(var);
+    }
+    ///@}
+
+    virtual inline void dumpPTData() override
+    {
+        /// dump points-to of top-level pointers
+        persPTData.dumpPTData();
+    }
+
+    /// Methods to support type inquiry through isa, cast, and dyn_cast:
+    ///@{
+    static inline bool classof(const PersistentDFPTData<Key, Datum, Data> *)
+    {
+        return true;
+    }
+
+    static inline bool classof(const PTData<Key, Datum, Data>* ptd)
+    {
+        return ptd->getPTDTY() == BaseDFPTData::PersDataFlow
+               || ptd->getPTDTY() == BaseDFPTData::PersIncDataFlow;
+    }
+    ///@}
+
+protected:
+    /// set(dstId) = set(dstId) U set(srcId). Returns true if dstId changed.
+    inline bool unionPtsThroughIds(PointsToID& dstId, PointsToID srcId)
+    {
+        PointsToID newId = ptCache.unionPts(dstId, srcId);
+        bool changed = newId != dstId;
+        dstId = newId;
+        return changed;
+    }
+
+    PersistentPointsToCache<Data>& ptCache;
+    /// Backing to implement the basic PTData methods which are not overridden.
+    /// This allows us to avoid multiple-inheritance.
+    PersistentPTData<Key, Datum, Data> persPTData;
+    /// Data-flow IN set.
+    DFKeyToIDMap dfInPtsMap;
+    /// Data-flow OUT set.
+    DFKeyToIDMap dfOutPtsMap;
+};
+
+/// Incremental version of the persistent data-flow points-to data structure.
+/// Only variables whose IN/OUT sets changed are propagated, as in IncMutableDFPTData.
+template <typename Key, typename Datum, typename Data>
+class PersistentIncDFPTData : public PersistentDFPTData<Key, Datum, Data>
+{
+public:
+    typedef PTData<Key, Datum, Data> BasePTData;
+    typedef DFPTData<Key, Datum, Data> BaseDFPTData;
+    typedef PersistentDFPTData<Key, Datum, Data> BasePersDFPTData;
+    typedef typename BasePTData::PTDataTy PTDataTy;
+
+    typedef typename BaseDFPTData::LocID LocID;
+    typedef Map<LocID, NodeBS> UpdatedVarMap;	///< for propagating only newly added variable in IN/OUT set
+    typedef typename UpdatedVarMap::iterator UpdatedVarMapIter;
+
+private:
+    UpdatedVarMap outUpdatedVarMap;
+    UpdatedVarMap inUpdatedVarMap;
+
+public:
+    /// Constructor
+    PersistentIncDFPTData(PersistentPointsToCache<Data>& cache, PTDataTy ty = BasePTData::PersIncDataFlow)
+        : BasePersDFPTData(cache, ty) { }
+
+    virtual ~PersistentIncDFPTData() { }
+
+    virtual inline bool updateDFInFromIn(LocID srcLoc, const Key& srcVar, LocID dstLoc, const Key& dstVar) override
+    {
+        if (varHasNewDFInPts(srcLoc, srcVar)
+                && this->unionPtsThroughIds(this->dfInPtsMap[dstLoc][dstVar], this->dfInPtsMap[srcLoc][srcVar]))
+        {
+            setVarDFInSetUpdated(dstLoc, dstVar);
+            return true;
+        }
+        return false;
+    }
+
+    virtual inline bool updateDFInFromOut(LocID srcLoc, const Key& srcVar, LocID dstLoc, const Key& dstVar) override
+    {
+        if (varHasNewDFOutPts(srcLoc, srcVar)
+                && this->unionPtsThroughIds(this->dfInPtsMap[dstLoc][dstVar], this->dfOutPtsMap[srcLoc][srcVar]))
+        {
+            setVarDFInSetUpdated(dstLoc, dstVar);
+            return true;
+        }
+        return false;
+    }
+
+    virtual inline bool updateDFOutFromIn(LocID srcLoc, const Key& srcVar, LocID dstLoc, const Key& dstVar) override
+    {
+        if (varHasNewDFInPts(srcLoc, srcVar))
+        {
+            removeVarFromDFInUpdatedSet(srcLoc, srcVar);
+            if (this->unionPtsThroughIds(this->dfOutPtsMap[dstLoc][dstVar], this->dfInPtsMap[srcLoc][srcVar]))
+            {
+                setVarDFOutSetUpdated(dstLoc, dstVar);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    virtual inline bool updateAllDFInFromOut(LocID srcLoc, const Key& srcVar, LocID dstLoc, const Key& dstVar) override
+    {
+        if (this->unionPtsThroughIds(this->dfInPtsMap[dstLoc][dstVar], this->dfOutPtsMap[srcLoc][srcVar]))
+        {
+            setVarDFInSetUpdated(dstLoc, dstVar);
+            return true;
+        }
+        return false;
+    }
+
+    virtual inline bool updateAllDFInFromIn(LocID srcLoc, const Key& srcVar, LocID dstLoc, const Key& dstVar) override
+    {
+        if (this->unionPtsThroughIds(this->dfInPtsMap[dstLoc][dstVar], this->dfInPtsMap[srcLoc][srcVar]))
+        {
+            setVarDFInSetUpdated(dstLoc, dstVar);
+            return true;
+        }
+        return false;
+    }
+
+    virtual inline bool updateAllDFOutFromIn(LocID loc, const Key& singleton, bool strongUpdates) override
+    {
+        bool changed = false;
+        if (this->hasDFInSet(loc))
+        {
+            /// Only variables has new pts from IN set need to be updated.
+            NodeBS vars = inUpdatedVarMap[loc];
+            for (NodeBS::iterator it = vars.begin(), eit = vars.end(); it != eit; ++it)
+            {
+                const Key var = *it;
+                /// Enable strong updates if it is required to do so
+                if (strongUpdates && var == singleton)
+                    continue;
+                if (updateDFOutFromIn(loc, var, loc, var))
+                    changed = true;
+            }
+        }
+        return changed;
+    }
+
+    virtual inline bool updateTLVPts(LocID srcLoc, const Key& srcVar, const Key& dstVar) override
+    {
+        if (varHasNewDFInPts(srcLoc, srcVar))
+        {
+            removeVarFromDFInUpdatedSet(srcLoc, srcVar);
+            return this->persPTData.unionPtsFromId(dstVar, this->dfInPtsMap[srcLoc][srcVar]);
+        }
+        return false;
+    }
+
+    virtual inline bool updateATVPts(const Key& srcVar, LocID dstLoc, const Key& dstVar) override
+    {
+        if (this->unionPtsThroughIds(this->dfOutPtsMap[dstLoc][dstVar], this->persPTData.getPtsId(srcVar)))
+        {
+            setVarDFOutSetUpdated(dstLoc, dstVar);
+            return true;
+        }
+        return false;
+    }
+
+    virtual inline void clearAllDFOutUpdatedVar(LocID loc) override
+    {
+        if (this->hasDFOutSet(loc))
+            outUpdatedVarMap[loc].clear();
+    }
+
+    /// Methods to support type inquiry through isa, cast, and dyn_cast:
+    ///@{
+    static inline bool classof(const PersistentIncDFPTData<Key, Datum, Data> *)
+    {
+        return true;
+    }
+
+    static inline bool classof(const PTData<Key, Datum, Data>* ptd)
+    {
+        return ptd->getPTDTY() == BasePTData::PersIncDataFlow;
+    }
+    ///@}
+
+private:
+    /// Handle address-taken variables whose IN pts changed
+    //@{
+    inline void setVarDFInSetUpdated(LocID loc, const Key& var)
+    {
+        inUpdatedVarMap[loc].set(var);
+    }
+    inline void removeVarFromDFInUpdatedSet(LocID loc, const Key& var)
+    {
+        UpdatedVarMapIter it = inUpdatedVarMap.find(loc);
+        if (it != inUpdatedVarMap.end())
+            it->second.reset(var);
+    }
+    inline bool varHasNewDFInPts(LocID loc, const Key& var)
+    {
+        UpdatedVarMapIter it = inUpdatedVarMap.find(loc);
+        if (it != inUpdatedVarMap.end())
+            return it->second.test(var);
+        return false;
+    }
+    //@}
+
+    /// Handle address-taken variables whose OUT pts changed
+    //@{
+    inline void setVarDFOutSetUpdated(LocID loc, const Key& var)
+    {
+        outUpdatedVarMap[loc].set(var);
+    }
+    inline bool varHasNewDFOutPts(LocID loc, const Key& var)
+    {
+        UpdatedVarMapIter it = outUpdatedVarMap.find(loc);
+        if (it != outUpdatedVarMap.end())
+            return it->second.test(var);
+        return false;
+    }
+    //@}
+};
+
+} // End namespace SVF
+
+#endif  // PERSISTENT_POINTSTO_H_
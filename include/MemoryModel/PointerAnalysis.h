@@ -34,6 +34,7 @@
 #include "MemoryModel/ConditionalPT.h"
 #include "MemoryModel/AbstractPointsToDS.h"
 #include "MemoryModel/MutablePointsToDS.h"
+#include "MemoryModel/PersistentPointsToDS.h"
 #include "Graphs/PTACallGraph.h"
 #include "Util/SCC.h"
 #include "Util/PathCondAllocator.h"
@@ -72,6 +73,7 @@ public:
         FSDATAFLOW_WPA,	///< Traditional Dataflow-based flow sensitive WPA
         FSSPARSE_WPA,		///< Sparse flow sensitive WPA
         FSTBHC_WPA,		///< Sparse flow-sensitive type-based heap cloning WPA
+        VFS_WPA,		///< Versioned sparse flow-sensitive WPA
         FSCS_WPA,			///< Flow-, context- sensitive WPA
         FSCSPS_WPA,		///< Flow-, context-, path- sensitive WPA
         ADAPTFSCS_WPA,		///< Adaptive Flow-, context-, sensitive WPA
@@ -135,6 +137,8 @@ protected:
     bool alias_validation;
     /// Flag for iteration budget for on-the-fly statistics
     u32_t OnTheFlyIterBudgetForStat;
+    /// Flag for an analysis run internally for another one (no dumps, stats or result files)
+    bool auxiliary;
     //@}
 
     /// PAG
@@ -355,7 +359,9 @@ public:
     inline void setObjFieldInsensitive(NodeID id)
     {
         MemObj* mem =  const_cast<MemObj*>(pag->getBaseObj(id));
-        mem->setFieldInsensitive();
+        /// no write if already set, the memory objects may be shared by several analyses
+        if (!mem->isFieldInsensitive())
+            mem->setFieldInsensitive();
     }
     inline bool isFieldInsensitive(NodeID id) const
     {
@@ -376,6 +382,20 @@ public:
         print_stat = false;
     }
 
+    /// Run as an auxiliary analysis of another one, to be set before analyze()
+    //@{
+    inline void setAuxiliary()
+    {
+        auxiliary = true;
+        print_stat = false;
+        alias_validation = false;
+    }
+    inline bool isAuxiliary() const
+    {
+        return auxiliary;
+    }
+    //@}
+
     /// Get callees from an indirect callsite
     //@{
     inline CallEdgeMap& getIndCallMap()
@@ -49,6 +49,10 @@ public:
     typedef DFPTData<NodeID, NodeID, PointsTo> DFPTDataTy;
     typedef MutableDFPTData<NodeID, NodeID, PointsTo> MutDFPTDataTy;
     typedef IncMutableDFPTData<NodeID, NodeID, PointsTo> IncMutDFPTDataTy;
+    typedef PersistentPTData<NodeID, NodeID, PointsTo> PersPTDataTy;
+    typedef PersistentDiffPTData<NodeID, NodeID, PointsTo> PersDiffPTDataTy;
+    typedef PersistentDFPTData<NodeID, NodeID, PointsTo> PersDFPTDataTy;
+    typedef PersistentIncDFPTData<NodeID, NodeID, PointsTo> PersIncDFPTDataTy;
 
     /// Constructor
     BVDataPTAImpl(PAG* pag, PointerAnalysis::PTATY type, bool alias_check = true);
@@ -87,12 +91,14 @@ public:
     virtual inline void clearPts(NodeID id, NodeID element)
     {
         ptD->clearPts(id, element);
+        clearAliasCache();
     }
 
     /// Clear points-to set of id.
     virtual inline void clearFullPts(NodeID id)
     {
         ptD->clearFullPts(id);
+        clearAliasCache();
     }
 
     /// Union/add points-to. Add the reverse points-to for node collapse purpose
@@ -100,14 +106,17 @@ public:
     //@{
     virtual inline bool unionPts(NodeID id, const PointsTo& target)
     {
+        clearAliasCache();
         return ptD->unionPts(id, target);
     }
     virtual inline bool unionPts(NodeID id, NodeID ptd)
     {
+        clearAliasCache();
         return ptD->unionPts(id,ptd);
     }
     virtual inline bool addPts(NodeID id, NodeID ptd)
     {
+        clearAliasCache();
         return ptD->addPts(id,ptd);
     }
     //@}
@@ -116,17 +125,65 @@ public:
     virtual inline void clearAllPts()
     {
         ptD->clear();
+        clearAliasCache();
     }
 
     /// Expand FI objects
     virtual void expandFIObjs(const PointsTo& pts, PointsTo& expandedPts);
 
+    /// Finalize the analysis and start caching alias results
+    virtual void finalize();
+
+    /// Alias results of pairs of points-to sets, cached once the analysis has
+    /// finished (-alias-cache-size)
+    //@{
+    inline void clearAliasCache()
+    {
+        if (!aliasCache.empty())
+            aliasCache.clear();
+    }
+    inline u32_t getAliasCacheSize() const
+    {
+        return aliasCache.size();
+    }
+    inline u32_t getNumOfAliasCacheHits() const
+    {
+        return numOfAliasCacheHits;
+    }
+    inline u32_t getNumOfAliasCacheMisses() const
+    {
+        return numOfAliasCacheMisses;
+    }
+    //@}
+
     /// Interface for analysis result storage on filesystem.
+    /// Results are written in the format selected by -ptafile-format, and read
+    /// back in whichever format the file is in.
     //@{
     virtual void writeToFile(const std::string& filename);
     virtual bool readFromFile(const std::string& filename);
     //@}
 
+    /// Fingerprint of the PAG as built from the module, i.e., ignoring the nodes
+    /// created while solving. Binary result files only load into a matching PAG.
+    u64_t getPAGFingerprint() const;
+
+    /// Whether points-to sets are hash-consed in ptCache (-ptd=persistent).
+    inline bool usePersistentPTData() const
+    {
+        return SVFUtil::isa<PersPTDataTy>(ptD) || SVFUtil::isa<PersDiffPTDataTy>(ptD)
+               || SVFUtil::isa<PersDFPTDataTy>(ptD);
+    }
+
+    /// Collect every key which has a points-to set entry, whatever the backing.
+    void getAllKeysWithPts(NodeSet& keys) const;
+
+    /// Table of the shared points-to sets when using persistent points-to data.
+    inline const PersistentPointsToCache<PointsTo>& getPtCache() const
+    {
+        return ptCache;
+    }
+
 protected:
 
     /// Update callgraph. This should be implemented by its subclass.
@@ -175,12 +232,34 @@ protected:
         else assert(false && "BVDataPTAImpl::getPtsMap: not a PTData with a PtsMap!");
     }
 
+    /// Result files as "var -> { obj1 obj2 }" lines followed by "id base offset"
+    /// lines for the GepObjPNs.
+    //@{
+    void writeToTextFile(const std::string& filename);
+    bool readFromTextFile(const std::string& filename);
+    //@}
+
+    /// Versioned binary result files, read in place from the (mapped) file.
+    //@{
+    void writeToBinaryFile(const std::string& filename);
+    bool readFromBinaryFile(const llvm::MemoryBuffer& buffer);
+    //@}
+
     /// On the fly call graph construction
     virtual void onTheFlyCallGraphSolve(const CallSiteToFunPtrMap& callsites, CallEdgeMap& newEdges);
 
 private:
     /// Points-to data
     PTDataTy* ptD;
+    /// Shared points-to sets for persistent points-to data. Must outlive ptD.
+    PersistentPointsToCache<PointsTo> ptCache;
+
+    /// Alias results keyed on the (ordered) pair of pointers, dropped whenever a
+    /// points-to set changes
+    Map<NodePair, AliasResult> aliasCache;
+    bool aliasCacheEnabled;
+    u32_t numOfAliasCacheHits;
+    u32_t numOfAliasCacheMisses;
 
 public:
     /// Interface expose to users of our pointer analysis, given Location infos
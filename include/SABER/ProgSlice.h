@@ -46,6 +46,7 @@ public:
     typedef SVFGNodeSet::const_iterator SVFGNodeSetIter;
     typedef PathCondAllocator::Condition Condition;
     typedef Map<const SVFGNode*, Condition*> SVFGNodeToCondMap; 	///< map a SVFGNode to its condition during value-flow guard computation
+    typedef Map<const SVFGEdge*, Condition*> SVFGEdgeToCondMap; 	///< map a SVFGEdge to its value-flow guard
 
     typedef FIFOWorkList<const SVFGNode*> VFWorkList;		    ///< worklist for value-flow guard computation
     typedef FIFOWorkList<const BasicBlock*> CFWorkList;	///< worklist for control-flow guard computation
@@ -155,6 +156,23 @@ public:
     }
     //@}
 
+    /// Value-flow guards shared by all slices
+    //@{
+    static u32_t numOfGuardHits;	///< guards found in the cache
+    static u32_t numOfGuardMisses;	///< guards computed
+    static u64_t numOfSavedCondNodes;	///< BDD nodes of the guards found in the cache
+    static bool countSavedCondNodes;	///< whether to count numOfSavedCondNodes (-guard-stat)
+    static inline u32_t getGuardCacheSize()
+    {
+        return vfGuardCache.size();
+    }
+    /// Drop the cached guards when the SVFG they are keyed on goes away
+    static inline void clearGuardCache()
+    {
+        vfGuardCache.clear();
+    }
+    //@}
+
     /// Guarded reachability solve
     bool AllPathReachableSolve();
     bool isSatisfiableForAll();
@@ -241,6 +259,9 @@ protected:
 
     /// Compute guards for value-flows
     //@{
+    /// Guard of a value-flow edge, from the cache if another slice has computed it
+    Condition* getVFGuard(const SVFGEdge* edge);
+
     inline Condition* ComputeIntraVFGGuard(const BasicBlock* src, const BasicBlock* dst)
     {
         return pathAllocator->ComputeIntraVFGGuard(src,dst);
@@ -300,6 +321,10 @@ private:
     const SVFGNode* _curSVFGNode;			///<  current svfg node during guard computation
     Condition* finalCond;					///<  final condition
     const SVFG* svfg;						///<  SVFG
+
+    /// The guard of an edge only depends on its end nodes and its call site, not on the
+    /// source of the slice, so it is computed once for all slices
+    static SVFGEdgeToCondMap vfGuardCache;
 };
 
 } // End namespace SVF
@@ -89,7 +89,7 @@ private:
     /// Collect objects along points-to chains
     NodeBS& CollectPtsChain(BVDataPTAImpl* pta,NodeID id, NodeToPTSSMap& cachedPtsMap);
 
-    NodeBS globs;
+    PointsTo globs;
     /// Store all global SVFG nodes
     SVFGNodeSet globSVFGNodes;
 };
@@ -41,11 +41,14 @@ namespace SVF
 
 typedef CFLSolver<SVFG*,CxtDPItem> CFLSrcSnkSolver;
 
+class SliceTraversal;
+
 /*!
  * General source-sink analysis, which serves as a base analysis to be extended for various clients
  */
 class SrcSnkDDA : public CFLSrcSnkSolver
 {
+    friend class SliceTraversal;
 
 public:
     typedef ProgSlice::SVFGNodeSet SVFGNodeSet;
@@ -84,6 +87,7 @@ public:
         if (svfg != NULL)
             delete svfg;
         svfg = NULL;
+        ProgSlice::clearGuardCache();
 
         if (_curSlice != NULL)
             delete _curSlice;
@@ -227,14 +231,7 @@ protected:
     /// Forward traverse
     virtual inline void FWProcessCurNode(const DPIm& item)
     {
-        const SVFGNode* node = getNode(item.getCurNodeID());
-        if(isSink(node))
-        {
-            addSinkToCurSlice(node);
-            _curSlice->setPartialReachable();
-        }
-        else
-            addToCurForwardSlice(node);
+        FWProcessNode(_curSlice, getNode(item.getCurNodeID()));
     }
     /// Backward traverse
     virtual inline void BWProcessCurNode(const DPIm& item)
@@ -247,6 +244,11 @@ protected:
     }
     /// Propagate information forward by matching context
     virtual void FWProcessOutgoingEdge(const DPIm& item, SVFGEdge* edge);
+    /// Slice-independent parts of the forward traversal, shared with SliceTraversal
+    //@{
+    void FWProcessNode(ProgSlice* slice, const SVFGNode* node);
+    bool FWGetItem(ProgSlice* slice, const DPIm& item, const SVFGEdge* edge, DPIm& newItem);
+    //@}
     /// Propagate information backward without matching context, as forward analysis already did it
     virtual void BWProcessIncomingEdge(const DPIm& item, SVFGEdge* edge);
     /// Whether has been visited or not, in order to avoid recursion on SVFG
@@ -288,6 +290,11 @@ protected:
     {
         return _curSlice->isPartialReachable();
     }
+    /// Compute the guards of the current slice and report its bugs
+    void solveCurSlice();
+    /// Slice the sources on several threads (-saber-threads)
+    void analyzeInParallel();
+
     /// Dump SVFG with annotated slice informaiton
     //@{
     void dumpSlices();
@@ -297,6 +304,42 @@ protected:
 
 };
 
+/*!
+ * Forward and backward slicing of one source at a time, with a worklist and visited
+ * maps of its own so that several sources can be sliced concurrently
+ */
+class SliceTraversal : public CFLSrcSnkSolver
+{
+public:
+    SliceTraversal(SrcSnkDDA* d) : dda(d), curSlice(NULL)
+    {
+        setGraph(const_cast<SVFG*>(d->getSVFG()));
+    }
+
+    /// Compute the forward and backward slices of slice's source
+    void slice(ProgSlice* s);
+
+protected:
+    virtual inline void FWProcessCurNode(const SrcSnkDDA::DPIm& item)
+    {
+        dda->FWProcessNode(curSlice, getNode(item.getCurNodeID()));
+    }
+    virtual inline void BWProcessCurNode(const SrcSnkDDA::DPIm& item)
+    {
+        const SVFGNode* node = getNode(item.getCurNodeID());
+        if(curSlice->inForwardSlice(node))
+            curSlice->addToBackwardSlice(node);
+    }
+    virtual void FWProcessOutgoingEdge(const SrcSnkDDA::DPIm& item, SVFGEdge* edge);
+    virtual void BWProcessIncomingEdge(const SrcSnkDDA::DPIm& item, SVFGEdge* edge);
+
+private:
+    SrcSnkDDA* dda;		///< checker deciding the sinks
+    ProgSlice* curSlice;	///< slice being computed
+    SrcSnkDDA::SVFGNodeToDPItemsMap nodeToDPItemsMap;	///< forward visited dpitems
+    SrcSnkDDA::SVFGNodeSet visitedSet;	///< backward visited nodes
+};
+
 } // End namespace SVF
 
 #endif /* SRCSNKDDA_H_ */
@@ -0,0 +1,127 @@
+//===- PAGSnapshot.h -- Saving and restoring a built PAG ---------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * PAGSnapshot.h
+ *
+ * Binary snapshot of the PAG built by PAGBuilder, so that later runs on the same
+ * module can restore the PAG instead of visiting every instruction again.
+ *
+ * A snapshot records everything PAGBuilder adds on top of the nodes created from
+ * the symbol table: the nodes it creates (field value nodes, dummy nodes), its
+ * edges with their values, basic blocks and ICFG nodes, and the argument, return,
+ * phi and call site maps. LLVM values, basic blocks and types are written as their
+ * positions in a deterministic walk over the modules, ICFG nodes as their kind
+ * and instruction or function.
+ *
+ * Snapshots are named after a fingerprint of the modules and of the symbol table
+ * (-pag-snapshot-dir), so a changed module simply misses. Restoring still needs
+ * the modules, the symbol table and the ICFG, which are built as usual.
+ */
+
+#ifndef PAGSNAPSHOT_H_
+#define PAGSNAPSHOT_H_
+
+#include "Graphs/PAG.h"
+
+namespace SVF
+{
+
+/*!
+ * Write/read a PAG to/from a snapshot file
+ */
+class PAGSnapshot
+{
+public:
+    /// Constructor, numbers the values of the modules
+    PAGSnapshot(PAG* p);
+
+    /// Whether snapshots are enabled (-pag-snapshot-dir) and can be used for this PAG
+    static bool isEnabled();
+
+    /// Snapshot file of the current modules
+    std::string getFileName() const;
+
+    /// Write the PAG just built
+    bool write(const std::string& filename);
+
+    /// Restore the PAG from a snapshot, the PAG must only hold the symbol table nodes
+    /// (PAGBuilder::initalNode). Return false if there is no usable snapshot
+    bool read(const std::string& filename);
+
+    /// Whether a malformed snapshot was partly restored, the PAG has then been replaced
+    /// by a new empty one (PAG::resetPAG) to be built from scratch
+    inline bool isPAGDiscarded() const
+    {
+        return discarded;
+    }
+
+private:
+    typedef std::vector<u32_t> Words;
+
+    /// Numbering of values, basic blocks and types
+    //@{
+    void numberValues();
+    void numberValue(const Value* val);
+    void numberType(const Type* type);
+    u32_t getValueId(const Value* val) const;
+    u32_t getBBId(const BasicBlock* bb) const;
+    u32_t getTypeId(const Type* type) const;
+    const Value* getValue(u32_t id) const;
+    //@}
+
+    /// ICFG nodes are written as their kind and value
+    //@{
+    void writeICFGNode(Words& out, const ICFGNode* node) const;
+    ICFGNode* readICFGNode(u32_t kind, u32_t val) const;
+    //@}
+
+    /// Location sets are written as their offsets and (number, stride) pairs
+    //@{
+    void writeLocationSet(Words& out, const LocationSet& ls) const;
+    LocationSet readLocationSet(const Words& in, size_t& pos) const;
+    //@}
+
+    /// Fingerprint of the modules and the symbol table
+    //@{
+    u64_t getFingerprint() const;
+    u64_t getValueFingerprint(const Value* val) const;
+    u64_t getTypeFingerprint(const Type* type) const;
+    //@}
+
+    /// Restore the PAG from the words of a snapshot, return false on a malformed snapshot
+    bool restore(const Words& in);
+
+    PAG* pag;
+    std::vector<const Value*> idToValue;
+    Map<const Value*, u32_t> valueToId;
+    std::vector<const BasicBlock*> idToBB;
+    Map<const BasicBlock*, u32_t> bbToId;
+    std::vector<const Type*> idToType;
+    Map<const Type*, u32_t> typeToId;
+    u64_t fingerprint;
+    bool discarded;
+};
+
+} // End namespace SVF
+
+#endif /* PAGSNAPSHOT_H_ */
@@ -133,6 +133,9 @@ public:
     }
     //@}
 
+    /// Whether bytes/bits of memory locations are modelled (-locMM)
+    static bool isLocMemModel();
+
     /// Get callsite set
     //@{
     inline const CallSiteSet& getCallSiteSet() const
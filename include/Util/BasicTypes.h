@@ -31,6 +31,7 @@
 #define BASICTYPES_H_
 
 #include "Util/SVFBasicTypes.h"
+#include "Util/PointsTo.h"
 #include "SVF-FE/GEPTypeBridgeIterator.h"
 #include "Graphs/GraphPrinter.h"
 #include "Util/Casting.h"
@@ -122,6 +123,8 @@ typedef llvm::AliasResult AliasResult;
 typedef llvm::ModRefInfo ModRefInfo;
 typedef llvm::AnalysisID AnalysisID;
 typedef llvm::ConstantDataArray ConstantDataArray;
+typedef llvm::ConstantDataSequential ConstantDataSequential;
+typedef llvm::ConstantFP ConstantFP;
 
 /// LLVM metadata
 typedef llvm::NamedMDNode NamedMDNode;
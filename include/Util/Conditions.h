@@ -37,15 +37,91 @@
 namespace SVF
 {
 
+/*!
+ * Opaque handle of a condition. Each backend casts its own node type to it,
+ * a condition is only meaningful to the manager that created it.
+ */
+class CondExpr;
+
+/*!
+ * Interface of a condition backend used for path conditions
+ */
+class CondManager
+{
+public:
+    /// Kinds of backends
+    enum CondManagerTy
+    {
+        BDD,	///< reduced ordered BDDs (CUDD)
+        DAG	///< hash-consed AND/OR DAGs
+    };
+
+    /// Constructor
+    CondManager(CondManagerTy ty) : kind(ty), numOfApprox(0) {}
+
+    /// Destructor
+    virtual ~CondManager() {}
+
+    inline CondManagerTy getKind() const
+    {
+        return kind;
+    }
+    /// Name of the backend
+    virtual const char* getName() const = 0;
+
+    /// Atomic condition of branch i
+    virtual CondExpr* createCond(u32_t i) = 0;
+
+    virtual CondExpr* getTrueCond() const = 0;
+    virtual CondExpr* getFalseCond() const = 0;
+
+    /// Operations on conditions.
+    //@{
+    virtual CondExpr* AND(CondExpr* lhs, CondExpr* rhs) = 0;
+    virtual CondExpr* OR(CondExpr* lhs, CondExpr* rhs) = 0;
+    virtual CondExpr* NEG(CondExpr* lhs) = 0;
+    //@}
+
+    /// Atomic conditions (branch indices) a condition depends on
+    virtual void BddSupport(CondExpr* f, NodeBS &support) const = 0;
+    /// Number of nodes of a condition
+    virtual u32_t getCondSize(CondExpr* cond) const = 0;
+    /// Release a condition no longer used
+    virtual void markForRelease(CondExpr*) {}
+
+    /// Statistics
+    //@{
+    virtual u32_t getBDDMemUsage() = 0;
+    virtual u32_t getCondNumber() = 0;
+    virtual u32_t getMaxLiveCondNumber() = 0;
+    /// Number of operations whose result has been over-approximated to bound the size of conditions,
+    /// or (DAG conditions) whose tautology/contradiction check has been skipped
+    inline u32_t getNumOfApprox() const
+    {
+        return numOfApprox;
+    }
+    //@}
+
+    /// Dump conditions
+    //@{
+    virtual std::string dumpStr(CondExpr* lhs) const = 0;
+    virtual void printDbg(CondExpr* d) = 0;
+    //@}
+
+protected:
+    CondManagerTy kind;
+    u32_t numOfApprox;
+};
+
 /**
  * Using Cudd as conditions.
  */
-class BddCondManager
+class BddCondManager : public CondManager
 {
 public:
 
     /// Constructor
-    BddCondManager()
+    BddCondManager() : CondManager(BDD)
     {
         m_bdd_mgr = Cudd_Init(0, 0, CUDD_UNIQUE_SLOTS, CUDD_CACHE_SLOTS, 0);
     }
@@ -56,6 +132,15 @@ public:
         Cudd_Quit(m_bdd_mgr);
     }
 
+    virtual const char* getName() const
+    {
+        return "bdd";
+    }
+
+    virtual CondExpr* createCond(u32_t i)
+    {
+        return toCond(Cudd_bdd(i));
+    }
     DdNode* Cudd_bdd(u32_t i)
     {
         return Cudd_bddIthVar(m_bdd_mgr, i);
@@ -65,36 +150,41 @@ public:
         return Cudd_ReadSize(m_bdd_mgr);
     }
 
-    inline DdNode* getTrueCond() const
+    virtual CondExpr* getTrueCond() const
     {
-        return BddOne();
+        return toCond(BddOne());
     }
-    inline DdNode* getFalseCond() const
+    virtual CondExpr* getFalseCond() const
     {
-        return BddZero();
+        return toCond(BddZero());
     }
 
-    inline u32_t getBDDMemUsage()
+    virtual u32_t getBDDMemUsage()
     {
         return Cudd_ReadMemoryInUse(m_bdd_mgr);
     }
-    inline u32_t getCondNumber()
+    virtual u32_t getCondNumber()
     {
         return Cudd_ReadNodeCount(m_bdd_mgr);
     }
-    inline u32_t getMaxLiveCondNumber()
+    virtual u32_t getMaxLiveCondNumber()
     {
         return Cudd_ReadPeakLiveNodeCount(m_bdd_mgr);
     }
-    inline void markForRelease(DdNode* cond)
+    /// Number of BDD nodes of a condition
+    virtual u32_t getCondSize(CondExpr* cond) const
+    {
+        return Cudd_DagSize(toBdd(cond));
+    }
+    virtual void markForRelease(CondExpr* cond)
     {
-        Cudd_RecursiveDeref(m_bdd_mgr,cond);
+        Cudd_RecursiveDeref(m_bdd_mgr,toBdd(cond));
     }
     /// Operations on conditions.
     //@{
-    DdNode* AND(DdNode* lhs, DdNode* rhs);
-    DdNode* OR(DdNode* lhs, DdNode* rhs);
-    DdNode* NEG(DdNode* lhs);
+    virtual CondExpr* AND(CondExpr* lhs, CondExpr* rhs);
+    virtual CondExpr* OR(CondExpr* lhs, CondExpr* rhs);
+    virtual CondExpr* NEG(CondExpr* lhs);
     //@}
 
     /**
@@ -103,19 +193,27 @@ public:
      */
     void ddClearFlag(DdNode * f) const;
     void BddSupportStep( DdNode * f,  NodeBS &support) const;
-    void BddSupport( DdNode * f,  NodeBS &support) const;
-    void dump(DdNode* lhs, raw_ostream & O);
-    std::string dumpStr(DdNode* lhs) const;
+    virtual void BddSupport(CondExpr* f, NodeBS &support) const;
+    void dump(CondExpr* lhs, raw_ostream & O);
+    virtual std::string dumpStr(CondExpr* lhs) const;
     /// print minterms and debug information for the Ddnode
-    inline void printMinterms(DdNode* d)
+    inline void printMinterms(CondExpr* d)
     {
-        Cudd_PrintMinterm(m_bdd_mgr,d);
+        Cudd_PrintMinterm(m_bdd_mgr,toBdd(d));
     }
-    inline void printDbg(DdNode* d)
+    virtual void printDbg(CondExpr* d)
     {
-        Cudd_PrintDebug(m_bdd_mgr,d,0,3);
+        Cudd_PrintDebug(m_bdd_mgr,toBdd(d),0,3);
     }
 private:
+    static inline DdNode* toBdd(CondExpr* cond)
+    {
+        return reinterpret_cast<DdNode*>(cond);
+    }
+    static inline CondExpr* toCond(DdNode* node)
+    {
+        return reinterpret_cast<CondExpr*>(node);
+    }
     inline DdNode* BddOne() const
     {
         return Cudd_ReadOne(m_bdd_mgr);
@@ -128,6 +226,114 @@ private:
     DdManager *m_bdd_mgr;
 };
 
+/**
+ * Conditions as hash-consed AND/OR DAGs over branch conditions.
+ *
+ * AND/OR operands are flattened, sorted and de-duplicated, and complementary or
+ * absorbed operands are simplified away, so structurally equal conditions share
+ * one node. A condition over a few atomic conditions (-cond-dag-vars, at most 16) also keeps
+ * its truth table: conditions with the same truth table are the same node and a
+ * tautology/contradiction is true/false, as with BDDs. Wider conditions are kept
+ * as DAGs without truth tables, which never blow up on wide disjunctions; each
+ * of them counts as an approximation, as it may be a tautology not reduced to true.
+ * A DAG exceeding -max-cond-dag-size is over-approximated, as CUDD does when
+ * exceeding -maxbddsize.
+ */
+class DagCondManager : public CondManager
+{
+public:
+    /// Constructor
+    DagCondManager();
+
+    /// Destructor
+    ~DagCondManager();
+
+    virtual const char* getName() const
+    {
+        return "dag";
+    }
+
+    virtual CondExpr* createCond(u32_t i);
+
+    virtual CondExpr* getTrueCond() const
+    {
+        return toCond(trueNode);
+    }
+    virtual CondExpr* getFalseCond() const
+    {
+        return toCond(falseNode);
+    }
+
+    /// Operations on conditions.
+    //@{
+    virtual CondExpr* AND(CondExpr* lhs, CondExpr* rhs);
+    virtual CondExpr* OR(CondExpr* lhs, CondExpr* rhs);
+    virtual CondExpr* NEG(CondExpr* lhs);
+    //@}
+
+    virtual void BddSupport(CondExpr* f, NodeBS &support) const;
+    virtual u32_t getCondSize(CondExpr* cond) const;
+
+    /// Statistics
+    //@{
+    virtual u32_t getBDDMemUsage()
+    {
+        return memUsage;
+    }
+    virtual u32_t getCondNumber()
+    {
+        return nodes.size();
+    }
+    /// Nodes are never released
+    virtual u32_t getMaxLiveCondNumber()
+    {
+        return nodes.size();
+    }
+    //@}
+
+    virtual std::string dumpStr(CondExpr* lhs) const;
+    virtual void printDbg(CondExpr* d);
+
+private:
+    struct DagNode;
+    typedef std::vector<const DagNode*> DagNodeVec;
+    typedef std::vector<u64_t> TruthTable;
+    struct KeyHash
+    {
+        size_t operator()(const std::vector<u64_t>& key) const;
+    };
+    typedef Map<std::vector<u64_t>, const DagNode*, KeyHash> UniqueTable;
+
+    static inline const DagNode* toDag(CondExpr* cond)
+    {
+        return reinterpret_cast<const DagNode*>(cond);
+    }
+    static inline CondExpr* toCond(const DagNode* node)
+    {
+        return reinterpret_cast<CondExpr*>(const_cast<DagNode*>(node));
+    }
+
+    /// AND (isAnd) or OR of two conditions
+    const DagNode* mkJunction(bool isAnd, const DagNode* lhs, const DagNode* rhs);
+    /// Hash-cons a node, ops must be sorted by ID
+    const DagNode* mkNode(u32_t kind, u32_t var, const DagNodeVec& ops);
+    /// Compute the support and, if it is narrow enough, the truth table of a new node
+    void computeTruthTable(DagNode* node);
+    /// Truth table of node over vars, a superset of its support
+    TruthTable expand(const DagNode* node, const std::vector<u32_t>& vars) const;
+    /// Drop the variables a truth table does not depend on
+    void reduce(std::vector<u32_t>& vars, TruthTable& tt) const;
+    /// Print a condition
+    void dump(const DagNode* node, std::string& str) const;
+
+    std::vector<DagNode*> nodes;	///< all nodes, indexed by ID
+    UniqueTable structTable;	///< (kind, var, operands) -> node
+    UniqueTable truthTable;	///< (support, truth table) -> node
+    const DagNode* trueNode;
+    const DagNode* falseNode;
+    u32_t memUsage;	///< bytes of the nodes
+};
+
 } // End namespace SVF
 
 #endif /* BITVECTORCOND_H_ */
@@ -0,0 +1,217 @@
+//===- CoreBitVector.h -- Dynamically sized bit vector data structure ------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * CoreBitVector.h
+ *
+ * A contiguous bit vector which only covers the range of bits between its
+ * smallest and largest set bit (the "core"). The vector grows in both directions
+ * as needed, so objects with nearby IDs are stored densely without paying for
+ * the (usually huge) prefix of unused IDs a plain bit vector would need.
+ *
+ * Invariant: the first and last words are non-zero, or there are no words at all.
+ */
+
+#ifndef COREBITVECTOR_H_
+#define COREBITVECTOR_H_
+
+#include "Util/SVFBasicTypes.h"
+
+namespace SVF
+{
+
+class CoreBitVector
+{
+public:
+    typedef unsigned long long Word;
+
+    static const u32_t WordSize = sizeof(Word) * 8;
+
+    class CoreBitVectorIterator;
+    typedef CoreBitVectorIterator iterator;
+    typedef CoreBitVectorIterator const_iterator;
+
+    /// Construct an empty bit vector
+    CoreBitVector() : offset(0) {}
+
+    /// Returns true if no bits are set.
+    inline bool empty() const
+    {
+        return words.empty();
+    }
+
+    /// Returns the number of set bits.
+    u32_t count() const;
+
+    /// Empty the vector.
+    inline void clear()
+    {
+        offset = 0;
+        words.clear();
+    }
+
+    /// Returns true if bit is set in this vector.
+    bool test(u32_t bit) const;
+
+    /// Check if bit is set. If it is, returns false.
+    /// Otherwise, sets bit and returns true.
+    bool test_and_set(u32_t bit);
+
+    /// Sets bit in the vector.
+    void set(u32_t bit);
+
+    /// Resets bit in the vector.
+    void reset(u32_t bit);
+
+    /// Returns true if this vector contains all bits of rhs.
+    bool contains(const CoreBitVector &rhs) const;
+
+    /// Returns true if this vector and rhs share any bits.
+    bool intersects(const CoreBitVector &rhs) const;
+
+    /// Returns true if this vector and rhs have the same bits set.
+    bool operator==(const CoreBitVector &rhs) const
+    {
+        return offset == rhs.offset && words == rhs.words;
+    }
+
+    /// Returns true if either this vector or rhs has a bit set unique to the other.
+    bool operator!=(const CoreBitVector &rhs) const
+    {
+        return !(*this == rhs);
+    }
+
+    /// Put union of this vector and rhs into this vector.
+    /// Returns true if this vector changed.
+    bool operator|=(const CoreBitVector &rhs);
+
+    /// Put intersection of this vector and rhs into this vector.
+    /// Returns true if this vector changed.
+    bool operator&=(const CoreBitVector &rhs);
+
+    /// Remove all bits set in rhs from this vector.
+    /// Returns true if this vector changed.
+    bool operator-=(const CoreBitVector &rhs);
+
+    /// Same as -=.
+    inline bool intersectWithComplement(const CoreBitVector &rhs)
+    {
+        return *this -= rhs;
+    }
+
+    /// Put this vector = lhs - rhs.
+    void intersectWithComplement(const CoreBitVector &lhs, const CoreBitVector &rhs);
+
+    /// Hash for this vector.
+    size_t hash() const;
+
+    /// Returns the number of bytes used by this vector.
+    inline size_t getMemoryUsage() const
+    {
+        return sizeof(CoreBitVector) + words.capacity() * sizeof(Word);
+    }
+
+    /// Iterators over set bits (in ascending order).
+    ///@{
+    const_iterator begin() const;
+    const_iterator end() const;
+    ///@}
+
+private:
+    /// Add enough words (prepend) to be able to include bit.
+    void extendBackward(u32_t bit);
+    /// Add enough words (append) to be able to include bit.
+    void extendForward(u32_t bit);
+    /// Add enough words (append xor prepend) to be able to include bit.
+    void extendTo(u32_t bit);
+
+    /// Returns the index into words which would hold bit.
+    inline size_t indexForBit(u32_t bit) const
+    {
+        assert(canHold(bit) && "bit outside the core!");
+        return (bit - offset) / WordSize;
+    }
+
+    /// Returns whether this vector's core covers bit.
+    inline bool canHold(u32_t bit) const
+    {
+        return !words.empty() && bit >= offset && bit < offset + words.size() * WordSize;
+    }
+
+    /// Returns the last bit the core can hold.
+    inline u32_t finalBit() const
+    {
+        return offset + words.size() * WordSize - 1;
+    }
+
+    /// Remove leading and trailing zero words to restore the invariant.
+    void trim();
+
+public:
+    class CoreBitVectorIterator
+    {
+        friend class CoreBitVector;
+    public:
+        CoreBitVectorIterator() : cbv(nullptr), wordIdx(0), curWord(0) {}
+
+        const CoreBitVectorIterator &operator++();
+        CoreBitVectorIterator operator++(int);
+
+        /// Dereference: returns the bit currently pointed to.
+        inline u32_t operator*() const
+        {
+            return cbv->offset + wordIdx * WordSize + __builtin_ctzll(curWord);
+        }
+
+        inline bool operator==(const CoreBitVectorIterator &rhs) const
+        {
+            return cbv == rhs.cbv && wordIdx == rhs.wordIdx && curWord == rhs.curWord;
+        }
+        inline bool operator!=(const CoreBitVectorIterator &rhs) const
+        {
+            return !(*this == rhs);
+        }
+
+    private:
+        /// Constructs an iterator over cbv, pointing to the first set bit (or the end).
+        CoreBitVectorIterator(const CoreBitVector *cbv, bool end);
+
+        /// Move to the next non-zero word (or the end).
+        void skipZeroWords();
+
+        const CoreBitVector *cbv;
+        /// Index of the word currently being iterated.
+        size_t wordIdx;
+        /// Bits of the current word yet to be visited.
+        Word curWord;
+    };
+
+private:
+    /// The first bit of the first word.
+    u32_t offset;
+    /// The core of the bit vector.
+    std::vector<Word> words;
+};
+
+} // End namespace SVF
+
+#endif /* COREBITVECTOR_H_ */
@@ -34,6 +34,7 @@
 #include "MemoryModel/ConditionalPT.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>    // std::sort
+#include <atomic>
 
 namespace SVF
 {
@@ -47,7 +48,7 @@ class DPItem
 {
 protected:
     NodeID cur;
-    static u64_t maximumBudget;
+    static thread_local u64_t maximumBudget;	///< per thread, set by the analysis running a query
 
 public:
     /// Constructor
@@ -250,8 +251,10 @@ public:
         {
             context.push_back(ctx);
 
-            if(context.size() > maximumCxt)
-                maximumCxt = context.size();
+            u32_t size = context.size();
+            u32_t max = maximumCxt.load(std::memory_order_relaxed);
+            while (size > max && !maximumCxt.compare_exchange_weak(max, size, std::memory_order_relaxed))
+                ;
             return true;
         }
         else   /// handle out of context limit case
@@ -342,7 +345,7 @@ private:
     static u32_t maximumCxtLen;
     bool concreteCxt;
 public:
-    static u32_t maximumCxt;
+    static std::atomic<u32_t> maximumCxt;	///< longest context pushed, by any thread
 };
 
 /*!
@@ -0,0 +1,107 @@
+//===- Parallel.h -- Fork-join helpers used by multi-threaded solvers--------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * Parallel.h
+ *
+ * A minimal fork-join layer. Callers hand a range of independent work items
+ * to parallelFor, which distributes them over a set of short-lived threads and
+ * returns once every item is done. All synchronisation of shared analysis state
+ * is the caller's responsibility: work items are expected to write only to
+ * data they own (e.g. a per-thread buffer indexed by the thread id).
+ */
+
+#ifndef INCLUDE_UTIL_PARALLEL_H_
+#define INCLUDE_UTIL_PARALLEL_H_
+
+#include "Util/SVFBasicTypes.h"
+
+#include <atomic>
+#include <thread>
+
+namespace SVF
+{
+
+namespace ParallelUtil
+{
+
+/// Resolve a requested number of worker threads, 0 means "all hardware threads"
+inline u32_t getNumOfThreads(u32_t requested)
+{
+    if (requested != 0)
+        return requested;
+    u32_t hw = std::thread::hardware_concurrency();
+    return hw == 0 ? 1 : hw;
+}
+
+/*!
+ * Run func(i, tid) for each i in [0, num) using up to numOfThreads threads,
+ * where tid in [0, numOfThreads) identifies the executing thread.
+ * Items are handed out dynamically in chunks of chunkSize.
+ * The range is processed serially on the calling thread (tid 0) when it is too small
+ * to give every thread at least one chunk.
+ */
+template<typename Func>
+void parallelFor(u32_t num, u32_t numOfThreads, Func func, u32_t chunkSize = 64)
+{
+    if (chunkSize == 0)
+        chunkSize = 1;
+    u32_t numOfChunks = (num + chunkSize - 1) / chunkSize;
+    if (numOfThreads > numOfChunks)
+        numOfThreads = numOfChunks;
+
+    if (numOfThreads <= 1)
+    {
+        for (u32_t i = 0; i < num; ++i)
+            func(i, 0);
+        return;
+    }
+
+    std::atomic<u32_t> next(0);
+    auto worker = [&](u32_t tid)
+    {
+        while (true)
+        {
+            u32_t begin = next.fetch_add(chunkSize);
+            if (begin >= num)
+                break;
+            u32_t end = begin + chunkSize < num ? begin + chunkSize : num;
+            for (u32_t i = begin; i < end; ++i)
+                func(i, tid);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(numOfThreads - 1);
+    for (u32_t tid = 1; tid < numOfThreads; ++tid)
+        threads.emplace_back(worker, tid);
+    /// the calling thread works as thread 0
+    worker(0);
+    for (std::thread& t : threads)
+        t.join();
+}
+
+} // End namespace ParallelUtil
+
+} // End namespace SVF
+
+#endif /* INCLUDE_UTIL_PARALLEL_H_ */
@@ -47,7 +47,7 @@ class PathCondAllocator
 public:
     static u32_t totalCondNum;
 
-    typedef DdNode Condition;
+    typedef CondExpr Condition;
     typedef Map<u32_t,Condition*> CondPosMap;		///< map a branch to its Condition
     typedef Map<const BasicBlock*, CondPosMap > BBCondMap;	// map bb to a Condition
     typedef Map<const Condition*, const Instruction* > CondToTermInstMap;	// map a condition to its branch instruction
@@ -61,7 +61,7 @@ public:
     /// Constructor
     PathCondAllocator()
     {
-        getBddCondManager();
+        getCondManager();
     }
     /// Destructor
     virtual ~PathCondAllocator()
@@ -70,27 +70,35 @@ public:
     }
     static inline Condition* trueCond()
     {
-        return getBddCondManager()->getTrueCond();
+        return getCondManager()->getTrueCond();
     }
 
     static inline Condition* falseCond()
     {
-        return getBddCondManager()->getFalseCond();
+        return getCondManager()->getFalseCond();
     }
 
     /// Statistics
     //@{
     static inline u32_t getMemUsage()
     {
-        return getBddCondManager()->getBDDMemUsage();
+        return getCondManager()->getBDDMemUsage();
     }
     static inline u32_t getCondNum()
     {
-        return getBddCondManager()->getCondNumber();
+        return getCondManager()->getCondNumber();
     }
     static inline u32_t getMaxLiveCondNumber()
     {
-        return getBddCondManager()->getMaxLiveCondNumber();
+        return getCondManager()->getMaxLiveCondNumber();
+    }
+    static inline u32_t getNumOfApproxCond()
+    {
+        return getCondManager()->getNumOfApprox();
+    }
+    static inline const char* getCondBackendName()
+    {
+        return getCondManager()->getName();
     }
     //@}
 
@@ -157,6 +165,11 @@ public:
         bddCondMgr->BddSupport(cond,elems);
         return elems;
     }
+    /// Number of BDD nodes of a condition
+    inline u32_t getCondSize(Condition* cond) const
+    {
+        return bddCondMgr->getCondSize(cond);
+    }
     /// Decrease reference counting for the bdd
     inline void markForRelease(Condition* cond)
     {
@@ -278,7 +291,7 @@ private:
     inline Condition* createNewCond(u32_t i)
     {
         assert(indexToDDNodeMap.find(i)==indexToDDNodeMap.end() && "This should be fresh index to create new BDD");
-        Condition* d = bddCondMgr->Cudd_bdd(i);
+        Condition* d = bddCondMgr->createCond(i);
         indexToDDNodeMap[i] = d;
         return d;
     }
@@ -292,12 +305,14 @@ private:
     }
 
     /// Used internally, not supposed to be exposed to other classes
-    static BddCondManager* getBddCondManager()
+    static CondManager* getCondManager()
     {
         if(bddCondMgr==NULL)
-            bddCondMgr = new BddCondManager();
+            bddCondMgr = createCondManager();
         return bddCondMgr;
     }
+    /// Create the condition backend selected by -cond-backend
+    static CondManager* createCondManager();
 
     /// Release memory
     void destroy();
@@ -309,7 +324,7 @@ private:
     const Value* curEvalVal;			///< current llvm value to evaluate branch condition when computing guards
 
 protected:
-    static BddCondManager* bddCondMgr;		///< bbd manager
+    static CondManager* bddCondMgr;		///< condition manager (BDDs by default)
     BBCondMap bbConds;						///< map basic block to its successors/predecessors branch conditions
     IndexToConditionMap indexToDDNodeMap;
 
@@ -0,0 +1,298 @@
+//===- PointsTo.h -- Points-to set abstraction ------------------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * PointsTo.h
+ *
+ * A points-to set whose underlying representation is chosen at run time:
+ *  - SBV: llvm::SparseBitVector (the historical representation),
+ *  - CBV: CoreBitVector, a dense bit vector covering only [min, max] of the set,
+ *  - FSV: a flat, sorted vector of object IDs, good for the many tiny sets.
+ *
+ * Every set is created with the default type (see -ptset), so all sets taking part
+ * in one analysis share a representation. Binary operations on sets of different
+ * types are still correct but convert the right operand first.
+ *
+ * Sets may also store object IDs under a node mapping (see createNodeMapping), which
+ * renumbers objects so that those pointed to together occupy nearby bits. The mapping
+ * is internal: every member function takes and returns the original IDs. An analysis
+ * applies its mapping to the sets it creates through a NodeMappingScope, so sets created
+ * outside it, e.g., by other analyses, keep the identity.
+ */
+
+#ifndef POINTSTO_H_
+#define POINTSTO_H_
+
+#include "Util/SVFBasicTypes.h"
+#include "Util/CoreBitVector.h"
+
+namespace SVF
+{
+
+class PointsTo
+{
+public:
+    /// Underlying representation
+    enum Type
+    {
+        SBV,    ///< sparse bit vector
+        CBV,    ///< core bit vector
+        FSV     ///< flat sorted vector
+    };
+
+    class PointsToIterator;
+    typedef PointsToIterator iterator;
+    typedef PointsToIterator const_iterator;
+
+    /// A bijection between object IDs and the bit positions storing them.
+    /// IDs beyond the end of the vectors are stored as themselves.
+    struct NodeMapping
+    {
+        std::vector<NodeID> toInternal;
+        std::vector<NodeID> toExternal;
+    };
+
+    /// Construct an empty set of the default type and the current node mapping.
+    PointsTo();
+    /// Construct an empty set of the given type and the current node mapping.
+    explicit PointsTo(Type type);
+    PointsTo(const PointsTo &pt);
+    PointsTo(PointsTo &&pt);
+    ~PointsTo();
+
+    PointsTo &operator=(const PointsTo &rhs);
+    PointsTo &operator=(PointsTo &&rhs);
+
+    /// Returns true if set is empty.
+    bool empty() const;
+
+    /// Returns number of elements.
+    u32_t count() const;
+
+    /// Empty the set.
+    void clear();
+
+    /// Returns true if n is in this set.
+    bool test(u32_t n) const;
+
+    /// Check if n is in set. If it is, returns false.
+    /// Otherwise, inserts n and returns true.
+    bool test_and_set(u32_t n);
+
+    /// Inserts n in the set.
+    void set(u32_t n);
+
+    /// Removes n from the set.
+    void reset(u32_t n);
+
+    /// Returns true if this set is a superset of rhs.
+    bool contains(const PointsTo &rhs) const;
+
+    /// Returns true if this set and rhs share any elements.
+    bool intersects(const PointsTo &rhs) const;
+
+    /// Returns the first element in iteration order, or -1 when the set is empty.
+    /// This is the smallest element unless the set uses a node mapping.
+    int find_first() const;
+
+    /// Returns true if this set and rhs contain exactly the same elements.
+    bool operator==(const PointsTo &rhs) const;
+
+    /// Returns true if either this set or rhs has an element not in the other.
+    inline bool operator!=(const PointsTo &rhs) const
+    {
+        return !(*this == rhs);
+    }
+
+    /// Put union of this set and rhs into this set.
+    /// Returns true if this set changed.
+    bool operator|=(const PointsTo &rhs);
+    bool operator|=(const NodeBS &rhs);
+
+    /// Put intersection of this set and rhs into this set.
+    /// Returns true if this set changed.
+    bool operator&=(const PointsTo &rhs);
+
+    /// Remove elements of rhs from this set.
+    /// Returns true if this set changed.
+    bool operator-=(const PointsTo &rhs);
+
+    /// Same as -=.
+    inline bool intersectWithComplement(const PointsTo &rhs)
+    {
+        return *this -= rhs;
+    }
+
+    /// Put this set = lhs - rhs.
+    void intersectWithComplement(const PointsTo &lhs, const PointsTo &rhs);
+
+    /// Returns this points-to set as a NodeBS.
+    NodeBS toNodeBS() const;
+
+    /// Hash of the object IDs of this set, equal for sets equal under ==
+    /// whatever their type or node mapping.
+    size_t hash() const;
+
+    /// Approximate number of bytes used by this set.
+    size_t getMemoryUsage() const;
+
+    inline Type getType() const
+    {
+        return type;
+    }
+
+    /// Type of the sets constructed without an explicit type (-ptset).
+    //@{
+    static Type getDefaultType();
+    static void setDefaultType(Type type);
+    static const char *getTypeName(Type type);
+    //@}
+
+    /// Node mappings.
+    /// createNodeMapping returns a mapping which lives as long as the program, as sets
+    /// keep referring to it; externalToInternal must be a permutation of
+    /// [0, externalToInternal.size()). getNodeMapping returns the mapping of the sets
+    /// constructed now, i.e., that of the innermost NodeMappingScope, or NULL.
+    //@{
+    static const NodeMapping *createNodeMapping(const std::vector<NodeID> &externalToInternal);
+    static const NodeMapping *getNodeMapping();
+    //@}
+
+    /// Sets constructed while an instance is alive use its mapping (NULL for the identity),
+    /// the previous mapping is restored on destruction. Existing sets keep their mapping.
+    /// Scopes are entered and left by the main thread only.
+    class NodeMappingScope
+    {
+    public:
+        explicit NodeMappingScope(const NodeMapping *mapping);
+        ~NodeMappingScope();
+
+    private:
+        const NodeMapping *prevMapping;
+    };
+
+    inline const NodeMapping *getMapping() const
+    {
+        return mapping;
+    }
+
+    const_iterator begin() const;
+    const_iterator end() const;
+
+private:
+    PointsTo(Type type, const NodeMapping *mapping);
+
+    /// Translate between object IDs and bit positions.
+    //@{
+    inline NodeID toInternal(NodeID n) const
+    {
+        return mapping && n < mapping->toInternal.size() ? mapping->toInternal[n] : n;
+    }
+    inline NodeID toExternal(NodeID n) const
+    {
+        return mapping && n < mapping->toExternal.size() ? mapping->toExternal[n] : n;
+    }
+    //@}
+
+    /// Whether rhs stores its elements exactly as this set does.
+    inline bool sameLayout(const PointsTo &rhs) const
+    {
+        return type == rhs.type && mapping == rhs.mapping;
+    }
+
+    /// Construct the active member for type (which must not be live).
+    void initMember(Type t);
+    /// Destruct the active member.
+    void destroyMember();
+    /// Copy or move the active member of pt into this (whose member must not be live).
+    void copyFrom(const PointsTo &pt);
+    void moveFrom(PointsTo &&pt);
+
+    /// Returns a copy of this set in representation t under node mapping m.
+    /// Binary operations fall back to this for operands of different layouts,
+    /// e.g. sets created before -ptset was parsed or before a mapping was set.
+    PointsTo convertTo(Type t, const NodeMapping *m) const;
+
+    Type type;
+    /// NULL for the identity mapping
+    const NodeMapping *mapping;
+    union
+    {
+        NodeBS sbv;
+        CoreBitVector cbv;
+        std::vector<NodeID> fsv;
+    };
+
+public:
+    class PointsToIterator
+    {
+        friend class PointsTo;
+    public:
+        PointsToIterator() : type(SBV), mapping(NULL), fsvIt() {}
+
+        const PointsToIterator &operator++();
+        PointsToIterator operator++(int);
+
+        u32_t operator*() const;
+
+        bool operator==(const PointsToIterator &rhs) const;
+        inline bool operator!=(const PointsToIterator &rhs) const
+        {
+            return !(*this == rhs);
+        }
+
+    private:
+        /// Constructs an iterator over pt, pointing to the first element (or the end).
+        PointsToIterator(const PointsTo *pt, bool end);
+
+        Type type;
+        const NodeMapping *mapping;
+        /// Only the iterator matching type is meaningful.
+        //@{
+        NodeBS::iterator sbvIt;
+        CoreBitVector::iterator cbvIt;
+        std::vector<NodeID>::const_iterator fsvIt;
+        //@}
+    };
+};
+
+/// Returns a new set lhs | rhs.
+PointsTo operator|(const PointsTo &lhs, const PointsTo &rhs);
+
+/// Returns a new set lhs & rhs.
+PointsTo operator&(const PointsTo &lhs, const PointsTo &rhs);
+
+/// Returns a new set lhs - rhs.
+PointsTo operator-(const PointsTo &lhs, const PointsTo &rhs);
+
+} // End namespace SVF
+
+template <>
+struct std::hash<SVF::PointsTo>
+{
+    size_t operator()(const SVF::PointsTo &pt) const
+    {
+        return pt.hash();
+    }
+};
+
+#endif /* POINTSTO_H_ */
@@ -33,6 +33,9 @@
  *
  * And influenced by implementation from Open64 compiler
  *
+ * The visit uses an explicit stack instead of recursion and keeps per-node
+ * information in vectors indexed by node ID.
+ *
  *  Created on: Jul 12, 2013
  *      Author: yusui
  */
@@ -43,7 +46,8 @@
 #include "Util/BasicTypes.h"	// for NodeBS
 #include <limits.h>
 #include <stack>
-#include <map>
+#include <vector>
+#include <algorithm>
 
 namespace SVF
 {
@@ -113,12 +117,12 @@ public:
         NodeBS _subNodes; /// nodes in the scc represented by this node
     };
 
-    typedef Map<NodeID,GNodeSCCInfo > GNODESCCInfoMap;
-    typedef Map<NodeID, NodeID> NodeToNodeMap;
+    typedef std::vector<GNodeSCCInfo> GNODESCCInfoVec;
 
     SCCDetection(const GraphType &GT)
         : _graph(GT),
-          _I(0)
+          _I(0),
+          _run(0)
     {}
 
 
@@ -130,17 +134,11 @@ public:
         return _T;
     }
 
-    const inline  GNODESCCInfoMap &GNodeSCCInfo() const
-    {
-        return _NodeSCCAuxInfo;
-    }
-
     /// get the rep node if not found return itself
     inline NodeID repNode(NodeID n) const
     {
-        typename GNODESCCInfoMap::const_iterator it = _NodeSCCAuxInfo.find(n);
-        assert(it!=_NodeSCCAuxInfo.end() && "scc rep not found");
-        NodeID rep = it->second.rep();
+        const GNodeSCCInfo* info = findInfo(n);
+        NodeID rep = info ? info->rep() : UINT_MAX;
         return rep!= UINT_MAX ? rep : n ;
     }
 
@@ -172,9 +170,9 @@ public:
     /// get all subnodes in one scc, if size is empty insert itself into the set
     inline const NodeBS& subNodes(NodeID n)  const
     {
-        typename GNODESCCInfoMap::const_iterator it = _NodeSCCAuxInfo.find(n);
-        assert(it!=_NodeSCCAuxInfo.end() && "scc rep not found");
-        return it->second.subNodes();
+        const GNodeSCCInfo* info = findInfo(n);
+        assert(info && "scc rep not found");
+        return info->subNodes();
     }
 
     /// get all repNodeID
@@ -188,40 +186,87 @@ public:
         return _graph;
     }
 private:
+    /// A node being visited and the next of its children to visit
+    struct VisitFrame
+    {
+        NodeID v;
+        child_iterator it;
+        child_iterator end;
+        VisitFrame(NodeID n, child_iterator b, child_iterator e): v(n), it(b), end(e) {}
+    };
 
-    GNODESCCInfoMap  _NodeSCCAuxInfo;
+    /// Per-node information, indexed by node ID. An entry belongs to the current
+    /// run only if its stamp is the run's number; stale entries are reset when first
+    /// touched, so a run costs the nodes it visits rather than the size of the graph.
+    //@{
+    GNODESCCInfoVec _NodeSCCAuxInfo;
+    std::vector<u32_t> _stamp;
+    std::vector<NodeID> _D;
+    //@}
 
     const GraphType &           _graph;
     NodeID                   _I;
-    NodeToNodeMap            _D;
+    u32_t                    _run;
     GNodeStack             _SS;
     GNodeStack             _T;
+    std::vector<VisitFrame> _visitStack;
     NodeBS repNodes;
 
+    /// Entry of node n in the current run, created/reset if needed
+    inline GNodeSCCInfo& info(NodeID n)
+    {
+        if (n >= _NodeSCCAuxInfo.size())
+        {
+            size_t size = std::max((size_t) n + 1, _NodeSCCAuxInfo.size() * 2);
+            _NodeSCCAuxInfo.resize(size);
+            _stamp.resize(size, 0);
+            _D.resize(size, 0);
+        }
+        GNodeSCCInfo& i = _NodeSCCAuxInfo[n];
+        if (_stamp[n] != _run)
+        {
+            _stamp[n] = _run;
+            i.visited(false);
+            i.inSCC(false);
+            i.rep(UINT_MAX);
+            i.subNodes().clear();
+            _D[n] = 0;
+        }
+        return i;
+    }
+
+    /// Entry of node n if the current run has touched it
+    inline const GNodeSCCInfo* findInfo(NodeID n) const
+    {
+        if (n < _stamp.size() && _stamp[n] == _run)
+            return &_NodeSCCAuxInfo[n];
+        return NULL;
+    }
+
     inline bool visited(NodeID n)
     {
-        return _NodeSCCAuxInfo[n].visited();
+        return info(n).visited();
     }
     inline bool inSCC(NodeID n)
     {
-        return _NodeSCCAuxInfo[n].inSCC();
+        return info(n).inSCC();
     }
 
     inline void setVisited(NodeID n,bool v)
     {
-        _NodeSCCAuxInfo[n].visited(v);
+        info(n).visited(v);
     }
     inline void setInSCC(NodeID n,bool v)
     {
-        _NodeSCCAuxInfo[n].inSCC(v);
+        info(n).inSCC(v);
     }
     inline void rep(NodeID n, NodeID r)
     {
-        _NodeSCCAuxInfo[n].rep(r);
-        _NodeSCCAuxInfo[r].addSubNodes(n);
+        info(n).rep(r);
+        info(r).addSubNodes(n);
         if (n != r)
         {
-            _NodeSCCAuxInfo[n].subNodes().clear();
+            info(n).subNodes().clear();
             repNodes.reset(n);
             repNodes.set(r);
         }
@@ -229,11 +274,11 @@ private:
 
     inline NodeID rep(NodeID n)
     {
-        return _NodeSCCAuxInfo[n].rep();
+        return info(n).rep();
     }
     inline bool isInSCC(NodeID n)
     {
-        return _NodeSCCAuxInfo[n].inSCC();
+        return info(n).inSCC();
     }
 
     inline GNODE Node(NodeID id) const
@@ -246,31 +291,31 @@ private:
         return GTraits::getNodeID(node);
     }
 
-    void visit(NodeID v)
+    /// Start visiting v
+    inline void enter(NodeID v)
     {
-        // SVFUtil::outs() << "visit GNODE: " << Node_Index(v)<< "\n";
-        _I += 1;
-        _D[v] = _I;
         this->rep(v,v);
         this->setVisited(v,true);
+        _I += 1;
+        _D[v] = _I;
+        _visitStack.push_back(VisitFrame(v, GTraits::direct_child_begin(Node(v)), GTraits::direct_child_end(Node(v))));
+    }
 
-        child_iterator EI = GTraits::direct_child_begin(Node(v));
-        child_iterator EE = GTraits::direct_child_end(Node(v));
-
-        for (; EI != EE; ++EI)
+    /// Account for the edge from v to an already visited w
+    inline void visitedChild(NodeID v, NodeID w)
+    {
+        if (!this->inSCC(w))
         {
-            NodeID w = Node_Index(*EI);
-
-            if (!this->visited(w))
-                visit(w);
-            if (!this->inSCC(w))
-            {
-                NodeID rep;
-                rep = _D[this->rep(v)] < _D[this->rep(w)] ?
-                      this->rep(v) : this->rep(w);
-                this->rep(v,rep);
-            }
+            NodeID rep;
+            rep = _D[this->rep(v)] < _D[this->rep(w)] ?
+                  this->rep(v) : this->rep(w);
+            this->rep(v,rep);
         }
+    }
+
+    /// All children of v have been visited
+    inline void leave(NodeID v)
+    {
         if (this->rep(v) == v)
         {
             this->setInSCC(v,true);
@@ -292,11 +337,46 @@ private:
             _SS.push(v);
     }
 
+    /// Depth-first visit from root with an explicit stack, so that deep graphs
+    /// do not overflow the call stack
+    void visit(NodeID root)
+    {
+        enter(root);
+        while (!_visitStack.empty())
+        {
+            VisitFrame& frame = _visitStack.back();
+            if (frame.it != frame.end)
+            {
+                NodeID w = Node_Index(*frame.it);
+                if (!this->visited(w))
+                {
+                    // frame is advanced once w is left
+                    enter(w);
+                    continue;
+                }
+                visitedChild(frame.v, w);
+                ++frame.it;
+            }
+            else
+            {
+                NodeID v = frame.v;
+                _visitStack.pop_back();
+                leave(v);
+                if (!_visitStack.empty())
+                {
+                    VisitFrame& parent = _visitStack.back();
+                    visitedChild(parent.v, v);
+                    ++parent.it;
+                }
+            }
+        }
+    }
+
     void clear()
     {
-        _NodeSCCAuxInfo.clear();
+        // start a new run, entries of previous runs become stale
+        ++_run;
         _I = 0;
-        _D.clear();
         repNodes.clear();
         while(!_SS.empty())
             _SS.pop();
@@ -331,6 +411,10 @@ public:
         }
     }
 
+    /// Incremental mode: only visit what is reachable from the candidates, e.g., the
+    /// endpoints of newly inserted copy edges, which are the only places new cycles can
+    /// close. The cost is that of the visited nodes; the results of other nodes are
+    /// those of a node in no cycle (repNode returns the node itself).
     void find(NodeSet &candidates)
     {
         // This function is reloaded to only visit candidate NODES
@@ -51,6 +51,7 @@ namespace SVF
 typedef unsigned u32_t;
 typedef unsigned long long u64_t;
 typedef signed s32_t;
+typedef signed long long s64_t;
 typedef signed long Size_t;
 
 typedef u32_t NodeID;
@@ -60,7 +61,7 @@ typedef unsigned CallSiteID;
 typedef unsigned ThreadID;
 
 typedef llvm::SparseBitVector<> NodeBS;
-typedef NodeBS PointsTo;
+class PointsTo;
 typedef PointsTo AliasSet;
 
 template <typename Key, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>,
@@ -58,6 +58,9 @@ inline raw_ostream &errs()
 /// Dump sparse bitvector set
 void dumpSet(NodeBS To, raw_ostream & O = SVFUtil::outs());
 
+/// Dump points-to set
+void dumpSet(const PointsTo& To, raw_ostream & O = SVFUtil::outs());
+
 /// Dump points-to set
 void dumpPointsToSet(unsigned node, NodeBS To) ;
 
@@ -90,6 +93,9 @@ void reportMemoryUsageKB(const std::string& infor, raw_ostream & O = SVFUtil::ou
 /// Get memory usage from system file. Return TRUE if succeed.
 bool getMemoryUsageKB(u32_t* vmrss_kb, u32_t* vmsize_kb);
 
+/// Get peak resident memory (VmHWM) from system file. Return TRUE if succeed.
+bool getPeakMemoryUsageKB(u32_t* vmhwm_kb);
+
 /// Increase the stack size limit
 void increaseStackSize();
 
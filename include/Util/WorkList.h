@@ -43,6 +43,9 @@
 #include <vector>
 #include <deque>
 #include <set>
+#include <queue>
+#include <algorithm>
+#include <functional>
 
 namespace SVF
 {
@@ -260,6 +263,363 @@ private:
     DataVector data_list;	///< work list using std::vector.
 };
 
+/**
+ * Membership of node IDs, one bit per ID.
+ * Cheaper than a Set for the dense IDs of graph nodes.
+ */
+class DenseNodeSet
+{
+public:
+    inline bool test(NodeID id) const
+    {
+        return id < bits.size() && bits[id];
+    }
+    inline void set(NodeID id)
+    {
+        if (id >= bits.size())
+            bits.resize(std::max<size_t>(id + 1, 2 * bits.size()), false);
+        bits[id] = true;
+    }
+    inline void reset(NodeID id)
+    {
+        if (id < bits.size())
+            bits[id] = false;
+    }
+    inline void clear()
+    {
+        bits.clear();
+    }
+
+private:
+    std::vector<bool> bits;
+};
+
+/**
+ * Worklist of node IDs with "first in first out" order.
+ * Same as FIFOWorkList<NodeID>, but elements are recorded by a bitmap.
+ */
+class DenseFIFOWorkList
+{
+public:
+    inline bool empty() const
+    {
+        return data_list.empty();
+    }
+
+    inline bool find(NodeID id) const
+    {
+        return in_list.test(id);
+    }
+
+    inline bool push(NodeID id)
+    {
+        if (in_list.test(id))
+            return false;
+        in_list.set(id);
+        data_list.push_back(id);
+        return true;
+    }
+
+    inline NodeID pop()
+    {
+        assert(!empty() && "work list is empty");
+        NodeID id = data_list.front();
+        data_list.pop_front();
+        in_list.reset(id);
+        return id;
+    }
+
+    inline void clear()
+    {
+        data_list.clear();
+        in_list.clear();
+    }
+
+private:
+    DenseNodeSet in_list;	///< nodes in the work list.
+    std::deque<NodeID> data_list;	///< work list.
+};
+
+/**
+ * Worklist of node IDs with "least recently fired" order.
+ * The node popped first is the one that was popped (fired) longest ago,
+ * nodes never popped come first in the order they were pushed.
+ */
+class LRFWorkList
+{
+    struct Entry
+    {
+        u32_t fired;	///< last time the node was popped, 0 for never
+        u32_t seq;	///< push order, to break ties
+        NodeID id;
+        Entry(u32_t f, u32_t s, NodeID i) : fired(f), seq(s), id(i) {}
+        inline bool operator>(const Entry& rhs) const
+        {
+            return fired != rhs.fired ? fired > rhs.fired : seq > rhs.seq;
+        }
+    };
+    typedef std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry> > EntryQueue;
+
+public:
+    LRFWorkList() : numOfFires(0), numOfPushes(0) {}
+
+    inline bool empty() const
+    {
+        return queue.empty();
+    }
+
+    inline bool find(NodeID id) const
+    {
+        return in_list.test(id);
+    }
+
+    /// The priority of a node does not change while it is in the list,
+    /// since it only changes when the node is popped.
+    inline bool push(NodeID id)
+    {
+        if (in_list.test(id))
+            return false;
+        in_list.set(id);
+        queue.push(Entry(id < lastFired.size() ? lastFired[id] : 0, ++numOfPushes, id));
+        return true;
+    }
+
+    inline NodeID pop()
+    {
+        assert(!empty() && "work list is empty");
+        NodeID id = queue.top().id;
+        queue.pop();
+        in_list.reset(id);
+        if (id >= lastFired.size())
+            lastFired.resize(std::max<size_t>(id + 1, 2 * lastFired.size()), 0);
+        lastFired[id] = ++numOfFires;
+        return id;
+    }
+
+    /// Empty the list, the firing history is kept
+    inline void clear()
+    {
+        queue = EntryQueue();
+        in_list.clear();
+    }
+
+private:
+    EntryQueue queue;
+    DenseNodeSet in_list;
+    std::vector<u32_t> lastFired;
+    u32_t numOfFires;
+    u32_t numOfPushes;
+};
+
+/**
+ * Two-phase worklist of node IDs in topological order.
+ * Nodes are popped in the order of their ranks (see setRank) from the current
+ * phase; nodes pushed meanwhile wait for the next phase, which starts once the
+ * current one is empty. Nodes without a rank come last, ordered by ID.
+ */
+class TopoWorkList
+{
+    typedef std::pair<u32_t, NodeID> Entry;	///< (rank, node)
+    typedef std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry> > EntryQueue;
+
+public:
+    static const u32_t NoRank = ~0U;
+
+    inline bool empty() const
+    {
+        return current.empty() && next.empty();
+    }
+
+    inline bool find(NodeID id) const
+    {
+        return in_list.test(id);
+    }
+
+    inline bool push(NodeID id)
+    {
+        if (in_list.test(id))
+            return false;
+        in_list.set(id);
+        next.push_back(id);
+        return true;
+    }
+
+    inline NodeID pop()
+    {
+        assert(!empty() && "work list is empty");
+        if (current.empty())
+        {
+            for (std::vector<NodeID>::const_iterator it = next.begin(), eit = next.end(); it != eit; ++it)
+                current.push(Entry(getRank(*it), *it));
+            next.clear();
+        }
+        NodeID id = current.top().second;
+        current.pop();
+        in_list.reset(id);
+        return id;
+    }
+
+    inline void clear()
+    {
+        current = EntryQueue();
+        next.clear();
+        in_list.clear();
+    }
+
+    /// Rank of a node, lower ranks are popped first
+    //@{
+    inline void setRank(NodeID id, u32_t rank)
+    {
+        if (id >= ranks.size())
+            ranks.resize(std::max<size_t>(id + 1, 2 * ranks.size()), NoRank);
+        ranks[id] = rank;
+    }
+    inline u32_t getRank(NodeID id) const
+    {
+        return id < ranks.size() ? ranks[id] : NoRank;
+    }
+    //@}
+
+private:
+    EntryQueue current;	///< nodes of the current phase
+    std::vector<NodeID> next;	///< nodes of the next phase
+    DenseNodeSet in_list;
+    std::vector<u32_t> ranks;
+};
+
+/**
+ * Worklist of node IDs used by the solvers (WPASolver), with a strategy chosen
+ * at construction time. The default strategy is given by -worklist.
+ */
+class NodeWorkList
+{
+public:
+    enum Strategy
+    {
+        FIFO,	///< FIFOWorkList<NodeID>
+        DenseFIFO,	///< DenseFIFOWorkList
+        LRF,	///< LRFWorkList
+        Topo	///< TopoWorkList
+    };
+
+    NodeWorkList(Strategy s = getDefaultStrategy()) : strategy(s), numOfPops(0) {}
+
+    inline Strategy getStrategy() const
+    {
+        return strategy;
+    }
+
+    /// Change the strategy, the list must be empty
+    inline void setStrategy(Strategy s)
+    {
+        assert(empty() && "changing the strategy of a non-empty work list");
+        strategy = s;
+    }
+
+    inline bool empty() const
+    {
+        switch (strategy)
+        {
+        case DenseFIFO:
+            return denseFifo.empty();
+        case LRF:
+            return lrf.empty();
+        case Topo:
+            return topo.empty();
+        default:
+            return fifo.empty();
+        }
+    }
+
+    inline bool find(NodeID id) const
+    {
+        switch (strategy)
+        {
+        case DenseFIFO:
+            return denseFifo.find(id);
+        case LRF:
+            return lrf.find(id);
+        case Topo:
+            return topo.find(id);
+        default:
+            return fifo.find(id);
+        }
+    }
+
+    inline bool push(NodeID id)
+    {
+        switch (strategy)
+        {
+        case DenseFIFO:
+            return denseFifo.push(id);
+        case LRF:
+            return lrf.push(id);
+        case Topo:
+            return topo.push(id);
+        default:
+            return fifo.push(id);
+        }
+    }
+
+    inline NodeID pop()
+    {
+        numOfPops++;
+        switch (strategy)
+        {
+        case DenseFIFO:
+            return denseFifo.pop();
+        case LRF:
+            return lrf.pop();
+        case Topo:
+            return topo.pop();
+        default:
+            return fifo.pop();
+        }
+    }
+
+    inline void clear()
+    {
+        fifo.clear();
+        denseFifo.clear();
+        lrf.clear();
+        topo.clear();
+    }
+
+    /// Whether the strategy orders nodes by the ranks given by setRank
+    inline bool isRanked() const
+    {
+        return strategy == Topo;
+    }
+
+    /// Topological rank of a node, only used by ranked strategies
+    inline void setRank(NodeID id, u32_t rank)
+    {
+        if (isRanked())
+            topo.setRank(id, rank);
+    }
+
+    /// Number of nodes popped so far
+    inline u64_t getNumOfPops() const
+    {
+        return numOfPops;
+    }
+
+    /// Strategy of the lists constructed without an explicit one (-worklist)
+    //@{
+    static Strategy getDefaultStrategy();
+    static void setDefaultStrategy(Strategy s);
+    static const char* getStrategyName(Strategy s);
+    //@}
+
+private:
+    Strategy strategy;
+    FIFOWorkList<NodeID> fifo;
+    DenseFIFOWorkList denseFifo;
+    LRFWorkList lrf;
+    TopoWorkList topo;
+    u64_t numOfPops;
+};
+
 } // End namespace SVF
 
 #endif /* WORKLIST_H_ */
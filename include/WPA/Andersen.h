@@ -36,6 +36,7 @@
 #include "Graphs/PAG.h"
 #include "Graphs/ConsG.h"
 #include "Graphs/OfflineConsG.h"
+#include "WPA/CycleDetector.h"
 
 namespace SVF
 {
@@ -120,7 +121,7 @@ protected:
  */
 class Andersen:  public AndersenBase
 {
-
+    friend class CycleDetector;
 
 public:
     typedef SCCDetection<ConstraintGraph*> CGSCC;
@@ -145,18 +146,27 @@ public:
     static double timeOfProcessCopyGep;
     static double timeOfProcessLoadStore;
     static double timeOfUpdateCallGraph;
+    static u32_t numOfIncChangedFuns;       ///< Functions changed since the incremental database
+    static u32_t numOfIncInvalidatedNodes;  ///< Saved points-to sets invalidated by the changes
+    static u32_t numOfIncSeededNodes;       ///< Saved points-to sets reused
+    static u32_t numOfVarSubstNodes;        ///< Constraint nodes merged by variable substitution
+    static u32_t numOfVarSubstEdges;        ///< Constraint edges removed by variable substitution
+    static double timeOfVarSubst;
     //@}
 
     /// Constructor
     Andersen(PAG* _pag, PTATY type = Andersen_WPA, bool alias_check = true)
-        :  AndersenBase(_pag, type, alias_check), pwcOpt(false), diffOpt(true)
+        :  AndersenBase(_pag, type, alias_check), pwcOpt(false), diffOpt(true),
+           cycleDetection(CycleDetector::getDefaultKind()), cycleDetector(NULL),
+           nodeMapping(NULL), varSubst(getDefaultVarSubstitution())
     {
     }
 
     /// Destructor
     virtual ~Andersen()
     {
-
+        delete cycleDetector;
+        cycleDetector = NULL;
     }
 
     /// Andersen analysis
@@ -216,12 +226,14 @@ public:
     virtual inline bool unionPts(NodeID id, const PointsTo& target)
     {
         id = sccRepNode(id);
+        clearAliasCache();
         return getPTDataTy()->unionPts(id, target);
     }
     virtual inline bool unionPts(NodeID id, NodeID ptd)
     {
         id = sccRepNode(id);
         ptd = sccRepNode(ptd);
+        clearAliasCache();
         return getPTDataTy()->unionPts(id,ptd);
     }
 
@@ -252,13 +264,62 @@ public:
         return diffOpt;
     }
 
+    /// Online cycle detection policy (-cycle-detection by default), to be set before analyze()
+    //@{
+    inline void setCycleDetection(CycleDetector::Kind kind)
+    {
+        cycleDetection = kind;
+    }
+    inline CycleDetector::Kind getCycleDetection() const
+    {
+        return cycleDetection;
+    }
+    //@}
+
+    /// Offline variable substitution before solving (-ander-var-subst by default), to be set before analyze()
+    //@{
+    inline void setVarSubstitution(bool flag)
+    {
+        varSubst = flag;
+    }
+    inline bool getVarSubstitution() const
+    {
+        return varSubst;
+    }
+    static bool getDefaultVarSubstitution();
+    /// Nodes merged into the rep of their value number, which are not in any cycle
+    inline const NodeBS& getVarSubstNodes() const
+    {
+        return varSubstNodes;
+    }
+    //@}
+
 protected:
 
+    /// Renumber objects inside points-to sets using an auxiliary Andersen's analysis
+    void cluster();
+
+    /// Incremental re-analysis from the database of a previous run (-ander-inc-db)
+    //@{
+    void recordInitialFIObjs();
+    bool seedFromIncrementalDB(const std::string& filename);
+    void writeIncrementalDB(const std::string& filename);
+    NodeBS initialFIObjs;   ///< objects field-insensitive before solving
+    //@}
+
     CallSite2DummyValPN callsite2DummyValPN;        ///< Map an instruction to a dummy obj which created at an indirect callsite, which invokes a heap allocator
     void heapAllocatorViaIndCall(CallSite cs,NodePairSet &cpySrcNodes);
 
     bool pwcOpt;
     bool diffOpt;
+    CycleDetector::Kind cycleDetection;
+    CycleDetector* cycleDetector;	///< created in initialize()
+    const PointsTo::NodeMapping* nodeMapping;	///< of the points-to sets of this analysis (cluster()), NULL for none
+    bool varSubst;
+    NodeBS varSubstNodes;   ///< nodes merged by variable substitution
+
+    /// Merge pointer equivalent nodes found by hash-based value numbering
+    void substituteVariables();
 
     /// Handle diff points-to set.
     virtual inline void computeDiffPts(NodeID id)
@@ -303,9 +364,18 @@ protected:
         ConstraintNode::sccEdgeFlag = f;
     }
 
+    /// Worklist solver of WPASolver, calling back the cycle detector
+    virtual void solveWorklist();
+
     /// Override WPASolver function in order to use the default solver
     virtual void processNode(NodeID nodeId);
 
+    /// The cycle detector merged nodes into rep, whose points-to set may have changed
+    virtual inline void pushMergedRep(NodeID rep)
+    {
+        pushIntoWorklist(rep);
+    }
+
     /// handling various constraints
     //@{
     void processAllAddr();
@@ -378,14 +448,16 @@ protected:
         {
             const PointsTo& pts = getPts(it->first);
             NodeBS fldInsenObjs;
-            for(NodeBS::iterator pit = pts.begin(), epit = pts.end(); pit!=epit; ++pit)
+            for(PointsTo::iterator pit = pts.begin(), epit = pts.end(); pit!=epit; ++pit)
             {
                 if(isFieldInsensitive(*pit))
                     fldInsenObjs.set(*pit);
             }
             for(NodeBS::iterator pit = fldInsenObjs.begin(), epit = fldInsenObjs.end(); pit!=epit; ++pit)
             {
-                unionPts(it->first,consCG->getAllFieldsObjNode(*pit));
+                PointsTo fldPts;
+                fldPts |= consCG->getAllFieldsObjNode(*pit);
+                unionPts(it->first,fldPts);
             }
         }
     }
@@ -452,11 +524,29 @@ public:
 protected:
     virtual void mergeNodeToRep(NodeID nodeId,NodeID newRepId);
 
+    /// Copies are only propagated in topological order at the start of each
+    /// round, so a rep merged afterwards needs another round
+    virtual inline void pushMergedRep(NodeID rep)
+    {
+        pushIntoWorklist(rep);
+        reanalyze = true;
+    }
+
     /// process "bitcast" CopyCGEdge
     virtual void processCast(const ConstraintEdge*)
     {
         return;
     }
+
+    /// Multi-threaded wave propagation (-wave-threads).
+    /// SCC detection/merging and graph mutations stay serial, points-to propagation over
+    /// each topological level and the load/store scan are shared among worker threads.
+    //@{
+    virtual void solveWorklistInParallel(u32_t numOfThreads);
+    void computeWaveLevels(NodeStack& nodeStack, std::vector<NodeVector>& levels);
+    void processLevelInParallel(const NodeVector& level, u32_t numOfThreads);
+    void postProcessNodesInParallel(const NodeVector& nodes, u32_t numOfThreads);
+    //@}
 };
 
 
@@ -509,6 +599,8 @@ public:
     AndersenWaveDiffWithType(PAG* _pag, PTATY type = AndersenWaveDiffWithType_WPA): AndersenWaveDiff(_pag,type)
     {
         assert(getTypeSystem()!=NULL && "a type system is required for this pointer analysis");
+        /// pointers of different types filter the same objects differently
+        setVarSubstitution(false);
     }
 
     /// Create an singleton instance directly instead of invoking llvm pass manager
@@ -551,18 +643,17 @@ protected:
 /*
  * Lazy Cycle Detection Based Andersen Analysis
  */
-class AndersenLCD : virtual public Andersen
+class AndersenLCD : public Andersen
 {
 
 private:
     static AndersenLCD* lcdAndersen;
-    EdgeSet metEdges;
-    NodeSet lcdCandidates;
 
 public:
     AndersenLCD(PAG* _pag, PTATY type = AndersenLCD_WPA) :
-        Andersen(_pag, type), metEdges({}), lcdCandidates( {})
+        Andersen(_pag, type)
     {
+        setCycleDetection(CycleDetector::Lazy);
     }
 
     /// Create an singleton instance directly instead of invoking llvm pass manager
@@ -583,46 +674,6 @@ public:
             delete lcdAndersen;
         lcdAndersen = nullptr;
     }
-
-protected:
-    // 'lcdCandidates' is used to collect nodes need to be visited by SCC detector
-    //@{
-    inline bool hasLCDCandidate () const
-    {
-        return !lcdCandidates.empty();
-    };
-    inline void cleanLCDCandidate()
-    {
-        lcdCandidates.clear();
-    };
-    inline void addLCDCandidate(NodeID nodeId)
-    {
-        lcdCandidates.insert(nodeId);
-    };
-    //@}
-
-    // 'metEdges' is used to collect edges met by AndersenLCD, to avoid redundant visit
-    //@{
-    bool isMetEdge (ConstraintEdge* edge) const
-    {
-        EdgeSet::const_iterator it = metEdges.find(edge->getEdgeID());
-        return it != metEdges.end();
-    };
-    void addMetEdge(ConstraintEdge* edge)
-    {
-        metEdges.insert(edge->getEdgeID());
-    };
-    //@}
-
-    //AndersenLCD worklist processer
-    void solveWorklist();
-    // Solve constraints of each nodes
-    virtual void handleCopyGep(ConstraintNode* node);
-    // Collapse nodes and fields based on 'lcdCandidates'
-    virtual void mergeSCC();
-    // AndersenLCD specified SCC detector, need to input a nodeStack 'lcdCandidate'
-    NodeStack& SCCDetect();
-    bool mergeSrcToTgt(NodeID nodeId, NodeID newRepId);
 };
 
 
@@ -630,21 +681,17 @@ protected:
 /*!
  * Hybrid Cycle Detection Based Andersen Analysis
  */
-class AndersenHCD : virtual public Andersen
+class AndersenHCD : public Andersen
 {
 
-public:
-    typedef SCCDetection<OfflineConsG*> OSCC;
-
 private:
     static AndersenHCD* hcdAndersen;
-    NodeSet mergedNodes;
-    OfflineConsG* oCG;
 
 public:
     AndersenHCD(PAG* _pag, PTATY type = AndersenHCD_WPA) :
-        Andersen(_pag, type), oCG(NULL)
+        Andersen(_pag, type)
     {
+        setCycleDetection(CycleDetector::Hybrid);
     }
 
     /// Create an singleton instance directly instead of invoking llvm pass manager
@@ -665,40 +712,6 @@ public:
             delete hcdAndersen;
         hcdAndersen = nullptr;
     }
-
-protected:
-    virtual void initialize();
-
-    // Get offline rep node from offline constraint graph
-    //@{
-    inline bool hasOfflineRep(NodeID nodeId) const
-    {
-        return oCG->hasOCGRep(nodeId);
-    }
-    inline NodeID getOfflineRep(NodeID nodeId)
-    {
-        return oCG->getOCGRep(nodeId);
-    }
-    //@}
-
-    // The set 'mergedNodes' is used to record the merged node, therefore avoiding re-merge nodes
-    //@{
-    inline bool isaMergedNode(NodeID node) const
-    {
-        NodeSet::const_iterator it = mergedNodes.find(node);
-        return it != mergedNodes.end();
-    };
-    inline void setMergedNode(NodeID node)
-    {
-        if (!isaMergedNode(node))
-            mergedNodes.insert(node);
-    };
-    //@}
-
-    virtual void solveWorklist();
-    virtual void mergeSCC(NodeID nodeId);
-    void mergeNodeAndPts(NodeID node, NodeID tgt);
-
 };
 
 
@@ -706,7 +719,7 @@ protected:
 /*!
  * Hybrid Lazy Cycle Detection Based Andersen Analysis
  */
-class AndersenHLCD : public AndersenHCD, public AndersenLCD
+class AndersenHLCD : public Andersen
 {
 
 private:
@@ -714,8 +727,9 @@ private:
 
 public:
     AndersenHLCD(PAG* _pag, PTATY type = AndersenHLCD_WPA) :
-        Andersen(_pag, type), AndersenHCD(_pag, type), AndersenLCD(_pag, type)
+        Andersen(_pag, type)
     {
+        setCycleDetection(CycleDetector::HybridLazy);
     }
 
     /// Create an singleton instance directly instead of invoking llvm pass manager
@@ -736,26 +750,6 @@ public:
             delete hlcdAndersen;
         hlcdAndersen = nullptr;
     }
-
-protected:
-    void initialize()
-    {
-        AndersenHCD::initialize();
-    }
-    void solveWorklist()
-    {
-        AndersenHCD::solveWorklist();
-    }
-    void handleCopyGep(ConstraintNode* node)
-    {
-        AndersenLCD::handleCopyGep(node);
-    }
-    void mergeSCC(NodeID nodeId);
-    bool mergeSrcToTgt(NodeID nodeId, NodeID newRepId)
-    {
-        return AndersenLCD::mergeSrcToTgt(nodeId, newRepId);
-    }
-
 };
 
 } // End namespace SVF
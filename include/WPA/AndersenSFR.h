@@ -54,6 +54,8 @@ public:
     AndersenSCD(PAG* _pag, PTATY type = AndersenSCD_WPA) :
         Andersen(_pag,type)
     {
+        /// cycles are detected selectively from the ends of new copy edges
+        setCycleDetection(CycleDetector::None);
     }
 
     /// Create an singleton instance directly instead of invoking llvm pass manager
@@ -116,6 +118,8 @@ public:
     AndersenSFR(PAG* _pag, PTATY type = AndersenSFR_WPA) :
         AndersenSCD(_pag, type), csc(NULL)
     {
+        /// strides of gep edges depend on the cycles they are in
+        setVarSubstitution(false);
     }
 
     /// Create an singleton instance directly instead of invoking llvm pass manager
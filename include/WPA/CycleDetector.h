@@ -0,0 +1,173 @@
+//===- CycleDetector.h -- Online cycle detection policies of Andersen's -----//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * CycleDetector.h
+ *
+ * Cycle detection performed by Andersen's analysis while solving, in addition
+ * to the SCC detection of its propagation strategy (e.g., the whole-graph
+ * detection of each wave in AndersenWaveDiff). A policy is plugged into any
+ * Andersen variant (-cycle-detection) and called back at three points:
+ *
+ *  - beforeProcessCopy: a points-to set is about to be propagated along a copy edge
+ *  - mergeDetectedCycles: before a node is popped from the worklist, when no
+ *    result of the SCC detector is being iterated
+ *  - beforeProcessNode: a node popped from the worklist is about to be processed
+ *
+ * The policies are
+ *  - lazy (LCD): a copy edge whose source and destination already have equal
+ *    points-to sets hints at a cycle, SCC detection is later run from such nodes only
+ *  - hybrid (HCD): cycles through dereferenced pointers are found offline; before
+ *    a node is processed, the targets it points to are merged with the offline rep
+ *  - hybrid-lazy (HLCD): both of the above
+ */
+
+#ifndef CYCLEDETECTOR_H_
+#define CYCLEDETECTOR_H_
+
+#include "Graphs/ConsG.h"
+
+namespace SVF
+{
+
+class Andersen;
+class OfflineConsG;
+
+/*!
+ * Base cycle detection policy, which does nothing
+ */
+class CycleDetector
+{
+public:
+    enum Kind
+    {
+        None, Lazy, Hybrid, HybridLazy
+    };
+
+    /// Constructor
+    CycleDetector(Andersen* a, Kind k = None) : ander(a), kind(k)
+    {
+    }
+    /// Destructor
+    virtual ~CycleDetector()
+    {
+    }
+
+    /// Create the policy of a kind
+    static CycleDetector* create(Kind kind, Andersen* ander);
+
+    /// Kind of the policies of analyses not choosing one themselves (-cycle-detection)
+    static Kind getDefaultKind();
+    static const char* getKindName(Kind kind);
+
+    inline Kind getKind() const
+    {
+        return kind;
+    }
+
+    /// Called once the constraint graph is built
+    virtual void initialize() {}
+
+    /// Call backs during solving
+    //@{
+    virtual void beforeProcessCopy(NodeID, const ConstraintEdge*) {}
+    virtual void mergeDetectedCycles() {}
+    virtual void beforeProcessNode(NodeID) {}
+    //@}
+
+protected:
+    /// Operations on the analysis shared by the policies
+    //@{
+    /// Run SCC detection from candidates only and merge the cycles found
+    void detectAndMergeCycles(const NodeSet& candidates);
+    /// Merge node and its points-to set into rep
+    void mergeNodeAndPts(NodeID node, NodeID rep);
+    //@}
+
+    Andersen* ander;
+    Kind kind;
+};
+
+/*!
+ * Lazy cycle detection
+ */
+class LazyCycleDetector : public CycleDetector
+{
+public:
+    LazyCycleDetector(Andersen* a) : CycleDetector(a, Lazy)
+    {
+    }
+
+    virtual void beforeProcessCopy(NodeID src, const ConstraintEdge* edge);
+    virtual void mergeDetectedCycles();
+
+private:
+    EdgeSet metEdges;	///< copy edges already checked, each edge triggers a detection once
+    NodeSet candidates;	///< nodes to start the next SCC detection from
+};
+
+/*!
+ * Hybrid cycle detection
+ */
+class HybridCycleDetector : public CycleDetector
+{
+public:
+    HybridCycleDetector(Andersen* a, Kind k = Hybrid) : CycleDetector(a, k), oCG(NULL)
+    {
+    }
+    virtual ~HybridCycleDetector();
+
+    /// Build the offline constraint graph and find its cycles
+    virtual void initialize();
+    virtual void beforeProcessNode(NodeID nodeId);
+
+private:
+    OfflineConsG* oCG;
+    NodeSet mergedNodes;	///< nodes already merged into an offline rep
+};
+
+/*!
+ * Hybrid and lazy cycle detection
+ */
+class HybridLazyCycleDetector : public HybridCycleDetector
+{
+public:
+    HybridLazyCycleDetector(Andersen* a) : HybridCycleDetector(a, HybridLazy), lazy(a)
+    {
+    }
+
+    virtual void beforeProcessCopy(NodeID src, const ConstraintEdge* edge)
+    {
+        lazy.beforeProcessCopy(src, edge);
+    }
+    virtual void mergeDetectedCycles()
+    {
+        lazy.mergeDetectedCycles();
+    }
+
+private:
+    LazyCycleDetector lazy;
+};
+
+} // End namespace SVF
+
+#endif /* CYCLEDETECTOR_H_ */
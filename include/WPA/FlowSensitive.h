@@ -59,6 +59,7 @@ public:
     FlowSensitive(PAG* _pag, PTATY type = FSSPARSE_WPA) : WPASVFGFSSolver(), BVDataPTAImpl(_pag, type)
     {
         svfg = NULL;
+        nodeMapping = NULL;
         solveTime = sccTime = processTime = propagationTime = updateTime = 0;
         addrTime = copyTime = gepTime = loadTime = storeTime = phiTime = 0;
         updateCallGraphTime = directPropaTime = indirectPropaTime = 0;
@@ -126,7 +127,7 @@ public:
     }
     static inline bool classof(const PointerAnalysis *pta)
     {
-        return pta->getAnalysisTy() == FSSPARSE_WPA;
+        return pta->getAnalysisTy() == FSSPARSE_WPA || pta->getAnalysisTy() == VFS_WPA;
     }
     //@}
 
@@ -246,13 +247,14 @@ protected:
     virtual void countAliases(Set<std::pair<NodeID, NodeID>> cmp, unsigned *mayAliases, unsigned *noAliases);
 
     SVFG* svfg;
+    const PointsTo::NodeMapping* nodeMapping;  ///< of the points-to sets solved here (-cluster-fs), NULL for none
     ///Get points-to set for a node from data flow IN/OUT set at a statement.
     //@{
-    inline const PointsTo& getDFInPtsSet(const SVFGNode* stmt, const NodeID node)
+    virtual inline const PointsTo& getDFInPtsSet(const SVFGNode* stmt, const NodeID node)
     {
         return getDFPTDataTy()->getDFInPtsSet(stmt->getId(),node);
     }
-    inline const PointsTo& getDFOutPtsSet(const SVFGNode* stmt, const NodeID node)
+    virtual inline const PointsTo& getDFOutPtsSet(const SVFGNode* stmt, const NodeID node)
     {
         return getDFPTDataTy()->getDFOutPtsSet(stmt->getId(),node);
     }
@@ -0,0 +1,196 @@
+//===- VersionedFlowSensitive.h -- Versioned flow-sensitive pointer analysis---//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * VersionedFlowSensitive.h
+ *
+ * Sparse flow-sensitive analysis keeping one points-to set per version of an
+ * address-taken object instead of an IN and an OUT set per SVFG node.
+ *
+ * Before solving, every SVFG node is given, for each object flowing into it, the
+ * version it consumes, and stores the version they yield (meld labelling):
+ *  - a store yields a fresh version of each object it may define;
+ *  - a formal-in/actual-out node which may gain incoming edges through indirect
+ *    calls consumes a fresh version, so that new edges cannot affect other nodes;
+ *  - any other node consumes the meld of the versions yielded by its predecessors
+ *    and yields what it consumes.
+ * Nodes reached by the same definitions thus share a version and a points-to set.
+ * While solving, a change to a version is pushed to the versions relying on it and
+ * to the loads and stores consuming them, rather than along every SVFG edge.
+ */
+
+#ifndef VERSIONEDFLOWSENSITIVE_H_
+#define VERSIONEDFLOWSENSITIVE_H_
+
+#include "WPA/FlowSensitive.h"
+
+namespace SVF
+{
+
+/*!
+ * Versioned sparse flow-sensitive whole program pointer analysis
+ */
+class VersionedFlowSensitive : public FlowSensitive
+{
+    friend class FlowSensitiveStat;
+
+public:
+    /// Version of an object, 0 meaning no version
+    typedef u32_t Version;
+    typedef Map<NodeID, Version> ObjToVersionMap;
+    typedef Map<Version, PointsTo> VersionToPtsMap;
+    typedef Map<Version, Set<Version> > VersionRelianceMap;
+    typedef Map<Version, NodeBS> VersionToStmtsMap;
+
+    /// Constructor
+    VersionedFlowSensitive(PAG* _pag, PTATY type = VFS_WPA);
+
+    /// Destructor
+    virtual ~VersionedFlowSensitive() { }
+
+    /// Initialize analysis
+    virtual void initialize();
+
+    /// Get PTA name
+    virtual const std::string PTAName() const
+    {
+        return "VersionedFlowSensitive";
+    }
+
+    /// Methods for support type inquiry through isa, cast, and dyn_cast
+    //@{
+    static inline bool classof(const VersionedFlowSensitive *)
+    {
+        return true;
+    }
+    static inline bool classof(const PointerAnalysis *pta)
+    {
+        return pta->getAnalysisTy() == VFS_WPA;
+    }
+    //@}
+
+protected:
+    /// Versions are propagated by processStore, not along indirect edges
+    virtual bool propAlongIndirectEdge(const IndirectSVFGEdge*)
+    {
+        return false;
+    }
+
+    /// Handle various constraints
+    //@{
+    virtual void processNode(NodeID nodeId);
+    virtual bool processLoad(const LoadSVFGNode* load);
+    virtual bool processStore(const StoreSVFGNode* store);
+    //@}
+
+    /// Add the version reliances of the indirect edges connected at new call edges
+    virtual void updateConnectedNodes(const SVFG::SVFGEdgeSetTy& edges);
+
+    /// Points-to set of var consumed (IN) or yielded (OUT) at stmt
+    //@{
+    virtual const PointsTo& getDFInPtsSet(const SVFGNode* stmt, const NodeID node);
+    virtual const PointsTo& getDFOutPtsSet(const SVFGNode* stmt, const NodeID node);
+    //@}
+
+private:
+    /// Meld labelling
+    //@{
+    /// Compute the consumed and yielded version of every object at every node
+    void meldLabel();
+    /// Whether node may gain incoming indirect edges when the call graph is updated
+    bool isDelta(const SVFGNode* node) const;
+    /// Objects propagated along an indirect edge, including the fields of field-insensitive objects
+    void getEdgeObjs(const IndirectSVFGEdge* edge, NodeBS& objs);
+    /// Version standing for a set of labels
+    Version getVersion(const NodeBS& labels);
+    /// Record the version reliances and the statements consuming each version
+    void buildReliance();
+    //@}
+
+    /// Versions consumed/yielded by a node (yield is consume except at stores)
+    //@{
+    inline Version getConsume(NodeID loc, NodeID obj) const
+    {
+        if (loc >= consume.size())
+            return 0;
+        ObjToVersionMap::const_iterator it = consume[loc].find(obj);
+        return it == consume[loc].end() ? 0 : it->second;
+    }
+    inline Version getYield(NodeID loc, NodeID obj) const
+    {
+        if (loc < yield.size())
+        {
+            ObjToVersionMap::const_iterator it = yield[loc].find(obj);
+            if (it != yield[loc].end())
+                return it->second;
+        }
+        return getConsume(loc, obj);
+    }
+    //@}
+
+    /// Versioned points-to sets
+    //@{
+    inline const PointsTo& getVersionPts(NodeID obj, Version v)
+    {
+        return versionPts[obj][v];
+    }
+    inline bool unionVersionPts(NodeID obj, Version v, const PointsTo& pts)
+    {
+        return versionPts[obj][v] |= pts;
+    }
+    /// Push the points-to set of (obj, v) to the versions relying on it and push
+    /// the statements consuming the changed versions into the worklist
+    void propagateVersion(NodeID obj, Version v);
+    /// Add a reliance of (obj, to) on (obj, from), returns whether it is new
+    bool addVersionReliance(NodeID obj, Version from, Version to);
+    //@}
+
+    std::vector<ObjToVersionMap> consume;	///< SVFG node ID -> object -> consumed version
+    std::vector<ObjToVersionMap> yield;	///< store node ID -> object -> yielded version
+    Map<NodeID, VersionToPtsMap> versionPts;	///< object -> version -> points-to set
+    Map<NodeID, VersionRelianceMap> versionReliance;	///< object -> version -> versions relying on it
+    Map<NodeID, VersionToStmtsMap> stmtReliance;	///< object -> version -> loads/stores consuming it
+
+    /// Label sets of versions, only kept during meld labelling
+    //@{
+    struct LabelsHash
+    {
+        size_t operator()(const NodeBS& labels) const;
+    };
+    std::vector<NodeBS> versionLabels;
+    Map<NodeBS, Version, LabelsHash> labelsToVersion;
+    //@}
+
+    /// Statistics
+    //@{
+    u32_t numOfVersions;	///< versions created
+    u32_t numOfPrelabels;	///< fresh versions at stores and delta nodes
+    u32_t numOfVersionReliances;	///< reliances between versions
+    double meldLabelTime;	///< time of meld labelling
+    double relianceTime;	///< time of building the reliances
+    double versionPropTime;	///< time of propagating versions
+    //@}
+};
+
+} // End namespace SVF
+
+#endif /* VERSIONEDFLOWSENSITIVE_H_ */
@@ -86,11 +86,13 @@ protected:
 
         assert(nodeStack.empty() && "node stack is not empty, some nodes are not popped properly.");
 
-        /// restore the topological order.
+        /// restore the topological order, ranking nodes for ranked worklists.
+        u32_t rank = revTopoStack.size();
         while (!revTopoStack.empty())
         {
             NodeID nodeId = revTopoStack.top();
             revTopoStack.pop();
+            this->worklist.setRank(nodeId, --rank);
             nodeStack.push(nodeId);
         }
 
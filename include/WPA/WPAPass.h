@@ -101,6 +101,9 @@ public:
     /// Print all alias pairs
     virtual void PrintAliasPairs(PointerAnalysis* pta);
 
+    /// Print the statistics of the alias query cache
+    void printAliasCacheStat(PointerAnalysis* pta);
+
     /// Interface of mod-ref analysis to determine whether a CallSite instruction can mod or ref any memory location
     virtual ModRefInfo getModRefInfo(const CallInst* callInst);
 
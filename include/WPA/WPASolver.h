@@ -52,7 +52,7 @@ public:
 
     typedef SCCDetection<GraphType> SCC;
 
-    typedef FIFOWorkList<NodeID> WorkList;
+    typedef NodeWorkList WorkList;
 
 protected:
 
@@ -123,10 +123,12 @@ protected:
     virtual inline void initWorklist()
     {
         NodeStack& nodeStack = SCCDetect();
+        u32_t rank = 0;
         while (!nodeStack.empty())
         {
             NodeID nodeId = nodeStack.top();
             nodeStack.pop();
+            worklist.setRank(nodeId, rank++);
             pushIntoWorklist(nodeId);
         }
     }
@@ -232,6 +234,24 @@ protected:
 public:
     /// num of iterations during constaint solving
     u32_t numOfIteration;
+
+    /// Worklist strategy (-worklist by default), to be set before solving
+    //@{
+    inline void setWorklistStrategy(NodeWorkList::Strategy s)
+    {
+        worklist.setStrategy(s);
+    }
+    inline NodeWorkList::Strategy getWorklistStrategy() const
+    {
+        return worklist.getStrategy();
+    }
+    //@}
+
+    /// Number of nodes popped from the worklist, i.e., node visits driven by the worklist
+    inline u64_t getNumOfWorklistPops() const
+    {
+        return worklist.getNumOfPops();
+    }
 };
 
 } // End namespace SVF
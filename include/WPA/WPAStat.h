@@ -41,6 +41,7 @@ class AndersenBase;
 class PAG;
 class ConstraintGraph;
 class PAGNode;
+class VersionedFlowSensitive;
 
 /*!
  * Statistics of Andersen's analysis
@@ -120,6 +121,8 @@ private:
 
     void statInOutPtsSize(const DFInOutMap& data, ENUM_INOUT inOrOut);
 
+    void statVersionedPts(const VersionedFlowSensitive* vfspta);
+
     u32_t _NumOfNullPtr;
     u32_t _NumOfConstantPtr;
     u32_t _NumOfBlackholePtr;
@@ -158,6 +161,10 @@ private:
 
     u32_t _MaxAddrTakenVarPts;	///< max points-to set size of addr-taken variables.
     u32_t _NumOfAddrTakeVar;	///< number of occurrences of addr-taken variables in load/store.
+
+    size_t _InOutPtsMem;	///< memory of points-to sets in IN/OUT sets.
+    u32_t _NumOfVersionedPts;	///< number of non-empty versioned points-to sets.
+    size_t _VersionedPtsMem;	///< memory of versioned points-to sets.
 };
 
 } // End namespace SVF
@@ -10,7 +10,9 @@
 #include "DDA/FlowDDA.h"
 #include "DDA/ContextDDA.h"
 #include "DDA/DDAClient.h"
+#include "DDA/DDAQueryServer.h"
 #include "SVF-FE/PAGBuilder.h"
+#include "Util/Parallel.h"
 
 #include <sstream>
 #include <limits.h>
@@ -44,6 +46,12 @@ static llvm::cl::opt<bool> printQueryPts("print-query-pts", llvm::cl::init(false
 static llvm::cl::opt<bool> WPANUM("wpanum", llvm::cl::init(false),
                                   llvm::cl::desc("collect WPA FS number only "));
 
+static llvm::cl::opt<u32_t> DDAThreads("dda-threads", llvm::cl::init(1),
+        llvm::cl::desc("Number of threads answering the batch of queries (0: all hardware threads)"));
+
+static llvm::cl::opt<string> queryServer("dda-server", llvm::cl::init(""),
+        llvm::cl::desc("Answer pts/alias queries from stdin (-) or a Unix socket path instead of a fixed batch"));
+
 static llvm::RegisterPass<DDAPass> DDAPA("dda", "Demand-driven Pointer Analysis Pass");
 
 /// register this into alias analysis group
@@ -134,22 +142,7 @@ void DDAPass::runPointerAnalysis(SVFModule* module, u32_t kind)
     ContextCond::setMaxCxtLen(maxContextLen);
 
     /// Initialize pointer analysis.
-    switch (kind)
-    {
-    case PointerAnalysis::Cxt_DDA:
-    {
-        _pta = new ContextDDA(pag, _client);
-        break;
-    }
-    case PointerAnalysis::FlowS_DDA:
-    {
-        _pta = new FlowDDA(pag, _client);
-        break;
-    }
-    default:
-        outs() << "This pointer analysis has not been implemented yet.\n";
-        break;
-    }
+    _pta = createDDA(pag, kind);
 
     if(WPANUM)
     {
@@ -160,7 +153,12 @@ void DDAPass::runPointerAnalysis(SVFModule* module, u32_t kind)
         ///initialize
         _pta->initialize();
         ///compute points-to
-        _client->answerQueries(_pta);
+        if (!queryServer.empty())
+            serveQueries();
+        else if (ParallelUtil::getNumOfThreads(DDAThreads) > 1)
+            answerQueriesInParallel(pag, kind);
+        else
+            _client->answerQueries(_pta);
         ///finalize
         _pta->finalize();
         if(printCPts)
@@ -175,6 +173,139 @@ void DDAPass::runPointerAnalysis(SVFModule* module, u32_t kind)
 }
 
 
+/// Create a demand-driven analysis of the given kind
+PointerAnalysis* DDAPass::createDDA(PAG* pag, u32_t kind)
+{
+    switch (kind)
+    {
+    case PointerAnalysis::Cxt_DDA:
+        return new ContextDDA(pag, _client);
+    case PointerAnalysis::FlowS_DDA:
+        return new FlowDDA(pag, _client);
+    default:
+        outs() << "This pointer analysis has not been implemented yet.\n";
+        return NULL;
+    }
+}
+
+/*!
+ * Answer the candidate queries of the client on several threads.
+ * Each thread runs its own instance of the analysis (SVFG, call graph and DPM caches);
+ * the PAG and the Andersen pre-analysis are shared read-only (see prepareSharedPAG).
+ * The results of the queries answered by the other instances are then added to _pta
+ * in query order.
+ */
+void DDAPass::answerQueriesInParallel(PAG* pag, u32_t kind)
+{
+    u32_t numOfThreads = ParallelUtil::getNumOfThreads(DDAThreads);
+
+    DDAStat* stat = static_cast<DDAStat*>(_pta->getStat());
+    u32_t vmrss = 0;
+    u32_t vmsize = 0;
+    SVFUtil::getMemoryUsageKB(&vmrss, &vmsize);
+    stat->setMemUsageBefore(vmrss, vmsize);
+
+    const OrderedNodeSet& candidates = _client->collectCandidateQueries(pag);
+    std::vector<NodeID> queries;
+    for (NodeID id : candidates)
+    {
+        if (pag->isValidTopLevelPtr(pag->getPAGNode(id)))
+            queries.push_back(id);
+    }
+
+    /// Worker instances are built serially, _pta being the first one
+    PTAVector workers;
+    workers.push_back(_pta);
+    for (u32_t i = 1; i < numOfThreads; i++)
+    {
+        PointerAnalysis* worker = createDDA(pag, kind);
+        worker->initialize();
+        workers.push_back(worker);
+    }
+
+    /// Looking up a missing pointer would insert it into the shared Andersen result:
+    /// create every entry, including those of the field objects, beforehand so that
+    /// the workers only read it
+    BVDataPTAImpl* ander = AndersenWaveDiff::createAndersenWaveDiff(pag);
+    prepareSharedPAG(pag, ander);
+    for (PAG::iterator it = pag->begin(), eit = pag->end(); it != eit; ++it)
+        ander->getPts(it->first);
+
+    std::vector<u32_t> answeredBy(queries.size());
+    ParallelUtil::parallelFor(queries.size(), numOfThreads, [&](u32_t i, u32_t tid)
+    {
+        workers[tid]->computeDDAPts(queries[i]);
+        answeredBy[i] = tid;
+    }, 1);
+
+    for (u32_t i = 0; i < queries.size(); i++)
+    {
+        if (answeredBy[i] != 0)
+            mergeQueryPts(workers[answeredBy[i]], queries[i]);
+    }
+
+    for (u32_t i = 1; i < workers.size(); i++)
+    {
+        stat->mergeStat(static_cast<DDAStat*>(workers[i]->getStat()));
+        delete workers[i];
+    }
+
+    vmrss = vmsize = 0;
+    SVFUtil::getMemoryUsageKB(&vmrss, &vmsize);
+    stat->setMemUsageAfter(vmrss, vmsize);
+}
+
+/*!
+ * The analyses extend the PAG while solving: a gep creates the field objects of the
+ * objects it reaches (PAG nodes and symbols) and a variant gep makes them field-insensitive
+ * (memory objects). Andersen's points-to sets over-approximate those of the demand-driven
+ * analyses, so for every object of a gep source in Andersen's result this is done here,
+ * before the workers share the PAG. Objects at variant geps are field-insensitive, as they
+ * end up in a serial run querying all their pointers; other objects get the fields at the
+ * offsets of the normal geps reaching them, i.e., exactly those the queries may create.
+ */
+void DDAPass::prepareSharedPAG(PAG* pag, BVDataPTAImpl* ander)
+{
+    PAGEdge::PAGEdgeSetTy& variantGeps = pag->getEdgeSet(PAGEdge::VariantGep);
+    for (PAGEdge::PAGEdgeSetTy::iterator it = variantGeps.begin(), eit = variantGeps.end(); it != eit; ++it)
+    {
+        for (NodeID o : ander->getPts((*it)->getSrcID()))
+        {
+            if (!pag->isBlkObjOrConstantObj(o))
+                _pta->setObjFieldInsensitive(o);
+        }
+    }
+
+    PAGEdge::PAGEdgeSetTy& normalGeps = pag->getEdgeSet(PAGEdge::NormalGep);
+    for (PAGEdge::PAGEdgeSetTy::iterator it = normalGeps.begin(), eit = normalGeps.end(); it != eit; ++it)
+    {
+        const NormalGepPE* gep = SVFUtil::cast<NormalGepPE>(*it);
+        for (NodeID o : ander->getPts(gep->getSrcID()))
+        {
+            if (!pag->isBlkObjOrConstantObj(o))
+                pag->getGepObjNode(o, gep->getLocationSet());
+        }
+    }
+}
+
+/*!
+ * Add the points-to set of a query answered by another instance to _pta
+ */
+void DDAPass::mergeQueryPts(PointerAnalysis* worker, NodeID id)
+{
+    typedef CondPTAImpl<ContextCond> CxtPTAImpl;
+    if (CxtPTAImpl* cxtPTA = SVFUtil::dyn_cast<CxtPTAImpl>(_pta))
+    {
+        CxtVar var(ContextCond(), id);
+        const CxtPTAImpl::CPtSet& pts = static_cast<CxtPTAImpl*>(worker)->getPTDataTy()->getPts(var);
+        cxtPTA->getPTDataTy()->unionPts(var, pts);
+    }
+    else if (BVDataPTAImpl* bvPTA = SVFUtil::dyn_cast<BVDataPTAImpl>(_pta))
+    {
+        bvPTA->unionPts(id, worker->getPts(id));
+    }
+}
+
 /*!
  * Initialize context insensitive Edge for DDA
  */
@@ -341,6 +472,19 @@ AliasResult DDAPass::alias(const Value* V1, const Value* V2)
     return llvm::MayAlias;
 }
 
+/*!
+ * Keep the analysis alive and answer queries as they come
+ */
+void DDAPass::serveQueries()
+{
+    DDAQueryServer server(_pta, _client);
+    _client->collectCandidateQueries(_pta->getPAG());
+    if (queryServer == "-")
+        server.serve(std::cin, std::cout);
+    else if (!server.serveSocket(queryServer))
+        writeWrnMsg("DDA query server not started");
+}
+
 /*!
  * Print queries' pts
  */
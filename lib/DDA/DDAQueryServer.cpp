@@ -0,0 +1,286 @@
+/*
+ * DDAQueryServer.cpp
+ *
+ * Line protocol of the demand-driven query server, see DDAQueryServer.h
+ */
+
+#include "DDA/DDAQueryServer.h"
+#include "DDA/DDAClient.h"
+#include "DDA/ContextDDA.h"
+#include "MemoryModel/PTAStat.h"
+
+#include <sstream>
+#include <cstring>
+#include <cerrno>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace SVF;
+using namespace SVFUtil;
+
+/*!
+ * Compute the points-to set of a pointer unless it has been computed before
+ */
+void DDAQueryServer::computePts(NodeID id)
+{
+    if (answered.test(id))
+    {
+        numOfCachedQueries++;
+        return;
+    }
+
+    PAG* pag = pta->getPAG();
+    /// the solver keeps its caches between queries, only the pointer itself is new
+    if (pag->isValidTopLevelPtr(pag->getPAGNode(id)))
+    {
+        double start = PTAStat::getClk(true);
+        client->setCurrentQueryPtr(id);
+        pta->computeDDAPts(id);
+        double end = PTAStat::getClk(true);
+        queryTime += (end - start) / TIMEINTERVAL;
+    }
+    answered.set(id);
+}
+
+/*!
+ * Points-to set of a computed pointer. A context-sensitive analysis normalizes
+ * its conditional sets only when finalized, so it is read in the empty context.
+ */
+PointsTo DDAQueryServer::getQueryPts(NodeID id)
+{
+    if (pta->getAnalysisTy() == PointerAnalysis::Cxt_DDA)
+    {
+        ContextDDA* cxtDDA = static_cast<ContextDDA*>(pta);
+        return cxtDDA->getBVPointsTo(cxtDDA->getPts(CxtVar(ContextCond(), id)));
+    }
+    return pta->getPts(id);
+}
+
+/*!
+ * Alias result of two computed pointers, see getQueryPts
+ */
+AliasResult DDAQueryServer::queryAlias(NodeID id1, NodeID id2)
+{
+    if (pta->getAnalysisTy() == PointerAnalysis::Cxt_DDA)
+    {
+        ContextDDA* cxtDDA = static_cast<ContextDDA*>(pta);
+        return cxtDDA->alias(CxtVar(ContextCond(), id1), CxtVar(ContextCond(), id2));
+    }
+    return pta->alias(id1, id2);
+}
+
+/*!
+ * Write all of data to a file descriptor, return false on error
+ */
+static bool writeAll(int fd, const char* data, size_t size)
+{
+    while (size > 0)
+    {
+        ssize_t n = write(fd, data, size);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        data += n;
+        size -= n;
+    }
+    return true;
+}
+
+/*!
+ * Parse a PAG node ID
+ */
+bool DDAQueryServer::parseNodeID(std::istream& is, NodeID& id, std::string& reply) const
+{
+    if (!(is >> id))
+    {
+        reply = "error expecting a node ID";
+        return false;
+    }
+    if (!pta->getPAG()->hasGNode(id))
+    {
+        reply = "error no PAG node " + std::to_string(id);
+        return false;
+    }
+    return true;
+}
+
+/*!
+ * Answer one request
+ */
+bool DDAQueryServer::handleRequest(const std::string& request, std::string& reply)
+{
+    std::istringstream is(request);
+    std::string cmd;
+    is >> cmd;
+
+    std::ostringstream os;
+    if (cmd == "pts")
+    {
+        NodeID id;
+        if (!parseNodeID(is, id, reply))
+            return true;
+        computePts(id);
+        numOfQueries++;
+
+        os << "ok";
+        PointsTo pts = getQueryPts(id);
+        for (NodeID o : pts)
+            os << " " << o;
+    }
+    else if (cmd == "alias")
+    {
+        NodeID id1, id2;
+        if (!parseNodeID(is, id1, reply) || !parseNodeID(is, id2, reply))
+            return true;
+        computePts(id1);
+        computePts(id2);
+        numOfQueries++;
+
+        switch (queryAlias(id1, id2))
+        {
+        case llvm::NoAlias:
+            os << "ok NoAlias";
+            break;
+        case llvm::MustAlias:
+            os << "ok MustAlias";
+            break;
+        case llvm::PartialAlias:
+            os << "ok PartialAlias";
+            break;
+        default:
+            os << "ok MayAlias";
+            break;
+        }
+    }
+    else if (cmd == "stat")
+    {
+        os << "ok queries " << numOfQueries << " cached " << numOfCachedQueries
+           << " pointers " << answered.count() << " time " << queryTime;
+    }
+    else if (cmd == "quit" || cmd == "shutdown")
+    {
+        if (cmd == "shutdown")
+            shutdown = true;
+        reply = "ok bye";
+        return false;
+    }
+    else
+    {
+        reply = "error unknown request '" + cmd + "'";
+        return true;
+    }
+
+    reply = os.str();
+    return true;
+}
+
+/*!
+ * Serve the requests read from a stream
+ */
+void DDAQueryServer::serve(std::istream& in, std::ostream& out)
+{
+    std::string line, reply;
+    while (std::getline(in, line))
+    {
+        if (line.find_first_not_of(" \t\r") == std::string::npos)
+            continue;
+        bool more = handleRequest(line, reply);
+        out << reply << std::endl;
+        if (!more)
+            break;
+    }
+}
+
+/*!
+ * Serve the requests sent to a Unix socket
+ */
+bool DDAQueryServer::serveSocket(const std::string& path)
+{
+    struct sockaddr_un addr;
+    if (path.size() >= sizeof(addr.sun_path))
+    {
+        writeWrnMsg("socket path too long: " + path);
+        return false;
+    }
+
+    int sock = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (sock < 0)
+    {
+        writeWrnMsg("cannot create socket " + path);
+        return false;
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    unlink(path.c_str());
+    if (bind(sock, (struct sockaddr*) &addr, sizeof(addr)) < 0 || listen(sock, 1) < 0)
+    {
+        writeWrnMsg("cannot listen on socket " + path);
+        close(sock);
+        return false;
+    }
+
+    /// a client going away must not kill the server
+    signal(SIGPIPE, SIG_IGN);
+    outs() << pasMsg("DDA query server listening on ") << path << "\n";
+
+    bool ok = true;
+    u32_t failures = 0;
+    shutdown = false;
+    while (!shutdown)
+    {
+        int conn = accept(sock, NULL, NULL);
+        if (conn < 0)
+        {
+            if (errno == EINTR || errno == ECONNABORTED)
+                continue;
+            /// out of descriptors or memory, wait for connections to go away
+            if ((errno == EMFILE || errno == ENFILE || errno == ENOBUFS || errno == ENOMEM)
+                    && ++failures < MaxAcceptFailures)
+            {
+                sleep(1);
+                continue;
+            }
+            writeWrnMsg("cannot accept connections on socket " + path + ": " + strerror(errno));
+            ok = false;
+            break;
+        }
+        failures = 0;
+
+        std::string buffer, reply;
+        char chunk[4096];
+        bool open = true;
+        while (open)
+        {
+            ssize_t n = read(conn, chunk, sizeof(chunk));
+            if (n <= 0)
+                break;
+            buffer.append(chunk, n);
+
+            size_t pos;
+            while (open && (pos = buffer.find('\n')) != std::string::npos)
+            {
+                std::string line = buffer.substr(0, pos);
+                buffer.erase(0, pos + 1);
+                if (line.find_first_not_of(" \t\r") == std::string::npos)
+                    continue;
+
+                open = handleRequest(line, reply);
+                reply += "\n";
+                if (!writeAll(conn, reply.data(), reply.size()))
+                    open = false;
+            }
+        }
+        close(conn);
+    }
+
+    close(sock);
+    unlink(path.c_str());
+    return ok;
+}
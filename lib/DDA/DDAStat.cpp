@@ -185,6 +185,37 @@ void DDAStat::performStatPerQuery(NodeID ptr)
     _NumOfIndCallEdgeSolved = getPTA()->getNumOfResolvedIndCallEdge();
 }
 
+void DDAStat::mergeStat(const DDAStat* other)
+{
+    _NumOfDPM += other->_NumOfDPM;
+    _NumOfStrongUpdates += other->_NumOfStrongUpdates;
+    _NumOfMustAliases += other->_NumOfMustAliases;
+    _NumOfInfeasiblePath += other->_NumOfInfeasiblePath;
+    _NumOfStep += other->_NumOfStep;
+    _NumOfStepInCycle += other->_NumOfStepInCycle;
+    _TotalTimeOfQueries += other->_TotalTimeOfQueries;
+    _TotalTimeOfBKCondition += other->_TotalTimeOfBKCondition;
+    _StrongUpdateStores |= other->_StrongUpdateStores;
+
+    _TotalNumOfQuery += other->_TotalNumOfQuery;
+    _TotalNumOfDPM += other->_TotalNumOfDPM;
+    _TotalNumOfStrongUpdates += other->_TotalNumOfStrongUpdates;
+    _TotalNumOfMustAliases += other->_TotalNumOfMustAliases;
+    _TotalNumOfInfeasiblePath += other->_TotalNumOfInfeasiblePath;
+    _TotalNumOfStep += other->_TotalNumOfStep;
+    _TotalNumOfStepInCycle += other->_TotalNumOfStepInCycle;
+
+    _TotalCPtsSize += other->_TotalCPtsSize;
+    _TotalPtsSize += other->_TotalPtsSize;
+    _MaxCPtsSize = std::max(_MaxCPtsSize, other->_MaxCPtsSize);
+    _MaxPtsSize = std::max(_MaxPtsSize, other->_MaxPtsSize);
+    _NumOfNullPtr += other->_NumOfNullPtr;
+    _NumOfConstantPtr += other->_NumOfConstantPtr;
+    _NumOfBlackholePtr += other->_NumOfBlackholePtr;
+    _AvgNumOfDPMAtSVFGNode += other->_AvgNumOfDPMAtSVFGNode;
+    _MaxNumOfDPMAtSVFGNode = std::max(_MaxNumOfDPMAtSVFGNode, other->_MaxNumOfDPMAtSVFGNode);
+}
+
 void DDAStat::getNumOfOOBQuery()
 {
     if (flowDDA)
@@ -0,0 +1,203 @@
+//===- GraphStreamer.cpp -- Streaming export of SVF graphs -------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * GraphStreamer.cpp
+ *
+ * Streaming export of SVF graphs, see GraphStreamer.h
+ */
+
+#include "Graphs/GraphStreamer.h"
+#include <algorithm>
+
+using namespace SVF;
+using namespace SVFUtil;
+
+static llvm::cl::list<std::string> StreamGraphs("stream-graphs",
+        llvm::cl::desc("Graphs to stream to files next to their dot dumps (icfg,pag,consg,svfg)"),
+        llvm::cl::CommaSeparated);
+
+static llvm::cl::opt<GraphStreamer::Format> StreamGraphFormat("stream-graph-format",
+        llvm::cl::init(GraphStreamer::NDJSON),
+        llvm::cl::desc("Format of streamed graphs"),
+        llvm::cl::values(
+            clEnumValN(GraphStreamer::NDJSON, "json", "one JSON object per node and edge (default)"),
+            clEnumValN(GraphStreamer::EdgeList, "edgelist", "binary (src, dst, kind) records, edges only")));
+
+static llvm::cl::list<std::string> StreamGraphFuns("stream-graph-funs",
+        llvm::cl::desc("Only stream the nodes of these functions"),
+        llvm::cl::CommaSeparated);
+
+namespace
+{
+const u32_t EdgeListMagic = 0x45465653;	// "SVFE"
+const u32_t EdgeListVersion = 1;
+}
+
+/*!
+ * Constructor
+ */
+GraphStreamer::GraphStreamer(const std::string& filename, Format f, const FunctionNameSet& fs) :
+    out(filename.c_str(), std::ios::binary), format(f), funs(fs), numOfNodes(0), numOfEdges(0)
+{
+    if (!out.is_open())
+    {
+        writeWrnMsg("cannot open '" + filename + "' for streaming a graph");
+        return;
+    }
+    outs() << "stream graph to '" << filename << "'\n";
+    if (format == EdgeList)
+    {
+        out.write((const char*) &EdgeListMagic, sizeof(u32_t));
+        out.write((const char*) &EdgeListVersion, sizeof(u32_t));
+    }
+}
+
+/*!
+ * Destructor
+ */
+GraphStreamer::~GraphStreamer()
+{
+    if (out.is_open())
+        out.close();
+}
+
+/*!
+ * Visit every node once, writing the node and its outgoing edges right away
+ */
+template<class GraphType, class FunNameFn>
+void GraphStreamer::writeGraph(GraphType* graph, FunNameFn getFunName)
+{
+    for (typename GraphType::iterator it = graph->begin(), eit = graph->end(); it != eit; ++it)
+    {
+        const std::string fun = getFunName(it->second);
+        if (!funs.empty() && funs.find(fun) == funs.end())
+            continue;
+
+        writeNode(it->first, it->second->getNodeKind(), fun);
+        for (auto eIt = it->second->OutEdgeBegin(), eEit = it->second->OutEdgeEnd(); eIt != eEit; ++eIt)
+            writeEdge((*eIt)->getSrcID(), (*eIt)->getDstID(), (*eIt)->getEdgeKind());
+    }
+    out.flush();
+}
+
+void GraphStreamer::write(ICFG* icfg)
+{
+    writeGraph(icfg, [](const ICFGNode* node) -> std::string
+    {
+        return node->getFun() ? node->getFun()->getName().str() : "";
+    });
+}
+
+void GraphStreamer::write(PAG* pag)
+{
+    writeGraph(pag, [](const PAGNode* node) -> std::string
+    {
+        return node->getFunction() ? node->getFunction()->getName().str() : "";
+    });
+}
+
+/*!
+ * Constraint nodes share their IDs with PAG nodes
+ */
+void GraphStreamer::write(ConstraintGraph* consCG)
+{
+    PAG* pag = PAG::getPAG();
+    writeGraph(consCG, [pag](const ConstraintNode* node) -> std::string
+    {
+        if (!pag->hasGNode(node->getId()))
+            return "";
+        const Function* fun = pag->getGNode(node->getId())->getFunction();
+        return fun ? fun->getName().str() : "";
+    });
+}
+
+void GraphStreamer::write(SVFG* svfg)
+{
+    writeGraph(svfg, [](const SVFGNode* node) -> std::string
+    {
+        const ICFGNode* icfgNode = node->getICFGNode();
+        return icfgNode && icfgNode->getFun() ? icfgNode->getFun()->getName().str() : "";
+    });
+}
+
+void GraphStreamer::writeNode(NodeID id, u32_t kind, const std::string& fun)
+{
+    numOfNodes++;
+    if (format == EdgeList)
+        return;
+    out << "{\"t\":\"n\",\"id\":" << id << ",\"kind\":" << kind;
+    if (!fun.empty())
+    {
+        out << ",\"fun\":";
+        writeJsonString(fun);
+    }
+    out << "}\n";
+}
+
+void GraphStreamer::writeEdge(NodeID src, NodeID dst, u32_t kind)
+{
+    numOfEdges++;
+    if (format == EdgeList)
+    {
+        u32_t record[3] = {src, dst, kind};
+        out.write((const char*) record, sizeof(record));
+    }
+    else
+        out << "{\"t\":\"e\",\"src\":" << src << ",\"dst\":" << dst << ",\"kind\":" << kind << "}\n";
+}
+
+void GraphStreamer::writeJsonString(const std::string& str)
+{
+    static const char* hex = "0123456789abcdef";
+    out << '"';
+    for (char c : str)
+    {
+        if (c == '"' || c == '\\')
+            out << '\\' << c;
+        else if ((unsigned char) c < 0x20)
+            out << "\\u00" << hex[(c >> 4) & 0xf] << hex[c & 0xf];
+        else
+            out << c;
+    }
+    out << '"';
+}
+
+bool GraphStreamer::isEnabled(const std::string& graphName)
+{
+    return std::find(StreamGraphs.begin(), StreamGraphs.end(), graphName) != StreamGraphs.end();
+}
+
+GraphStreamer::Format GraphStreamer::getDefaultFormat()
+{
+    return StreamGraphFormat;
+}
+
+GraphStreamer::FunctionNameSet GraphStreamer::getDefaultFunctions()
+{
+    return FunctionNameSet(StreamGraphFuns.begin(), StreamGraphFuns.end());
+}
+
+std::string GraphStreamer::getExtension(Format format)
+{
+    return format == EdgeList ? ".edges" : ".ndjson";
+}
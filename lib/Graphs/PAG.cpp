@@ -1024,6 +1024,16 @@ void PAG::handleBlackHole(bool b)
     HANDBLACKHOLE = b;
 }
 
+bool PAG::isHandlingBlackHole()
+{
+    return HANDBLACKHOLE;
+}
+
+bool PAG::isFirstFieldEqBase()
+{
+    return FirstFieldEqBase;
+}
+
 namespace llvm
 {
 /*!
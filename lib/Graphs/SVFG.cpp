@@ -32,6 +32,7 @@
 #include "Graphs/SVFG.h"
 #include "Graphs/SVFGOPT.h"
 #include "Graphs/SVFGStat.h"
+#include "Util/Parallel.h"
 
 using namespace SVF;
 using namespace SVFUtil;
@@ -142,7 +143,7 @@ FormalOUTSVFGNode::FormalOUTSVFGNode(NodeID id, const MemSSA::RETMU* exit): MRSV
 /*!
  * Constructor
  */
-SVFG::SVFG(MemSSA* _mssa, VFGK k): VFG(_mssa->getPTA()->getPTACallGraph(),k),mssa(_mssa), pta(mssa->getPTA())
+SVFG::SVFG(MemSSA* _mssa, VFGK k): VFG(_mssa->getPTA()->getPTACallGraph(),k),mssa(_mssa), pta(mssa->getPTA()), numOfThreads(1)
 {
     stat = new SVFGStat(this);
 }
@@ -184,8 +185,48 @@ void SVFG::buildSVFG()
 
 }
 
+/*!
+ * Memory SSA operators of a set ordered by their memory regions.
+ * Sets of operators are keyed by pointers, so their iteration order varies between
+ * runs and with the thread that allocated the operators, while SVFG node IDs must not.
+ */
+template<class SetTy>
+static std::vector<typename SetTy::value_type> sortByMR(const SetTy& set)
+{
+    std::vector<typename SetTy::value_type> sorted(set.begin(), set.end());
+    std::sort(sorted.begin(), sorted.end(), [](typename SetTy::value_type a, typename SetTy::value_type b)
+    {
+        return a->getMR()->getMRID() < b->getMR()->getMRID();
+    });
+    return sorted;
+}
+
+/*!
+ * Entries of a memory SSA map ordered by the ID of the ICFG node of their keys
+ */
+template<class MapTy, class ToICFGNode>
+static std::vector<typename MapTy::value_type*> sortByICFGNode(MapTy& map, ToICFGNode toICFGNode)
+{
+    typedef std::pair<NodeID, typename MapTy::value_type*> IDAndEntry;
+    std::vector<IDAndEntry> entries;
+    entries.reserve(map.size());
+    for (typename MapTy::iterator it = map.begin(), eit = map.end(); it != eit; ++it)
+        entries.push_back(std::make_pair(toICFGNode(it->first)->getId(), &*it));
+    std::sort(entries.begin(), entries.end(), [](const IDAndEntry& a, const IDAndEntry& b)
+    {
+        return a.first < b.first;
+    });
+    std::vector<typename MapTy::value_type*> sorted;
+    sorted.reserve(entries.size());
+    for (const IDAndEntry& e : entries)
+        sorted.push_back(e.second);
+    return sorted;
+}
+
 /*
  * Create SVFG nodes for address-taken variables
+ * The nodes are created in a fixed order (ICFG node, then memory region), so that
+ * node IDs do not depend on how memory SSA was built.
  */
 void SVFG::addSVFGNodesForAddrTakenVars()
 {
@@ -201,142 +242,186 @@ void SVFG::addSVFGNodesForAddrTakenVars()
             setDef((*pi)->getResVer(),sNode);
     }
 
+    ICFG* icfg = pag->getICFG();
     /// set defs for address-taken vars defined at phi/chi/call
     /// create corresponding def and use nodes for address-taken vars (a.k.a MRVers)
     /// initialize memory SSA phi nodes (phi of address-taken variables)
-    for(MemSSA::BBToPhiSetMap::iterator it = mssa->getBBToPhiSetMap().begin(),
-            eit = mssa->getBBToPhiSetMap().end(); it!=eit; ++it)
+    for (MemSSA::BBToPhiSetMap::value_type* it : sortByICFGNode(mssa->getBBToPhiSetMap(),
+            [icfg](const BasicBlock* bb) { return icfg->getBlockICFGNode(&(bb->front())); }))
     {
-        for(PHISet::iterator pi = it->second.begin(), epi = it->second.end(); pi!=epi; ++pi)
-            addIntraMSSAPHISVFGNode(*pi);
+        for (MemSSA::PHI* phi : sortByMR(it->second))
+            addIntraMSSAPHISVFGNode(phi);
     }
     /// initialize memory SSA entry chi nodes
-    for(MemSSA::FunToEntryChiSetMap::iterator it = mssa->getFunToEntryChiSetMap().begin(),
-            eit = mssa->getFunToEntryChiSetMap().end(); it!=eit; ++it)
+    for (MemSSA::FunToEntryChiSetMap::value_type* it : sortByICFGNode(mssa->getFunToEntryChiSetMap(),
+            [icfg](const SVFFunction* fun) { return icfg->getFunEntryBlockNode(fun); }))
     {
-        for(CHISet::iterator pi = it->second.begin(), epi = it->second.end(); pi!=epi; ++pi)
-            addFormalINSVFGNode(SVFUtil::cast<ENTRYCHI>(*pi));
+        for (CHI* chi : sortByMR(it->second))
+            addFormalINSVFGNode(SVFUtil::cast<ENTRYCHI>(chi));
     }
     /// initialize memory SSA return mu nodes
-    for(MemSSA::FunToReturnMuSetMap::iterator it = mssa->getFunToRetMuSetMap().begin(),
-            eit = mssa->getFunToRetMuSetMap().end(); it!=eit; ++it)
+    for (MemSSA::FunToReturnMuSetMap::value_type* it : sortByICFGNode(mssa->getFunToRetMuSetMap(),
+            [icfg](const SVFFunction* fun) { return icfg->getFunExitBlockNode(fun); }))
     {
-        for(MUSet::iterator pi = it->second.begin(), epi = it->second.end(); pi!=epi; ++pi)
-            addFormalOUTSVFGNode(SVFUtil::cast<RETMU>(*pi));
+        for (MU* mu : sortByMR(it->second))
+            addFormalOUTSVFGNode(SVFUtil::cast<RETMU>(mu));
     }
     /// initialize memory SSA callsite mu nodes
-    for(MemSSA::CallSiteToMUSetMap::iterator it = mssa->getCallSiteToMuSetMap().begin(),
-            eit = mssa->getCallSiteToMuSetMap().end();
-            it!=eit; ++it)
+    for (MemSSA::CallSiteToMUSetMap::value_type* it : sortByICFGNode(mssa->getCallSiteToMuSetMap(),
+            [](const CallBlockNode* cs) { return cs; }))
     {
-        for(MUSet::iterator pi = it->second.begin(), epi = it->second.end(); pi!=epi; ++pi)
-            addActualINSVFGNode(SVFUtil::cast<CALLMU>(*pi));
+        for (MU* mu : sortByMR(it->second))
+            addActualINSVFGNode(SVFUtil::cast<CALLMU>(mu));
     }
     /// initialize memory SSA callsite chi nodes
-    for(MemSSA::CallSiteToCHISetMap::iterator it = mssa->getCallSiteToChiSetMap().begin(),
-            eit = mssa->getCallSiteToChiSetMap().end();
-            it!=eit; ++it)
+    for (MemSSA::CallSiteToCHISetMap::value_type* it : sortByICFGNode(mssa->getCallSiteToChiSetMap(),
+            [](const CallBlockNode* cs) { return cs; }))
     {
-        for(CHISet::iterator pi = it->second.begin(), epi = it->second.end(); pi!=epi; ++pi)
-            addActualOUTSVFGNode(SVFUtil::cast<CALLCHI>(*pi));
+        for (CHI* chi : sortByMR(it->second))
+            addActualOUTSVFGNode(SVFUtil::cast<CALLCHI>(chi));
     }
 }
 
 /*
  * Connect def-use chains for indirect value-flow, (value-flow of address-taken variables)
+ * Finding the defs of the intra-procedural flows only reads the SVFG and memory SSA,
+ * so it is done in parallel. The edges are added afterwards in node order, which
+ * gives the same SVFG as adding them along the way.
  */
 void SVFG::connectIndirectSVFGEdges()
 {
-
+    std::vector<const SVFGNode*> nodes;
+    nodes.reserve(getTotalNodeNum());
     for(iterator it = begin(), eit = end(); it!=eit; ++it)
+        nodes.push_back(it->second);
+
+    u32_t threads = ParallelUtil::getNumOfThreads(numOfThreads);
+    if (threads <= 1)
     {
-        NodeID nodeId = it->first;
-        const SVFGNode* node = it->second;
-        if(const LoadSVFGNode* loadNode = SVFUtil::dyn_cast<LoadSVFGNode>(node))
+        IntraIndirectUses uses;
+        for (const SVFGNode* node : nodes)
         {
-            MUSet& muSet = mssa->getMUSet(SVFUtil::cast<LoadPE>(loadNode->getPAGEdge()));
-            for(MUSet::iterator it = muSet.begin(), eit = muSet.end(); it!=eit; ++it)
-            {
-                if(LOADMU* mu = SVFUtil::dyn_cast<LOADMU>(*it))
-                {
-                    NodeID def = getDef(mu->getVer());
-                    addIntraIndirectVFEdge(def,nodeId, mu->getVer()->getMR()->getPointsTo());
-                }
-            }
+            uses.clear();
+            collectIntraIndirectUses(node, uses);
+            connectInterIndirectSVFGEdges(node);
+            for (const std::pair<NodeID, const PointsTo*>& use : uses)
+                addIntraIndirectVFEdge(use.first, node->getId(), *use.second);
         }
-        else if(const StoreSVFGNode* storeNode = SVFUtil::dyn_cast<StoreSVFGNode>(node))
+    }
+    else
+    {
+        std::vector<IntraIndirectUses> usesOfNodes(nodes.size());
+        ParallelUtil::parallelFor(nodes.size(), threads, [&](u32_t i, u32_t)
         {
-            CHISet& chiSet = mssa->getCHISet(SVFUtil::cast<StorePE>(storeNode->getPAGEdge()));
-            for(CHISet::iterator it = chiSet.begin(), eit = chiSet.end(); it!=eit; ++it)
-            {
-                if(STORECHI* chi = SVFUtil::dyn_cast<STORECHI>(*it))
-                {
-                    NodeID def = getDef(chi->getOpVer());
-                    addIntraIndirectVFEdge(def,nodeId, chi->getOpVer()->getMR()->getPointsTo());
-                }
-            }
-        }
-        else if(const FormalINSVFGNode* formalIn = SVFUtil::dyn_cast<FormalINSVFGNode>(node))
+            collectIntraIndirectUses(nodes[i], usesOfNodes[i]);
+        });
+        for (u32_t i = 0; i < nodes.size(); ++i)
         {
-            PTACallGraphEdge::CallInstSet callInstSet;
-            mssa->getPTA()->getPTACallGraph()->getDirCallSitesInvokingCallee(formalIn->getEntryChi()->getFunction(),callInstSet);
-            for(PTACallGraphEdge::CallInstSet::iterator it = callInstSet.begin(), eit = callInstSet.end(); it!=eit; ++it)
-            {
-                const CallBlockNode* cs = *it;
-                if(!mssa->hasMU(cs))
-                    continue;
-                ActualINSVFGNodeSet& actualIns = getActualINSVFGNodes(cs);
-                for(ActualINSVFGNodeSet::iterator ait = actualIns.begin(), aeit = actualIns.end(); ait!=aeit; ++ait)
-                {
-                    const ActualINSVFGNode* actualIn = SVFUtil::cast<ActualINSVFGNode>(getSVFGNode(*ait));
-                    addInterIndirectVFCallEdge(actualIn,formalIn,getCallSiteID(cs, formalIn->getFun()));
-                }
-            }
+            connectInterIndirectSVFGEdges(nodes[i]);
+            for (const std::pair<NodeID, const PointsTo*>& use : usesOfNodes[i])
+                addIntraIndirectVFEdge(use.first, nodes[i]->getId(), *use.second);
         }
-        else if(const FormalOUTSVFGNode* formalOut = SVFUtil::dyn_cast<FormalOUTSVFGNode>(node))
+    }
+
+    connectFromGlobalToProgEntry();
+}
+
+/*!
+ * Collect the def node and points-to set of each memory SSA version used by node
+ * in the same function. Memory SSA is only looked up, never modified, here.
+ */
+void SVFG::collectIntraIndirectUses(const SVFGNode* node, IntraIndirectUses& uses) const
+{
+    if(const LoadSVFGNode* loadNode = SVFUtil::dyn_cast<LoadSVFGNode>(node))
+    {
+        const MemSSA::LoadToMUSetMap& muSets = mssa->getLoadToMUSetMap();
+        MemSSA::LoadToMUSetMap::const_iterator mit = muSets.find(SVFUtil::cast<LoadPE>(loadNode->getPAGEdge()));
+        if (mit == muSets.end())
+            return;
+        for(MUSet::const_iterator it = mit->second.begin(), eit = mit->second.end(); it!=eit; ++it)
         {
-            PTACallGraphEdge::CallInstSet callInstSet;
-            const MemSSA::RETMU* retMu = formalOut->getRetMU();
-            mssa->getPTA()->getPTACallGraph()->getDirCallSitesInvokingCallee(retMu->getFunction(),callInstSet);
-            for(PTACallGraphEdge::CallInstSet::iterator it = callInstSet.begin(), eit = callInstSet.end(); it!=eit; ++it)
-            {
-                const CallBlockNode* cs = *it;
-                if(!mssa->hasCHI(cs))
-                    continue;
-                ActualOUTSVFGNodeSet& actualOuts = getActualOUTSVFGNodes(cs);
-                for(ActualOUTSVFGNodeSet::iterator ait = actualOuts.begin(), aeit = actualOuts.end(); ait!=aeit; ++ait)
-                {
-                    const ActualOUTSVFGNode* actualOut = SVFUtil::cast<ActualOUTSVFGNode>(getSVFGNode(*ait));
-                    addInterIndirectVFRetEdge(formalOut,actualOut,getCallSiteID(cs, formalOut->getFun()));
-                }
-            }
-            NodeID def = getDef(retMu->getVer());
-            addIntraIndirectVFEdge(def,nodeId, retMu->getVer()->getMR()->getPointsTo());
+            if(LOADMU* mu = SVFUtil::dyn_cast<LOADMU>(*it))
+                uses.push_back(std::make_pair(getDef(mu->getVer()), &mu->getVer()->getMR()->getPointsTo()));
         }
-        else if(const ActualINSVFGNode* actualIn = SVFUtil::dyn_cast<ActualINSVFGNode>(node))
+    }
+    else if(const StoreSVFGNode* storeNode = SVFUtil::dyn_cast<StoreSVFGNode>(node))
+    {
+        const MemSSA::StoreToChiSetMap& chiSets = mssa->getStoreToChiSetMap();
+        MemSSA::StoreToChiSetMap::const_iterator cit = chiSets.find(SVFUtil::cast<StorePE>(storeNode->getPAGEdge()));
+        if (cit == chiSets.end())
+            return;
+        for(CHISet::const_iterator it = cit->second.begin(), eit = cit->second.end(); it!=eit; ++it)
         {
-            const MRVer* ver = actualIn->getCallMU()->getVer();
-            NodeID def = getDef(ver);
-            addIntraIndirectVFEdge(def,nodeId, ver->getMR()->getPointsTo());
+            if(STORECHI* chi = SVFUtil::dyn_cast<STORECHI>(*it))
+                uses.push_back(std::make_pair(getDef(chi->getOpVer()), &chi->getOpVer()->getMR()->getPointsTo()));
         }
-        else if(SVFUtil::isa<ActualOUTSVFGNode>(node))
+    }
+    else if(const FormalOUTSVFGNode* formalOut = SVFUtil::dyn_cast<FormalOUTSVFGNode>(node))
+    {
+        const MRVer* ver = formalOut->getRetMU()->getVer();
+        uses.push_back(std::make_pair(getDef(ver), &ver->getMR()->getPointsTo()));
+    }
+    else if(const ActualINSVFGNode* actualIn = SVFUtil::dyn_cast<ActualINSVFGNode>(node))
+    {
+        const MRVer* ver = actualIn->getCallMU()->getVer();
+        uses.push_back(std::make_pair(getDef(ver), &ver->getMR()->getPointsTo()));
+    }
+    else if(SVFUtil::isa<ActualOUTSVFGNode>(node))
+    {
+        /// There's no need to connect actual out node to its definition site in the same function.
+    }
+    else if(const MSSAPHISVFGNode* phiNode = SVFUtil::dyn_cast<MSSAPHISVFGNode>(node))
+    {
+        for (MemSSA::PHI::OPVers::const_iterator it = phiNode->opVerBegin(), eit = phiNode->opVerEnd();
+                it != eit; it++)
         {
-            /// There's no need to connect actual out node to its definition site in the same function.
+            const MRVer* op = it->second;
+            uses.push_back(std::make_pair(getDef(op), &op->getMR()->getPointsTo()));
         }
-        else if(const MSSAPHISVFGNode* phiNode = SVFUtil::dyn_cast<MSSAPHISVFGNode>(node))
-        {
-            for (MemSSA::PHI::OPVers::const_iterator it = phiNode->opVerBegin(), eit = phiNode->opVerEnd();
-                    it != eit; it++)
+    }
+}
+
+/*!
+ * Connect a formal-in (formal-out) node with the actual-ins (actual-outs) at the
+ * direct call sites of its function
+ */
+void SVFG::connectInterIndirectSVFGEdges(const SVFGNode* node)
+{
+    if(const FormalINSVFGNode* formalIn = SVFUtil::dyn_cast<FormalINSVFGNode>(node))
+    {
+        PTACallGraphEdge::CallInstSet callInstSet;
+        mssa->getPTA()->getPTACallGraph()->getDirCallSitesInvokingCallee(formalIn->getEntryChi()->getFunction(),callInstSet);
+        for(PTACallGraphEdge::CallInstSet::iterator it = callInstSet.begin(), eit = callInstSet.end(); it!=eit; ++it)
+        {
+            const CallBlockNode* cs = *it;
+            if(!mssa->hasMU(cs))
+                continue;
+            ActualINSVFGNodeSet& actualIns = getActualINSVFGNodes(cs);
+            for(ActualINSVFGNodeSet::iterator ait = actualIns.begin(), aeit = actualIns.end(); ait!=aeit; ++ait)
             {
-                const MRVer* op = it->second;
-                NodeID def = getDef(op);
-                addIntraIndirectVFEdge(def,nodeId, op->getMR()->getPointsTo());
+                const ActualINSVFGNode* actualIn = SVFUtil::cast<ActualINSVFGNode>(getSVFGNode(*ait));
+                addInterIndirectVFCallEdge(actualIn,formalIn,getCallSiteID(cs, formalIn->getFun()));
+            }
+        }
+    }
+    else if(const FormalOUTSVFGNode* formalOut = SVFUtil::dyn_cast<FormalOUTSVFGNode>(node))
+    {
+        PTACallGraphEdge::CallInstSet callInstSet;
+        const MemSSA::RETMU* retMu = formalOut->getRetMU();
+        mssa->getPTA()->getPTACallGraph()->getDirCallSitesInvokingCallee(retMu->getFunction(),callInstSet);
+        for(PTACallGraphEdge::CallInstSet::iterator it = callInstSet.begin(), eit = callInstSet.end(); it!=eit; ++it)
+        {
+            const CallBlockNode* cs = *it;
+            if(!mssa->hasCHI(cs))
+                continue;
+            ActualOUTSVFGNodeSet& actualOuts = getActualOUTSVFGNodes(cs);
+            for(ActualOUTSVFGNodeSet::iterator ait = actualOuts.begin(), aeit = actualOuts.end(); ait!=aeit; ++ait)
+            {
+                const ActualOUTSVFGNode* actualOut = SVFUtil::cast<ActualOUTSVFGNode>(getSVFGNode(*ait));
+                addInterIndirectVFRetEdge(formalOut,actualOut,getCallSiteID(cs, formalOut->getFun()));
             }
         }
     }
-
-
-    connectFromGlobalToProgEntry();
 }
 
 
@@ -0,0 +1,237 @@
+//===- VarSubstitution.cpp -- Offline variable substitution of a constraint graph //
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * VarSubstitution.cpp
+ *
+ * Hash-based value numbering of a constraint graph, see VarSubstitution.h
+ */
+
+#include "Graphs/VarSubstitution.h"
+
+using namespace SVF;
+using namespace SVFUtil;
+
+const u32_t VarSubstitution::Unnumbered;
+const u32_t VarSubstitution::VariantOffset;
+
+/*!
+ * Number the SCCs over copy and gep edges in topological order, then pair every
+ * node with the smallest node of its value number
+ */
+void VarSubstitution::solve()
+{
+    NodeID maxId = 0;
+    for (ConstraintGraph::iterator it = consCG->begin(), eit = consCG->end(); it != eit; ++it)
+        maxId = std::max(maxId, it->first);
+
+    /// the IDs of objects are their addr labels, other labels come after all IDs
+    nextLabel = maxId + 1;
+    nodeToVN.assign(maxId + 1, Unnumbered);
+    vnLabels.push_back(NodeBS());
+
+    collectIndirectNodes();
+
+    ConstraintNode::SCCEdgeFlag flag = ConstraintNode::sccEdgeFlag;
+    ConstraintNode::setSCCEdgeFlag(ConstraintNode::Direct);
+    CGSCC scc(consCG);
+    scc.find();
+    ConstraintNode::setSCCEdgeFlag(flag);
+
+    NodeStack& topoOrder = scc.topoNodeStack();
+    while (!topoOrder.empty())
+    {
+        NodeID rep = topoOrder.top();
+        topoOrder.pop();
+        numberSCC(scc, rep);
+    }
+
+    std::vector<NodeID> vnToRep(vnLabels.size(), Unnumbered);
+    for (NodeID id = 0; id <= maxId; ++id)
+    {
+        if (!isNumbered(id))
+            continue;
+        NodeID& rep = vnToRep[nodeToVN[id]];
+        if (rep == Unnumbered)
+            rep = id;
+        else
+            merges.push_back(std::make_pair(id, rep));
+    }
+}
+
+/*!
+ * Objects are stored into, while formal parameters of address-taken functions and
+ * return values of indirect callsites are connected once their callees are resolved.
+ * Variadic arguments are treated as formal parameters of any function.
+ */
+void VarSubstitution::collectIndirectNodes()
+{
+    for (ConstraintGraph::iterator it = consCG->begin(), eit = consCG->end(); it != eit; ++it)
+    {
+        const PAGNode* node = pag->getPAGNode(it->first);
+        if (isa<ObjPN>(node) || isa<VarArgPN>(node))
+            indirectNodes.set(it->first);
+    }
+
+    for (PAG::FunToArgsListMap::iterator it = pag->getFunArgsMap().begin(),
+            eit = pag->getFunArgsMap().end(); it != eit; ++it)
+    {
+        const Function* fun = it->first->getLLVMFun();
+        if (fun && !fun->hasAddressTaken())
+            continue;
+        for (PAG::PAGNodeList::const_iterator argIt = it->second.begin(), argEit = it->second.end();
+                argIt != argEit; ++argIt)
+            indirectNodes.set((*argIt)->getId());
+    }
+
+    const PAG::CallSiteToFunPtrMap& callsites = pag->getIndirectCallsites();
+    for (PAG::CallSiteToFunPtrMap::const_iterator it = callsites.begin(), eit = callsites.end(); it != eit; ++it)
+    {
+        const RetBlockNode* retBlockNode = it->first->getRetBlockNode();
+        if (retBlockNode && pag->callsiteHasRet(retBlockNode))
+            indirectNodes.set(pag->getCallSiteRet(retBlockNode)->getId());
+    }
+}
+
+/*!
+ * The nodes of a copy cycle share the union of their incoming labels.
+ * Loads from a pointer not numbered yet (it is in this SCC or a later one) get
+ * a label of the SCC of that pointer.
+ */
+void VarSubstitution::numberSCC(CGSCC& scc, NodeID rep)
+{
+    const NodeBS& subNodes = scc.subNodes(rep);
+
+    /// a gep inside the SCC makes a positive weight cycle, whose nodes are
+    /// collapsed while solving and kept apart here
+    for (NodeBS::iterator it = subNodes.begin(), eit = subNodes.end(); it != eit; ++it)
+    {
+        const ConstraintNode* node = consCG->getConstraintNode(*it);
+        for (ConstraintNode::const_iterator eIt = node->getGepOutEdges().begin(),
+                eEit = node->getGepOutEdges().end(); eIt != eEit; ++eIt)
+        {
+            if (scc.repNode((*eIt)->getDstID()) != rep)
+                continue;
+            for (NodeBS::iterator sit = subNodes.begin(), esit = subNodes.end(); sit != esit; ++sit)
+            {
+                NodeBS labels;
+                labels.set(newLabel());
+                nodeToVN[*sit] = getValueNumber(labels);
+            }
+            return;
+        }
+    }
+
+    NodeBS labels;
+    bool indirect = false;
+    for (NodeBS::iterator it = subNodes.begin(), eit = subNodes.end(); it != eit; ++it)
+    {
+        NodeID id = *it;
+        const ConstraintNode* node = consCG->getConstraintNode(id);
+        indirect |= indirectNodes.test(id);
+
+        for (ConstraintNode::const_iterator eIt = node->getAddrInEdges().begin(),
+                eEit = node->getAddrInEdges().end(); eIt != eEit; ++eIt)
+            labels.set((*eIt)->getSrcID());
+
+        for (ConstraintNode::const_iterator eIt = node->getCopyInEdges().begin(),
+                eEit = node->getCopyInEdges().end(); eIt != eEit; ++eIt)
+        {
+            NodeID src = (*eIt)->getSrcID();
+            if (scc.repNode(src) == rep)
+                continue;
+            assert(isNumbered(src) && "copy source not numbered before its destination?");
+            labels |= vnLabels[nodeToVN[src]];
+        }
+
+        for (ConstraintNode::const_iterator eIt = node->getGepInEdges().begin(),
+                eEit = node->getGepInEdges().end(); eIt != eEit; ++eIt)
+        {
+            NodeID src = (*eIt)->getSrcID();
+            assert(isNumbered(src) && "gep source not numbered before its destination?");
+            u32_t vn = nodeToVN[src];
+            if (vn == 0)
+                continue;
+            if (const NormalGepCGEdge* gep = dyn_cast<NormalGepCGEdge>(*eIt))
+            {
+                if (gep->getLocationSet().isConstantOffset())
+                    labels.set(getLabel(gepLabels, vn, gep->getLocationSet().getOffset()));
+                else
+                    labels.set(newLabel());
+            }
+            else
+                labels.set(getLabel(gepLabels, vn, VariantOffset));
+        }
+
+        for (ConstraintNode::const_iterator eIt = node->getLoadInEdges().begin(),
+                eEit = node->getLoadInEdges().end(); eIt != eEit; ++eIt)
+        {
+            NodeID src = (*eIt)->getSrcID();
+            if (!isNumbered(src))
+                labels.set(getLabel(pendingLoadLabels, scc.repNode(src), 0));
+            else if (nodeToVN[src] != 0)
+                labels.set(getLabel(loadLabels, nodeToVN[src], 0));
+        }
+    }
+
+    if (indirect)
+        labels.set(newLabel());
+
+    u32_t vn = getValueNumber(labels);
+    for (NodeBS::iterator it = subNodes.begin(), eit = subNodes.end(); it != eit; ++it)
+        nodeToVN[*it] = vn;
+}
+
+/*!
+ * The label of a derived constraint, e.g., the gep at an offset from a value number
+ */
+NodeID VarSubstitution::getLabel(Map<NodePair, NodeID>& labels, NodeID first, NodeID second)
+{
+    NodePair key = std::make_pair(first, second);
+    Map<NodePair, NodeID>::const_iterator it = labels.find(key);
+    if (it != labels.end())
+        return it->second;
+    NodeID label = newLabel();
+    labels[key] = label;
+    return label;
+}
+
+/*!
+ * Equal label sets have equal value numbers, the empty set is 0
+ */
+u32_t VarSubstitution::getValueNumber(const NodeBS& labels)
+{
+    if (labels.empty())
+        return 0;
+
+    std::vector<NodeID> key;
+    for (NodeBS::iterator it = labels.begin(), eit = labels.end(); it != eit; ++it)
+        key.push_back(*it);
+    std::map<std::vector<NodeID>, u32_t>::const_iterator vnIt = labelsToVN.find(key);
+    if (vnIt != labelsToVN.end())
+        return vnIt->second;
+
+    u32_t vn = vnLabels.size();
+    vnLabels.push_back(labels);
+    labelsToVN[key] = vn;
+    return vn;
+}
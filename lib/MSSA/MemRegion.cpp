@@ -239,12 +239,14 @@ void MRGenerator::collectModRefForCall()
         const CallBlockNode* callBlockNode = pta->getPAG()->getICFG()->getCallBlockNode(cs.getInstruction());
         if(hasRefSideEffectOfCallSite(callBlockNode))
         {
-            NodeBS refs = getRefSideEffectOfCallSite(callBlockNode);
+            PointsTo refs;
+            refs |= getRefSideEffectOfCallSite(callBlockNode);
             addCPtsToCallSiteRefs(refs,callBlockNode);
         }
         if(hasModSideEffectOfCallSite(callBlockNode))
         {
-            NodeBS mods = getModSideEffectOfCallSite(callBlockNode);
+            PointsTo mods;
+            mods |= getModSideEffectOfCallSite(callBlockNode);
             /// mods are treated as both def and use of memory objects
             addCPtsToCallSiteMods(mods,callBlockNode);
             addCPtsToCallSiteRefs(mods,callBlockNode);
@@ -509,11 +511,11 @@ NodeBS& MRGenerator::CollectPtsChain(NodeID id)
         return it->second;
     else
     {
-        PointsTo& pts = cachedPtsChainMap[baseId];
+        NodeBS& pts = cachedPtsChainMap[baseId];
         pts |= pta->getPAG()->getFieldsAfterCollapse(baseId);
 
         WorkList worklist;
-        for(PointsTo::iterator it = pts.begin(), eit = pts.end(); it!=eit; ++it)
+        for(NodeBS::iterator it = pts.begin(), eit = pts.end(); it!=eit; ++it)
             worklist.push(*it);
 
         while(!worklist.empty())
@@ -661,7 +663,9 @@ PointsTo MRGenerator::getModInfoForCall(const CallBlockNode* cs)
     }
     else
     {
-        return getModSideEffectOfCallSite(cs);
+        PointsTo mods;
+        mods |= getModSideEffectOfCallSite(cs);
+        return mods;
     }
 }
 
@@ -685,7 +689,9 @@ PointsTo MRGenerator::getRefInfoForCall(const CallBlockNode* cs)
     }
     else
     {
-        return getRefSideEffectOfCallSite(cs);
+        PointsTo refs;
+        refs |= getRefSideEffectOfCallSite(cs);
+        return refs;
     }
 }
 
@@ -31,6 +31,8 @@
 #include "MSSA/MemPartition.h"
 #include "MSSA/MemSSA.h"
 #include "Graphs/SVFGStat.h"
+#include "MSSA/SVFGBuilder.h"
+#include "Util/Parallel.h"
 
 #include <string>
 #include <llvm/IR/DebugLoc.h>
@@ -62,11 +64,12 @@ double MemSSA::timeOfGeneratingMemRegions = 0;	///< Time for allocating regions
 double MemSSA::timeOfCreateMUCHI  = 0;	///< Time for generating mu/chi for load/store/calls
 double MemSSA::timeOfInsertingPHI  = 0;	///< Time for inserting phis
 double MemSSA::timeOfSSARenaming  = 0;	///< Time for SSA rename
+double MemSSA::timeOfParallelBuild  = 0;	///< Time for building the functions on multiple threads
 
 /*!
  * Constructor
  */
-MemSSA::MemSSA(BVDataPTAImpl* p, bool ptrOnlyMSSA) : df(NULL),dt(NULL)
+MemSSA::MemSSA(BVDataPTAImpl* p, bool ptrOnlyMSSA) : df(NULL),dt(NULL),deferredVers(NULL)
 {
     pta = p;
     assert((pta->getAnalysisTy()!=PointerAnalysis::Default_PTA)
@@ -98,6 +101,15 @@ MemSSA::MemSSA(BVDataPTAImpl* p, bool ptrOnlyMSSA) : df(NULL),dt(NULL)
     timeOfGeneratingMemRegions += (mrEnd - mrStart)/TIMEINTERVAL;
 }
 
+/*!
+ * Constructor of a worker, which owns the mus/chis/phis it builds until they are
+ * merged into the master, but shares the memory regions of the master
+ */
+MemSSA::MemSSA(MemSSA* master) : pta(master->pta), mrGen(master->mrGen), df(NULL), dt(NULL),
+    stat(NULL), deferredVers(NULL)
+{
+}
+
 /*!
  * Set DF/DT
  */
@@ -142,6 +154,82 @@ void MemSSA::buildMemSSA(const SVFFunction& fun, DominanceFrontier* f, Dominator
 
 }
 
+/*!
+ * Build memory SSA for functions in parallel.
+ * The functions of a module are independent once memory regions are generated:
+ * each thread builds whole functions into its own worker, reading only the regions
+ * and the PAG. The workers are then merged, and the deferred IDs of the versions
+ * are assigned function by function in the order of funs, as a serial build would.
+ * The clock is process-wide, so the three phases are timed as a whole.
+ */
+void MemSSA::buildMemSSA(const std::vector<const SVFFunction*>& funs, u32_t numOfThreads)
+{
+    numOfThreads = ParallelUtil::getNumOfThreads(numOfThreads);
+
+    std::vector<MemSSA*> workers;
+    for (u32_t tid = 0; tid < numOfThreads; ++tid)
+        workers.push_back(new MemSSA(this));
+    std::vector<std::vector<MRVer*> > versOfFuns(funs.size());
+
+    double buildStart = stat->getClk(true);
+    ParallelUtil::parallelFor(funs.size(), numOfThreads, [&](u32_t i, u32_t tid)
+    {
+        const SVFFunction& fun = *funs[i];
+        assert(!isExtCall(&fun) && "we do not build memory ssa for external functions");
+
+        DominatorTree dt;
+        MemSSADF df;
+        dt.recalculate(*fun.getLLVMFun());
+        df.runOnDT(dt);
+
+        MemSSA* worker = workers[tid];
+        worker->setCurrentDFDT(&df, &dt);
+        worker->deferredVers = &versOfFuns[i];
+        worker->createMUCHI(fun);
+        worker->insertPHI(fun);
+        worker->SSARename(fun);
+        worker->setCurrentDFDT(NULL, NULL);
+    }, 1);
+    double buildEnd = stat->getClk(true);
+    timeOfParallelBuild += (buildEnd - buildStart)/TIMEINTERVAL;
+
+    for (MemSSA* worker : workers)
+    {
+        mergeFrom(worker);
+        delete worker;
+    }
+    for (std::vector<MRVer*>& vers : versOfFuns)
+    {
+        for (MRVer* ver : vers)
+            ver->assignID();
+    }
+}
+
+/*!
+ * Take over the mus/chis/phis of a worker. The keys (loads, stores, call sites,
+ * basic blocks and functions) of different functions never overlap.
+ */
+void MemSSA::mergeFrom(MemSSA* worker)
+{
+    load2MuSetMap.insert(worker->load2MuSetMap.begin(), worker->load2MuSetMap.end());
+    store2ChiSetMap.insert(worker->store2ChiSetMap.begin(), worker->store2ChiSetMap.end());
+    callsiteToMuSetMap.insert(worker->callsiteToMuSetMap.begin(), worker->callsiteToMuSetMap.end());
+    callsiteToChiSetMap.insert(worker->callsiteToChiSetMap.begin(), worker->callsiteToChiSetMap.end());
+    bb2PhiSetMap.insert(worker->bb2PhiSetMap.begin(), worker->bb2PhiSetMap.end());
+    funToEntryChiSetMap.insert(worker->funToEntryChiSetMap.begin(), worker->funToEntryChiSetMap.end());
+    funToReturnMuSetMap.insert(worker->funToReturnMuSetMap.begin(), worker->funToReturnMuSetMap.end());
+
+    /// the mus/chis/phis are owned by this MemSSA now, and the regions by the master
+    worker->load2MuSetMap.clear();
+    worker->store2ChiSetMap.clear();
+    worker->callsiteToMuSetMap.clear();
+    worker->callsiteToChiSetMap.clear();
+    worker->bb2PhiSetMap.clear();
+    worker->funToEntryChiSetMap.clear();
+    worker->funToReturnMuSetMap.clear();
+    worker->mrGen = NULL;
+}
+
 /*!
  * Create mu/chi according to memory regions
  * collect used mrs in usedRegs and construction map from region to BB for prune SSA phi insertion
@@ -182,27 +270,34 @@ void MemSSA::createMUCHI(const SVFFunction& fun)
                 it != eit; ++it)
         {
             const Instruction* inst = &*it;
-            if(mrGen->hasPAGEdgeList(inst))
+            /// look up without inserting, the ICFG, PAG and regions are shared by parallel builds
+            if (const PAGEdgeList* pagEdgeList = mrGen->findPAGEdgesFromInst(inst))
             {
-                PAGEdgeList& pagEdgeList = mrGen->getPAGEdgesFromInst(inst);
-                for (PAGEdgeList::const_iterator bit = pagEdgeList.begin(),
-                        ebit = pagEdgeList.end(); bit != ebit; ++bit)
+                for (PAGEdgeList::const_iterator bit = pagEdgeList->begin(),
+                        ebit = pagEdgeList->end(); bit != ebit; ++bit)
                 {
                     const PAGEdge* inst = *bit;
                     if (const LoadPE* load = SVFUtil::dyn_cast<LoadPE>(inst))
-                        AddLoadMU(bb, load, mrGen->getLoadMRSet(load));
+                    {
+                        if (const MRSet* mrs = mrGen->findLoadMRSet(load))
+                            AddLoadMU(bb, load, *mrs);
+                    }
                     else if (const StorePE* store = SVFUtil::dyn_cast<StorePE>(inst))
-                        AddStoreCHI(bb, store, mrGen->getStoreMRSet(store));
+                    {
+                        if (const MRSet* mrs = mrGen->findStoreMRSet(store))
+                            AddStoreCHI(bb, store, *mrs);
+                    }
                 }
             }
             if (isNonInstricCallSite(inst))
             {
-                const CallBlockNode* cs = pag->getICFG()->getCallBlockNode(inst);
-                if(mrGen->hasRefMRSet(cs))
-                    AddCallSiteMU(cs,mrGen->getCallSiteRefMRSet(cs));
+                const CallBlockNode* cs = pag->getICFG()->findCallBlockNode(inst);
+                assert(cs && "no CallBlockNode for this callsite?");
+                if (const MRSet* mrs = mrGen->findCallSiteRefMRSet(cs))
+                    AddCallSiteMU(cs, *mrs);
 
-                if(mrGen->hasModMRSet(cs))
-                    AddCallSiteCHI(cs,mrGen->getCallSiteModMRSet(cs));
+                if (const MRSet* mrs = mrGen->findCallSiteModMRSet(cs))
+                    AddCallSiteCHI(cs, *mrs);
             }
         }
     }
@@ -324,10 +419,10 @@ void MemSSA::SSARenameBB(const BasicBlock& bb)
             it != eit; ++it)
     {
         const Instruction* inst = &*it;
-        if(mrGen->hasPAGEdgeList(inst))
+        /// look up without inserting, the ICFG, PAG and regions are shared by parallel builds
+        if (const PAGEdgeList* pagEdgeList = mrGen->findPAGEdgesFromInst(inst))
         {
-            PAGEdgeList& pagEdgeList = mrGen->getPAGEdgesFromInst(inst);
-            for(PAGEdgeList::const_iterator bit = pagEdgeList.begin(), ebit= pagEdgeList.end();
+            for(PAGEdgeList::const_iterator bit = pagEdgeList->begin(), ebit= pagEdgeList->end();
                     bit!=ebit; ++bit)
             {
                 const PAGEdge* inst = *bit;
@@ -341,11 +436,12 @@ void MemSSA::SSARenameBB(const BasicBlock& bb)
         }
         if (isNonInstricCallSite(inst))
         {
-            const CallBlockNode* cs = pag->getICFG()->getCallBlockNode(inst);
-            if(mrGen->hasRefMRSet(cs))
+            const CallBlockNode* cs = pag->getICFG()->findCallBlockNode(inst);
+            assert(cs && "no CallBlockNode for this callsite?");
+            if(mrGen->findCallSiteRefMRSet(cs))
                 RenameMuSet(getMUSet(cs));
 
-            if(mrGen->hasModMRSet(cs))
+            if(mrGen->findCallSiteModMRSet(cs))
                 RenameChiSet(getCHISet(cs),memRegs);
         }
         else if(isReturn(inst))
@@ -397,7 +493,9 @@ MRVer* MemSSA::newSSAName(const MemRegion* mr, MSSADEF* def)
 
     MRVERSION version = mr2CounterMap[mr];
     mr2CounterMap[mr] = version + 1;
-    MRVer* mrVer = new MRVer(mr, version, def);
+    MRVer* mrVer = new MRVer(mr, version, def, deferredVers != NULL);
+    if (deferredVers)
+        deferredVers->push_back(mrVer);
     mr2VerStackMap[mr].push_back(mrVer);
     return mrVer;
 }
@@ -802,8 +900,9 @@ void MemSSA::dumpMSSA(raw_ostream& Out)
                 bool isAppCall = isNonInstricCallSite(&inst) && !isExtCall(&inst) && !DumpRace;
                 if (isAppCall || isHeapAllocExtCall(&inst))
                 {
-                    const CallBlockNode* cs = pag->getICFG()->getCallBlockNode(&inst);
-                    if(hasMU(cs))
+                    /// callsites in unreachable blocks have no CallBlockNode
+                    const CallBlockNode* cs = pag->getICFG()->findCallBlockNode(&inst);
+                    if(cs && hasMU(cs))
                     {
                         if (!last_is_chi)
                         {
@@ -818,7 +917,7 @@ void MemSSA::dumpMSSA(raw_ostream& Out)
 
                     Out << inst << "\n";
 
-                    if(hasCHI(cs))
+                    if(cs && hasCHI(cs))
                     {
                         for (CHISet::iterator cit = getCHISet(cs).begin(), ecit = getCHISet(cs).end();
                                 cit != ecit; ++cit)
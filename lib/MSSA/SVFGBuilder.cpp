@@ -30,6 +30,7 @@
 #include "SVF-FE/LLVMUtil.h"
 #include "MSSA/MemSSA.h"
 #include "Graphs/SVFG.h"
+#include "Graphs/GraphStreamer.h"
 #include "MSSA/SVFGBuilder.h"
 #include "WPA/Andersen.h"
 
@@ -48,6 +49,9 @@ static llvm::cl::opt<bool> OPTSVFG("optSVFG", llvm::cl::init(true),
 static llvm::cl::opt<bool> DumpVFG("dump-svfg", llvm::cl::init(false),
                                    llvm::cl::desc("Dump dot graph of SVFG"));
 
+static llvm::cl::opt<u32_t> SVFGThreads("svfg-threads", llvm::cl::init(1),
+                                        llvm::cl::desc("Number of threads building memory SSA and intra-procedural SVFG edges (0: all hardware threads)"));
+
 
 SVFG* SVFGBuilder::globalSvfg = NULL;
 
@@ -102,6 +106,7 @@ SVFG* SVFGBuilder::build(BVDataPTAImpl* pta, VFG::VFGK kind)
                 svfg = globalSvfg = new SVFGOPT(mssa, kind);
             else
                 svfg = globalSvfg = new SVFG(mssa, kind);
+            svfg->setNumOfThreads(SVFGThreads);
             buildSVFG();
         }
     }
@@ -111,6 +116,7 @@ SVFG* SVFGBuilder::build(BVDataPTAImpl* pta, VFG::VFGK kind)
             svfg = new SVFGOPT(mssa, kind);
         else
             svfg = new SVFG(mssa,kind);
+        svfg->setNumOfThreads(SVFGThreads);
         buildSVFG();
     }
 
@@ -122,6 +128,7 @@ SVFG* SVFGBuilder::build(BVDataPTAImpl* pta, VFG::VFGK kind)
 
     if(DumpVFG)
     	svfg->dump("svfg_final");
+    GraphStreamer::stream(svfg, "svfg", "svfg_final");
 
     return svfg;
 }
@@ -144,6 +151,7 @@ MemSSA* SVFGBuilder::buildMSSA(BVDataPTAImpl* pta, bool ptrOnlyMSSA)
     DominatorTree dt;
     MemSSADF df;
 
+    std::vector<const SVFFunction*> funs;
     SVFModule* svfModule = mssa->getPTA()->getModule();
     for (SVFModule::const_iterator iter = svfModule->begin(), eiter = svfModule->end();
             iter != eiter; ++iter)
@@ -153,12 +161,21 @@ MemSSA* SVFGBuilder::buildMSSA(BVDataPTAImpl* pta, bool ptrOnlyMSSA)
         if (isExtCall(fun))
             continue;
 
+        if (SVFGThreads != 1)
+        {
+            funs.push_back(fun);
+            continue;
+        }
+
         dt.recalculate(*fun->getLLVMFun());
         df.runOnDT(dt);
 
         mssa->buildMemSSA(*fun, &df, &dt);
     }
 
+    if (!funs.empty())
+        mssa->buildMemSSA(funs, SVFGThreads);
+
     mssa->performStat();
     mssa->dumpMSSA();
 
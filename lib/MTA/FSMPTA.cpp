@@ -8,6 +8,7 @@
 #include "MTA/FSMPTA.h"
 #include "MTA/MHP.h"
 #include "MTA/PCG.h"
+#include "MemoryModel/PTAStat.h"
 
 using namespace SVF;
 using namespace SVFUtil;
@@ -16,6 +17,9 @@ FSMPTA* FSMPTA::mfspta = NULL;
 u32_t MTASVFGBuilder::numOfNewSVFGEdges = 0;
 u32_t MTASVFGBuilder::numOfRemovedSVFGEdges = 0;
 u32_t MTASVFGBuilder::numOfRemovedPTS = 0;
+u64_t MTASVFGBuilder::numOfCheckedPairs = 0;
+u64_t MTASVFGBuilder::numOfAllPairs = 0;
+double MTASVFGBuilder::connectMHPEdgesTime = 0;
 
 static llvm::cl::opt<bool> UsePCG("pcgTDEdge", llvm::cl::init(false), llvm::cl::desc("Use PCG lock for non-sparsely adding SVFG edges"));
 static llvm::cl::opt<bool> IntraLock("intralockTDEdge", llvm::cl::init(true), llvm::cl::desc("Use simple intra-procedual lock for adding SVFG edges"));
@@ -24,6 +28,8 @@ static llvm::cl::opt<bool> ReadPrecisionTDEdge("rpTDEdge", llvm::cl::init(false)
 static llvm::cl::opt<u32_t> AddModelFlag("addTDEdge", llvm::cl::init(0), llvm::cl::desc("Add thread SVFG edges with models: 0 Non Add Edge; 1 NonSparse; "
         "2 All Optimisation; 3 No MHP; 4 No Alias; 5 No Lock; 6 No Read Precision."));
 
+static llvm::cl::opt<bool> IndexTDEdge("indexTDEdge", llvm::cl::init(true), llvm::cl::desc("Only check loads/stores which may access a common object when adding thread SVFG edges"));
+
 /*!
  *
  */
@@ -68,6 +74,79 @@ void MTASVFGBuilder::collectLoadStoreSVFGNodes()
         }
     }
 }
+
+/*!
+ * Index loads/stores by the objects in their field-expanded points-to sets, i.e.,
+ * the sets BVDataPTAImpl::alias intersects. Loads/stores whose sets contain the
+ * black hole object alias with everything.
+ */
+void MTASVFGBuilder::indexLoadStoreSVFGNodes(BVDataPTAImpl* pta)
+{
+    objToLoads.clear();
+    objToStores.clear();
+    anyObjLoads.clear();
+    anyObjStores.clear();
+    allLoads.clear();
+    allStores.clear();
+
+    for (SVFGNodeSet::const_iterator it = ldnodeSet.begin(), eit = ldnodeSet.end(); it != eit; ++it)
+    {
+        const StmtSVFGNode* n = SVFUtil::cast<StmtSVFGNode>(*it);
+        PointsTo pts;
+        pta->expandFIObjs(pta->getPts(n->getPAGSrcNodeID()), pts);
+        allLoads.set(n->getId());
+        if (pta->containBlackHoleNode(pts))
+            anyObjLoads.set(n->getId());
+        else
+        {
+            for (PointsTo::iterator o = pts.begin(), eo = pts.end(); o != eo; ++o)
+                objToLoads[*o].set(n->getId());
+        }
+    }
+
+    for (SVFGNodeSet::const_iterator it = stnodeSet.begin(), eit = stnodeSet.end(); it != eit; ++it)
+    {
+        const StmtSVFGNode* n = SVFUtil::cast<StmtSVFGNode>(*it);
+        PointsTo pts;
+        pta->expandFIObjs(pta->getPts(n->getPAGDstNodeID()), pts);
+        allStores.set(n->getId());
+        if (pta->containBlackHoleNode(pts))
+            anyObjStores.set(n->getId());
+        else
+        {
+            for (PointsTo::iterator o = pts.begin(), eo = pts.end(); o != eo; ++o)
+                objToStores[*o].set(n->getId());
+        }
+    }
+}
+
+/*!
+ * Loads/stores which may alias with store n, all others are no aliases of n
+ */
+void MTASVFGBuilder::getAliasCandidates(const StmtSVFGNode* n, BVDataPTAImpl* pta, SVFGNodeIDSet& loads, SVFGNodeIDSet& stores)
+{
+    PointsTo pts;
+    pta->expandFIObjs(pta->getPts(n->getPAGDstNodeID()), pts);
+    if (pta->containBlackHoleNode(pts))
+    {
+        loads = allLoads;
+        stores = allStores;
+        return;
+    }
+
+    loads = anyObjLoads;
+    stores = anyObjStores;
+    for (PointsTo::iterator o = pts.begin(), eo = pts.end(); o != eo; ++o)
+    {
+        ObjToSVFGNodesMap::const_iterator lit = objToLoads.find(*o);
+        if (lit != objToLoads.end())
+            loads |= lit->second;
+        ObjToSVFGNodesMap::const_iterator sit = objToStores.find(*o);
+        if (sit != objToStores.end())
+            stores |= sit->second;
+    }
+}
+
 bool MTASVFGBuilder::recordEdge(NodeID id1, NodeID id2, PointsTo pts)
 {
     NodeIDPair pair = std::make_pair(id1, id2);
@@ -148,7 +227,7 @@ void MTASVFGBuilder::performRemovingMHPEdges()
             {
                 IndirectSVFGEdge* e = SVFUtil::cast<IndirectSVFGEdge>(edge);
                 const PointsTo& pts = e->getPointsTo();
-                for (NodeBS::iterator o = remove_pts.begin(), eo = remove_pts.end(); o != eo; ++o)
+                for (PointsTo::iterator o = remove_pts.begin(), eo = remove_pts.end(); o != eo; ++o)
                 {
                     if (const_cast<PointsTo&>(pts).test(*o))
                     {
@@ -658,7 +737,7 @@ void MTASVFGBuilder::readPrecision()
                 PointsTo pts = e->getPointsTo();
                 PointsTo remove_pts;
 
-                for (NodeBS::iterator o = pts.begin(), eo = pts.end(); o != eo; ++o)
+                for (PointsTo::iterator o = pts.begin(), eo = pts.end(); o != eo; ++o)
                 {
                     SVFGNodeIDSet succ1 = getSuccNodes(n1, *o);
                     SVFGNodeIDSet succ2 = getSuccNodes(n2, *o);
@@ -693,59 +772,99 @@ void MTASVFGBuilder::connectMHPEdges(PointerAnalysis* pta)
         pcg= new PCG(pta);
         pcg->analyze();
     }
+    double start = PTAStat::getClk(true);
     collectLoadStoreSVFGNodes();
     recordedges.clear();
     edge2pts.clear();
-
-    /// todo: we ignore rule 2 and 3. but so far I haven't added intra-thread value flow affected by fork
-    /// and inter-thread value flow affected by join
-    for (SVFGNodeSet::const_iterator it1 = stnodeSet.begin(), eit1 =  stnodeSet.end(); it1!=eit1; ++it1)
+    numOfCheckedPairs = 0;
+    u64_t numOfStores = stnodeSet.size();
+    u64_t numOfLoads = ldnodeSet.size();
+    numOfAllPairs = numOfStores * numOfLoads + numOfStores * (numOfStores - 1) / 2;
+
+    /// With the alias check on, pairs which share no object are never connected
+    /// (handleStoreLoad/handleStoreStore), so only pairs within an object's loads/stores are checked.
+    /// This adds exactly the edges of checking all pairs.
+    bool indexed = IndexTDEdge && ADDEDGE_NONSPARSE != AddModelFlag && ADDEDGE_NOALIAS != AddModelFlag
+                   && SVFUtil::isa<BVDataPTAImpl>(pta);
+    if (indexed)
     {
-        const StmtSVFGNode* n1 = SVFUtil::cast<StmtSVFGNode>(*it1);
-        const Instruction* i1 = n1->getInst();
+        BVDataPTAImpl* bvpta = SVFUtil::cast<BVDataPTAImpl>(pta);
+        indexLoadStoreSVFGNodes(bvpta);
+        for (SVFGNodeSet::const_iterator it1 = stnodeSet.begin(), eit1 =  stnodeSet.end(); it1!=eit1; ++it1)
+        {
+            const StmtSVFGNode* n1 = SVFUtil::cast<StmtSVFGNode>(*it1);
+            SVFGNodeIDSet loads, stores;
+            getAliasCandidates(n1, bvpta, loads, stores);
 
-        for (SVFGNodeSet::const_iterator it2 = ldnodeSet.begin(), eit2 = ldnodeSet.end(); it2 != eit2; ++it2)
+            for (SVFGNodeIDSet::iterator it2 = loads.begin(), eit2 = loads.end(); it2 != eit2; ++it2)
+            {
+                handleStoreLoad(n1, SVFUtil::cast<StmtSVFGNode>(svfg->getSVFGNode(*it2)), pta);
+                numOfCheckedPairs++;
+            }
+            /// each unordered pair of stores once
+            for (SVFGNodeIDSet::iterator it2 = stores.begin(), eit2 = stores.end(); it2 != eit2; ++it2)
+            {
+                if (*it2 <= n1->getId())
+                    continue;
+                handleStoreStore(n1, SVFUtil::cast<StmtSVFGNode>(svfg->getSVFGNode(*it2)), pta);
+                numOfCheckedPairs++;
+            }
+        }
+    }
+    else
+    {
+        /// todo: we ignore rule 2 and 3. but so far I haven't added intra-thread value flow affected by fork
+        /// and inter-thread value flow affected by join
+        for (SVFGNodeSet::const_iterator it1 = stnodeSet.begin(), eit1 =  stnodeSet.end(); it1!=eit1; ++it1)
         {
-            const StmtSVFGNode* n2 = SVFUtil::cast<StmtSVFGNode>(*it2);
-            const Instruction* i2 = n2->getInst();
-            if (ADDEDGE_NONSPARSE==AddModelFlag)
+            const StmtSVFGNode* n1 = SVFUtil::cast<StmtSVFGNode>(*it1);
+            const Instruction* i1 = n1->getInst();
+
+            for (SVFGNodeSet::const_iterator it2 = ldnodeSet.begin(), eit2 = ldnodeSet.end(); it2 != eit2; ++it2)
             {
-                if (UsePCG)
+                const StmtSVFGNode* n2 = SVFUtil::cast<StmtSVFGNode>(*it2);
+                const Instruction* i2 = n2->getInst();
+                numOfCheckedPairs++;
+                if (ADDEDGE_NONSPARSE==AddModelFlag)
                 {
-                    if (pcg->mayHappenInParallel(i1, i2) || mhp->mayHappenInParallel(i1, i2))
+                    if (UsePCG)
+                    {
+                        if (pcg->mayHappenInParallel(i1, i2) || mhp->mayHappenInParallel(i1, i2))
+                            handleStoreLoadNonSparse(n1, n2, pta);
+                    }
+                    else
+                    {
                         handleStoreLoadNonSparse(n1, n2, pta);
+                    }
                 }
                 else
                 {
-                    handleStoreLoadNonSparse(n1, n2, pta);
+                    handleStoreLoad(n1, n2, pta);
                 }
             }
-            else
-            {
-                handleStoreLoad(n1, n2, pta);
-            }
-        }
 
-        for (SVFGNodeSet::const_iterator it2 = std::next(it1), eit2 =  stnodeSet.end(); it2!=eit2; ++it2)
-        {
-            const StmtSVFGNode* n2 = SVFUtil::cast<StmtSVFGNode>(*it2);
-            const Instruction* i2 = n2->getInst();
-            if (ADDEDGE_NONSPARSE == AddModelFlag)
+            for (SVFGNodeSet::const_iterator it2 = std::next(it1), eit2 =  stnodeSet.end(); it2!=eit2; ++it2)
             {
-                if (UsePCG)
+                const StmtSVFGNode* n2 = SVFUtil::cast<StmtSVFGNode>(*it2);
+                const Instruction* i2 = n2->getInst();
+                numOfCheckedPairs++;
+                if (ADDEDGE_NONSPARSE == AddModelFlag)
                 {
-                    if(pcg->mayHappenInParallel(i1, i2) || mhp->mayHappenInParallel(i1, i2))
+                    if (UsePCG)
+                    {
+                        if(pcg->mayHappenInParallel(i1, i2) || mhp->mayHappenInParallel(i1, i2))
+                            handleStoreStoreNonSparse(n1, n2, pta);
+                    }
+                    else
+                    {
                         handleStoreStoreNonSparse(n1, n2, pta);
+                    }
                 }
                 else
                 {
-                    handleStoreStoreNonSparse(n1, n2, pta);
+                    handleStoreStore(n1, n2, pta);
                 }
             }
-            else
-            {
-                handleStoreStore(n1, n2, pta);
-            }
         }
     }
 
@@ -755,6 +874,9 @@ void MTASVFGBuilder::connectMHPEdges(PointerAnalysis* pta)
         DBOUT(DMTA,outs()<<"Read precision edge removing \n");
         readPrecision();
     }
+
+    double end = PTAStat::getClk(true);
+    connectMHPEdgesTime = (end - start) / TIMEINTERVAL;
 }
 
 /*!
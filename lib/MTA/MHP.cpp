@@ -11,6 +11,7 @@
 #include "MTA/LockAnalysis.h"
 #include "MTA/MTAResultValidator.h"
 #include "Util/SVFUtil.h"
+#include "Util/Parallel.h"
 
 
 using namespace SVF;
@@ -19,6 +20,10 @@ using namespace SVFUtil;
 
 static llvm::cl::opt<bool> PrintInterLev("print-interlev", llvm::cl::init(false),llvm::cl::desc("Print Thread Interleaving Results"));
 static llvm::cl::opt<bool> DoLockAnalysis("lockanalysis", llvm::cl::init(true),llvm::cl::desc("Run Lock Analysis"));
+static llvm::cl::opt<u32_t> MHPThreads("mhp-threads", llvm::cl::init(1),
+        llvm::cl::desc("Number of threads analysing thread interleavings concurrently (0: all hardware threads)"));
+static llvm::cl::opt<bool> MHPRecheck("mhp-recheck", llvm::cl::init(true),
+        llvm::cl::desc("Re-check the fixpoint of the interleavings merged from parallel workers"));
 
 
 /*!
@@ -80,11 +85,25 @@ private:
 /*!
  * Constructor
  */
-MHP::MHP(TCT* t) :tcg(t->getThreadCallGraph()),tct(t),numOfTotalQueries(0),numOfMHPQueries(0),
-    interleavingTime(0),interleavingQueriesTime(0)
+MHP::MHP(TCT* t) :tcg(t->getThreadCallGraph()),tct(t),sharedMutex(NULL),numOfTotalQueries(0),numOfMHPQueries(0),
+    numOfInterleavingUpdates(0),numOfInterleavingThreads(1),numOfRecheckUpdates(0),forkJoinTime(0),
+    interleavingTime(0),interleavingMergeTime(0),interleavingRecheckTime(0),interleavingQueriesTime(0)
 {
+    DOTIMESTAT(double fjaStart = PTAStat::getClk(true));
     fja = new ForkJoinAnalysis(tct);
     fja->analyzeForkJoinPair();
+    DOTIMESTAT(double fjaEnd = PTAStat::getClk(true));
+    DOTIMESTAT(forkJoinTime += (fjaEnd - fjaStart) / TIMEINTERVAL);
+}
+
+/*!
+ * Constructor of a worker
+ */
+MHP::MHP(TCT* t, ForkJoinAnalysis* f, std::mutex* m) :tcg(t->getThreadCallGraph()),tct(t),fja(f),sharedMutex(m),
+    numOfTotalQueries(0),numOfMHPQueries(0),numOfInterleavingUpdates(0),numOfInterleavingThreads(1),
+    numOfRecheckUpdates(0),forkJoinTime(0),interleavingTime(0),interleavingMergeTime(0),interleavingRecheckTime(0),
+    interleavingQueriesTime(0)
+{
 }
 
 /*!
@@ -92,7 +111,9 @@ MHP::MHP(TCT* t) :tcg(t->getThreadCallGraph()),tct(t),numOfTotalQueries(0),numOf
  */
 MHP::~MHP()
 {
-    delete fja;
+    /// workers share the fork-join analysis of their master
+    if(sharedMutex == NULL)
+        delete fja;
 }
 
 /*!
@@ -115,69 +136,174 @@ void MHP::analyze()
  */
 void MHP::analyzeInterleaving()
 {
+    u32_t numOfThreads = ParallelUtil::getNumOfThreads(MHPThreads);
+    if(numOfThreads > 1 && tct->getTCTNodeNum() > 1)
+    {
+        analyzeInterleavingInParallel(numOfThreads);
+    }
+    else
+    {
+        for(TCT::const_iterator it = tct->begin(), eit = tct->end(); it!=eit; ++it)
+            analyzeRootThread(it->first);
+    }
+
+    /// update non-candidate functions' interleaving
+    updateNonCandidateFunInterleaving();
+
+
+    if(PrintInterLev)
+        printInterleaving();
+
+    validateResults();
+}
+
+/*!
+ * Analyze thread interleaving in parallel.
+ *
+ * Every interleaving set is a union of thread IDs, each ID being added at the
+ * statements seeded for its own TCT node and removed only at join sites, so the
+ * propagation of one TCT node does not depend on the others. Workers thus solve
+ * disjoint sets of TCT nodes independently, their results are merged pairwise
+ * in parallel and the merged sets are re-checked to be a fixpoint.
+ */
+void MHP::analyzeInterleavingInParallel(u32_t numOfThreads)
+{
+    std::vector<NodeID> roots;
     for(TCT::const_iterator it = tct->begin(), eit = tct->end(); it!=eit; ++it)
+        roots.push_back(it->first);
+    if(numOfThreads > roots.size())
+        numOfThreads = roots.size();
+    numOfInterleavingThreads = numOfThreads;
+
+    std::mutex mutex;
+    std::vector<MHP*> workers;
+    for(u32_t i = 0; i < numOfThreads; i++)
+        workers.push_back(new MHP(tct, fja, &mutex));
+
+    ParallelUtil::parallelFor(roots.size(), numOfThreads, [&](u32_t i, u32_t tid)
     {
-        const CxtThread& ct = it->second->getCxtThread();
-        NodeID rootTid = it->first;
-        const Function* routine = tct->getStartRoutineOfCxtThread(ct);
-        CxtThreadStmt rootcts(rootTid,ct.getContext(),&(routine->getEntryBlock().front()));
+        workers[tid]->analyzeRootThread(roots[i]);
+    }, 1);
+
+    DOTIMESTAT(double mergeStart = PTAStat::getClk(true));
+    /// merge worker i+step into worker i, halving the number of results each round
+    for(u32_t step = 1; step < numOfThreads; step *= 2)
+    {
+        ParallelUtil::parallelFor((numOfThreads + 2 * step - 1) / (2 * step), numOfThreads, [&](u32_t i, u32_t)
+        {
+            u32_t dst = i * 2 * step;
+            if(dst + step < numOfThreads)
+                workers[dst]->mergeInterleaving(*workers[dst + step]);
+        }, 1);
+    }
+    mergeInterleaving(*workers[0]);
+    for(MHP* worker : workers)
+    {
+        numOfInterleavingUpdates += worker->numOfInterleavingUpdates;
+        delete worker;
+    }
+    DOTIMESTAT(double mergeEnd = PTAStat::getClk(true));
+    DOTIMESTAT(interleavingMergeTime += (mergeEnd - mergeStart) / TIMEINTERVAL);
+
+    if(MHPRecheck)
+    {
+        DOTIMESTAT(double recheckStart = PTAStat::getClk(true));
+        numOfRecheckUpdates += recheckInterleaving();
+        DOTIMESTAT(double recheckEnd = PTAStat::getClk(true));
+        DOTIMESTAT(interleavingRecheckTime += (recheckEnd - recheckStart) / TIMEINTERVAL);
+        if(numOfRecheckUpdates)
+            writeWrnMsg("MHP: parallel interleaving analysis missed " + std::to_string(numOfRecheckUpdates) + " updates");
+    }
+}
+
+/*!
+ * Merge the interleavings computed by a worker
+ */
+void MHP::mergeInterleaving(const MHP& worker)
+{
+    for(ThreadStmtToThreadInterleav::const_iterator it = worker.threadStmtToTheadInterLeav.begin(),
+            eit = worker.threadStmtToTheadInterLeav.end(); it!=eit; ++it)
+        threadStmtToTheadInterLeav[it->first] |= it->second;
+    for(InstToThreadStmtSetMap::const_iterator it = worker.instToTSMap.begin(), eit = worker.instToTSMap.end(); it!=eit; ++it)
+        instToTSMap[it->first].insert(it->second.begin(), it->second.end());
+}
+
+/*!
+ * Propagate once more from every statement
+ */
+u32_t MHP::recheckInterleaving()
+{
+    u32_t updates = numOfInterleavingUpdates;
+    for(ThreadStmtToThreadInterleav::const_iterator it = threadStmtToTheadInterLeav.begin(),
+            eit = threadStmtToTheadInterLeav.end(); it!=eit; ++it)
+        pushToCTSWorkList(it->first);
+    solveCTSWorkList(0);
+    return numOfInterleavingUpdates - updates;
+}
+
+/*!
+ * Analyze the interleaving of a TCT node
+ */
+void MHP::analyzeRootThread(NodeID rootTid)
+{
+    const CxtThread& ct = tct->getTCTNode(rootTid)->getCxtThread();
+    const Function* routine = tct->getStartRoutineOfCxtThread(ct);
+    CxtThreadStmt rootcts(rootTid,ct.getContext(),&(routine->getEntryBlock().front()));
 
-        addInterleavingThread(rootcts,rootTid);
-        updateAncestorThreads(rootTid);
-        updateSiblingThreads(rootTid);
+    addInterleavingThread(rootcts,rootTid);
+    updateAncestorThreads(rootTid);
+    updateSiblingThreads(rootTid);
 
-        while(!cxtStmtList.empty())
+    solveCTSWorkList(rootTid);
+}
+
+/*!
+ * Process the statements in the worklist
+ */
+void MHP::solveCTSWorkList(NodeID rootTid)
+{
+    while(!cxtStmtList.empty())
+    {
+        CxtThreadStmt cts = popFromCTSWorkList();
+        const Instruction* curInst = cts.getStmt();
+        DBOUT(DMTA,outs() << "-----\nMHP analysis root thread: " << rootTid << " ");
+        DBOUT(DMTA,cts.dump());
+        DBOUT(DMTA,outs() << "current thread interleaving: < ");
+        DBOUT(DMTA,dumpSet(getInterleavingThreads(cts)));
+        DBOUT(DMTA,outs() << " >\n-----\n");
+
+        /// handle non-candidate function
+        if (!tct->isCandidateFun(curInst->getParent()->getParent()))
+        {
+            handleNonCandidateFun(cts);
+        }
+        /// handle candidate function
+        else
         {
-            CxtThreadStmt cts = popFromCTSWorkList();
-            const Instruction* curInst = cts.getStmt();
-            DBOUT(DMTA,outs() << "-----\nMHP analysis root thread: " << rootTid << " ");
-            DBOUT(DMTA,cts.dump());
-            DBOUT(DMTA,outs() << "current thread interleaving: < ");
-            DBOUT(DMTA,dumpSet(getInterleavingThreads(cts)));
-            DBOUT(DMTA,outs() << " >\n-----\n");
-
-            /// handle non-candidate function
-            if (!tct->isCandidateFun(curInst->getParent()->getParent()))
+            if(isTDFork(curInst))
             {
-                handleNonCandidateFun(cts);
+                handleFork(cts,rootTid);
             }
-            /// handle candidate function
-            else
+            else if(isTDJoin(curInst))
             {
-                if(isTDFork(curInst))
-                {
-                    handleFork(cts,rootTid);
-                }
-                else if(isTDJoin(curInst))
-                {
-                    handleJoin(cts,rootTid);
-                }
-                else if(SVFUtil::isa<CallInst>(curInst) && !isExtCall(curInst))
-                {
-                    handleCall(cts,rootTid);
-                    if(!tct->isCandidateFun(getCallee(curInst)))
-                        handleIntra(cts);
-                }
-                else if(SVFUtil::isa<ReturnInst>(curInst))
-                {
-                    handleRet(cts);
-                }
-                else
-                {
+                handleJoin(cts,rootTid);
+            }
+            else if(SVFUtil::isa<CallInst>(curInst) && !isExtCall(curInst))
+            {
+                handleCall(cts,rootTid);
+                if(!tct->isCandidateFun(getCallee(curInst)))
                     handleIntra(cts);
-                }
+            }
+            else if(SVFUtil::isa<ReturnInst>(curInst))
+            {
+                handleRet(cts);
+            }
+            else
+            {
+                handleIntra(cts);
             }
         }
     }
-
-    /// update non-candidate functions' interleaving
-    updateNonCandidateFunInterleaving();
-
-
-    if(PrintInterLev)
-        printInterleaving();
-
-    validateResults();
 }
 
 /*!
@@ -517,6 +643,12 @@ bool MHP::isMustJoin(NodeID curTid, const Instruction* joinsite)
 NodeBS MHP::getDirAndIndJoinedTid(const CallStrCxt& cxt, const Instruction* call)
 {
     CxtStmt cs(cxt,call);
+    /// the joined threads are computed on demand and cached by fja
+    if(sharedMutex)
+    {
+        std::lock_guard<std::mutex> lock(*sharedMutex);
+        return fja->getDirAndIndJoinedTid(cs);
+    }
     return fja->getDirAndIndJoinedTid(cs);
 }
 
@@ -0,0 +1,413 @@
+/*
+ * MHPIndex.cpp
+ *
+ * Constant-time may-happen-in-parallel and common-lock queries, see MHPIndex.h
+ */
+
+#include "MTA/MHPIndex.h"
+#include "MTA/LockAnalysis.h"
+#include "MemoryModel/PTAStat.h"
+#include "Util/SVFUtil.h"
+
+#include <algorithm>
+
+using namespace SVF;
+using namespace SVFUtil;
+
+static llvm::cl::opt<u32_t> MaxDenseMHPClasses("mhp-index-dense", llvm::cl::init(4096),
+        llvm::cl::desc("Maximum number of MHP classes whose relation is cached in a dense matrix"));
+
+size_t MHPIndex::KeyHash::operator()(const std::vector<u64_t>& key) const
+{
+    size_t h = key.size();
+    for (u64_t k : key)
+        h ^= std::hash<u64_t>()(k) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    return h;
+}
+
+/*!
+ * Whether two sorted vectors have a common element
+ */
+static inline bool intersects(const std::vector<u64_t>& v1, const std::vector<u64_t>& v2)
+{
+    std::vector<u64_t>::const_iterator it1 = v1.begin(), it2 = v2.begin();
+    while (it1 != v1.end() && it2 != v2.end())
+    {
+        if (*it1 < *it2)
+            ++it1;
+        else if (*it2 < *it1)
+            ++it2;
+        else
+            return true;
+    }
+    return false;
+}
+
+/*!
+ * Constructor
+ */
+MHPIndex::MHPIndex(MHP* m, LockAnalysis* l) : numOfQueries(0), buildTime(0), mhp(m), lsa(l), accessesBuilt(false)
+{
+    double start = PTAStat::getClk(true);
+    buildMHPClasses();
+    double end = PTAStat::getClk(true);
+    buildTime += (end - start) / TIMEINTERVAL;
+}
+
+/*!
+ * Group the instructions by the (thread, interleaving thread) pairs of their thread statements.
+ *
+ * i1 and i2 may happen in parallel iff a statement of i1 in thread t1 interleaves with t2
+ * and a statement of i2 in thread t2 interleaves with t1 (t1 != t2), or both run in the
+ * same multi-forked thread t. Recording (t1, t2) for the former and (t, t) for the latter,
+ * i1 and i2 may happen in parallel iff the pairs of i1 meet the transposed pairs of i2.
+ */
+void MHPIndex::buildMHPClasses()
+{
+    TCT* tct = mhp->getTCT();
+    /// a pair (t1, t2) is t1 * n + t2, which does not fit in 32 bits for many threads
+    u64_t n = tct->getTCTNodeNum();
+    ClassMap pairsToClass;
+
+    SVFModule* module = mhp->getThreadCallGraph()->getModule();
+    for (SVFModule::iterator F = module->begin(), E = module->end(); F != E; ++F)
+    {
+        const Function* fun = *F;
+        if (isExtCall(fun))
+            continue;
+        for (const_inst_iterator II = inst_begin(fun), EE = inst_end(fun); II != EE; ++II)
+        {
+            const Instruction* inst = &*II;
+            if (!mhp->hasThreadStmtSet(inst))
+                continue;
+
+            std::vector<u64_t> pairs;
+            const MHP::CxtThreadStmtSet& tsSet = mhp->getThreadStmtSet(inst);
+            for (MHP::CxtThreadStmtSet::const_iterator it = tsSet.begin(), eit = tsSet.end(); it != eit; ++it)
+            {
+                NodeID t = it->getTid();
+                const NodeBS& interleav = mhp->getInterleavingThreads(*it);
+                for (NodeBS::iterator tit = interleav.begin(), etit = interleav.end(); tit != etit; ++tit)
+                {
+                    if (*tit != t)
+                        pairs.push_back(t * n + *tit);
+                }
+                if (tct->getTCTNode(t)->isMultiforked())
+                    pairs.push_back(t * n + t);
+            }
+            std::sort(pairs.begin(), pairs.end());
+            pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+
+            ClassMap::const_iterator cit = pairsToClass.find(pairs);
+            if (cit != pairsToClass.end())
+            {
+                instToMHPClass[inst] = cit->second;
+                continue;
+            }
+
+            u32_t c = mhpClasses.size();
+            pairsToClass[pairs] = c;
+            instToMHPClass[inst] = c;
+            std::vector<u64_t> transposed;
+            for (u64_t pair : pairs)
+                transposed.push_back((pair % n) * n + pair / n);
+            std::sort(transposed.begin(), transposed.end());
+            mhpClasses.push_back(pairs);
+            mhpClassesT.push_back(transposed);
+        }
+    }
+
+    if (mhpClasses.size() <= MaxDenseMHPClasses)
+        mhpDense.assign(mhpClasses.size() * mhpClasses.size(), 0);
+}
+
+/*!
+ * Whether instructions of two MHP classes may happen in parallel
+ */
+bool MHPIndex::mhpRelation(u32_t c1, u32_t c2)
+{
+    if (!mhpDense.empty())
+    {
+        unsigned char& rel = mhpDense[c1 * mhpClasses.size() + c2];
+        if (rel == 0)
+        {
+            rel = intersects(mhpClasses[c1], mhpClassesT[c2]) ? 2 : 1;
+            mhpDense[c2 * mhpClasses.size() + c1] = rel;
+        }
+        return rel == 2;
+    }
+
+    u64_t key = c1 < c2 ? ((u64_t) c1 << 32) | c2 : ((u64_t) c2 << 32) | c1;
+    PairToBoolMap::const_iterator it = mhpSparse.find(key);
+    if (it != mhpSparse.end())
+        return it->second;
+    bool rel = intersects(mhpClasses[c1], mhpClassesT[c2]);
+    mhpSparse[key] = rel;
+    return rel;
+}
+
+/*!
+ * Lock class of an instruction.
+ *
+ * LockAnalysis::isProtectedByCommonLock only depends on the intra-procedural locks of
+ * the two instructions and on the sets of context-sensitive locks held at their
+ * context-sensitive statements, which identify the class.
+ */
+u32_t MHPIndex::getLockClass(const Instruction* inst)
+{
+    Map<const Instruction*, u32_t>::const_iterator it = instToLockClass.find(inst);
+    if (it != instToLockClass.end())
+        return it->second;
+
+    std::vector<u64_t> key;
+    bool intra = lsa->isInsideIntraLock(inst);
+    bool cond = lsa->isInsideCondIntraLock(inst);
+    key.push_back(intra);
+    key.push_back(cond);
+    if (intra && !cond)
+    {
+        const LockAnalysis::InstSet& ciLocks = lsa->getIntraLockSet(inst);
+        std::vector<u64_t> locks;
+        for (const Instruction* lock : ciLocks)
+            locks.push_back((u64_t) lock);
+        std::sort(locks.begin(), locks.end());
+        key.push_back(locks.size());
+        key.insert(key.end(), locks.begin(), locks.end());
+    }
+    else
+        key.push_back(0);
+
+    if (lsa->hasCxtStmtfromInst(inst))
+    {
+        /// 0 stands for a statement without lock set
+        std::vector<u64_t> lockSets;
+        const LockAnalysis::CxtStmtSet& ctsSet = lsa->getCxtStmtfromInst(inst);
+        for (LockAnalysis::CxtStmtSet::const_iterator cit = ctsSet.begin(), ecit = ctsSet.end(); cit != ecit; ++cit)
+        {
+            if (!lsa->hasCxtLockfromCxtStmt(*cit))
+            {
+                lockSets.push_back(0);
+                continue;
+            }
+            std::vector<u64_t> locks;
+            const LockAnalysis::CxtLockSet& cxtLocks = lsa->getCxtLockfromCxtStmt(*cit);
+            for (LockAnalysis::CxtLockSet::const_iterator lit = cxtLocks.begin(), elit = cxtLocks.end(); lit != elit; ++lit)
+            {
+                Map<CxtStmt, u32_t>::const_iterator idIt = cxtLockIds.find(*lit);
+                if (idIt == cxtLockIds.end())
+                    idIt = cxtLockIds.insert(std::make_pair(*lit, (u32_t) cxtLockIds.size())).first;
+                locks.push_back(idIt->second);
+            }
+            std::sort(locks.begin(), locks.end());
+            ClassMap::const_iterator sit = lockSetIds.find(locks);
+            if (sit == lockSetIds.end())
+                sit = lockSetIds.insert(std::make_pair(locks, (u32_t) lockSetIds.size() + 1)).first;
+            lockSets.push_back(sit->second);
+        }
+        std::sort(lockSets.begin(), lockSets.end());
+        lockSets.erase(std::unique(lockSets.begin(), lockSets.end()), lockSets.end());
+        key.push_back(lockSets.size() + 1);
+        key.insert(key.end(), lockSets.begin(), lockSets.end());
+    }
+    else
+        key.push_back(0);
+
+    u32_t c;
+    ClassMap::const_iterator cit = lockClassIds.find(key);
+    if (cit == lockClassIds.end())
+    {
+        c = lockReps.size();
+        lockClassIds[key] = c;
+        lockReps.push_back(std::make_pair(inst, (const Instruction*) NULL));
+    }
+    else
+    {
+        c = cit->second;
+        if (lockReps[c].second == NULL)
+            lockReps[c].second = inst;
+    }
+    instToLockClass[inst] = c;
+    return c;
+}
+
+/*!
+ * Whether instructions of two lock classes are protected by a common lock
+ */
+bool MHPIndex::lockRelation(u32_t c1, u32_t c2)
+{
+    u64_t key = c1 < c2 ? ((u64_t) c1 << 32) | c2 : ((u64_t) c2 << 32) | c1;
+    PairToBoolMap::const_iterator it = lockCache.find(key);
+    if (it != lockCache.end())
+        return it->second;
+
+    /// two distinct members stand for the class when c1 == c2; a class with one member
+    /// so far is answered for that member with itself, which is not cached as it may
+    /// differ from the answer for two distinct members once another one joins
+    const Instruction* i1 = lockReps[c1].first;
+    const Instruction* i2 = c1 != c2 ? lockReps[c2].first : lockReps[c2].second;
+    if (i2 == NULL)
+        return lsa->isProtectedByCommonLock(i1, i1);
+    bool rel = lsa->isProtectedByCommonLock(i1, i2);
+    lockCache[key] = rel;
+    return rel;
+}
+
+/*!
+ * Whether two instructions are protected by a common lock
+ */
+bool MHPIndex::isProtectedByCommonLock(const Instruction* i1, const Instruction* i2)
+{
+    if (lsa == NULL)
+        return false;
+    /// a statement is never compared with itself under the same context
+    if (i1 == i2)
+        return lsa->isProtectedByCommonLock(i1, i2);
+    return lockRelation(getLockClass(i1), getLockClass(i2));
+}
+
+/*!
+ * Collect the loads and stores of each object run by some thread
+ */
+void MHPIndex::buildAccesses()
+{
+    PointerAnalysis* pta = mhp->getTCT()->getPTA();
+    PAG* pag = pta->getPAG();
+    SVFModule* module = mhp->getThreadCallGraph()->getModule();
+    for (SVFModule::iterator F = module->begin(), E = module->end(); F != E; ++F)
+    {
+        const Function* fun = *F;
+        if (isExtCall(fun))
+            continue;
+        for (const_inst_iterator II = inst_begin(fun), EE = inst_end(fun); II != EE; ++II)
+        {
+            const Instruction* inst = &*II;
+            if (getMHPClass(inst) == NoClass)
+                continue;
+
+            Access access;
+            access.inst = inst;
+            const Value* ptr = NULL;
+            if (const LoadInst* load = SVFUtil::dyn_cast<LoadInst>(inst))
+            {
+                ptr = load->getPointerOperand();
+                access.isWrite = false;
+            }
+            else if (const StoreInst* store = SVFUtil::dyn_cast<StoreInst>(inst))
+            {
+                ptr = store->getPointerOperand();
+                access.isWrite = true;
+            }
+            if (ptr == NULL || !pag->hasValueNode(ptr))
+                continue;
+
+            const PointsTo& pts = pta->getPts(pag->getValueNode(ptr));
+            for (PointsTo::iterator it = pts.begin(), eit = pts.end(); it != eit; ++it)
+                objToAccesses[*it].push_back(access);
+        }
+    }
+    accessesBuilt = true;
+}
+
+/*!
+ * Stream the racing pairs of accesses to obj.
+ * Accesses with the same MHP class, lock class and kind are grouped, so that the
+ * relations are checked once per pair of groups.
+ */
+u32_t MHPIndex::forEachRacingPair(NodeID obj, RacingPairVisitor visit)
+{
+    if (!accessesBuilt)
+        buildAccesses();
+
+    Map<NodeID, AccessVec>::const_iterator ait = objToAccesses.find(obj);
+    if (ait == objToAccesses.end())
+        return 0;
+
+    typedef std::vector<const Instruction*> InstVec;
+    struct Group
+    {
+        u32_t mhpClass;
+        u32_t lockClass;
+        bool isWrite;
+        InstVec insts;
+    };
+    std::vector<Group> groups;
+    ClassMap groupIds;
+    for (const Access& access : ait->second)
+    {
+        u32_t lockClass = lsa ? getLockClass(access.inst) : 0;
+        std::vector<u64_t> key = {getMHPClass(access.inst), lockClass, access.isWrite};
+        ClassMap::const_iterator git = groupIds.find(key);
+        if (git == groupIds.end())
+        {
+            git = groupIds.insert(std::make_pair(key, (u32_t) groups.size())).first;
+            groups.push_back(Group());
+            groups.back().mhpClass = key[0];
+            groups.back().lockClass = lockClass;
+            groups.back().isWrite = access.isWrite;
+        }
+        groups[git->second].insts.push_back(access.inst);
+    }
+
+    u32_t numOfPairs = 0;
+    for (u32_t g1 = 0; g1 < groups.size(); g1++)
+    {
+        for (u32_t g2 = g1; g2 < groups.size(); g2++)
+        {
+            const Group& grp1 = groups[g1];
+            const Group& grp2 = groups[g2];
+            if (!grp1.isWrite && !grp2.isWrite)
+                continue;
+            numOfQueries++;
+            if (!mhpRelation(grp1.mhpClass, grp2.mhpClass))
+                continue;
+            bool locked = lsa && lockRelation(grp1.lockClass, grp2.lockClass);
+
+            for (u32_t i = 0; i < grp1.insts.size(); i++)
+            {
+                for (u32_t j = g1 == g2 ? i : 0; j < grp2.insts.size(); j++)
+                {
+                    const Instruction* i1 = grp1.insts[i];
+                    const Instruction* i2 = grp2.insts[j];
+                    if (i1 == i2 ? isProtectedByCommonLock(i1, i2) : locked)
+                        continue;
+                    numOfPairs++;
+                    if (!visit(i1, i2))
+                        return numOfPairs;
+                }
+            }
+        }
+    }
+    return numOfPairs;
+}
+
+/*!
+ * Number of MHP pairs between two sets of instructions
+ */
+u64_t MHPIndex::countMHPPairs(const MHP::InstSet& set1, const MHP::InstSet& set2)
+{
+    Map<u32_t, u64_t> classSize1, classSize2;
+    for (const Instruction* inst : set1)
+    {
+        u32_t c = getMHPClass(inst);
+        if (c != NoClass)
+            classSize1[c]++;
+    }
+    for (const Instruction* inst : set2)
+    {
+        u32_t c = getMHPClass(inst);
+        if (c != NoClass)
+            classSize2[c]++;
+    }
+
+    u64_t numOfPairs = 0;
+    for (Map<u32_t, u64_t>::const_iterator it1 = classSize1.begin(), eit1 = classSize1.end(); it1 != eit1; ++it1)
+    {
+        for (Map<u32_t, u64_t>::const_iterator it2 = classSize2.begin(), eit2 = classSize2.end(); it2 != eit2; ++it2)
+        {
+            numOfQueries++;
+            if (mhpRelation(it1->first, it2->first))
+                numOfPairs += it1->second * it2->second;
+        }
+    }
+    return numOfPairs;
+}
@@ -59,7 +59,14 @@ bool MTA::runOnModule(SVFModule* module)
     modulePass = this;
 
     MHP* mhp = computeMHP(module);
+
+    DOTIMESTAT(double lockStart = stat->getClk());
     LockAnalysis* lsa = computeLocksets(mhp->getTCT());
+    DOTIMESTAT(double lockEnd = stat->getClk());
+    DOTIMESTAT(stat->LockTime += (lockEnd - lockStart) / TIMEINTERVAL);
+
+    if (mhp->getTCT()->getPTA()->printStat())
+        stat->performPhaseTimeStat(mhp);
 
 
 
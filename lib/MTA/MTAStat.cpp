@@ -8,6 +8,7 @@
 #include "MTA/MTAStat.h"
 #include "MTA/TCT.h"
 #include "MTA/MHP.h"
+#include "MTA/MHPIndex.h"
 #include "MTA/LockAnalysis.h"
 #include "MTA/FSMPTA.h"
 #include "MTA/MTAAnnotator.h"
@@ -91,6 +92,8 @@ void MTAStat::performTCTStat(TCT* tct)
 void MTAStat::performMHPPairStat(MHP* mhp, LockAnalysis* lsa)
 {
 
+    PTNumStatMap.clear();
+    timeStatMap.clear();
     if(AllPairMHP)
     {
         InstSet instSet1;
@@ -119,19 +122,16 @@ void MTAStat::performMHPPairStat(MHP* mhp, LockAnalysis* lsa)
         }
 
 
-        for(InstSet::const_iterator it1 = instSet1.begin(), eit1 = instSet1.end(); it1!=eit1; ++it1)
-        {
-            for(InstSet::const_iterator it2 = instSet2.begin(), eit2 = instSet2.end(); it2!=eit2; ++it2)
-            {
-                mhp->mayHappenInParallel(*it1,*it2);
-            }
-        }
+        /// count the pairs per MHP class instead of querying every pair
+        MHPIndex index(mhp, lsa);
+        mhp->numOfTotalQueries += instSet1.size() * instSet2.size();
+        mhp->numOfMHPQueries += index.countMHPPairs(instSet1, instSet2);
+        PTNumStatMap["NumOfMHPClasses"] = index.getNumOfMHPClasses();
+        timeStatMap["MHPIndexTime"] = index.buildTime;
     }
 
 
     generalNumMap.clear();
-    PTNumStatMap.clear();
-    timeStatMap.clear();
     PTNumStatMap["TotalMHPQueries"] = mhp->numOfTotalQueries;
     PTNumStatMap["NumOfMHPPairs"] = mhp->numOfMHPQueries;
     PTNumStatMap["TotalLockQueries"] = lsa->numOfTotalQueries;
@@ -140,17 +140,45 @@ void MTAStat::performMHPPairStat(MHP* mhp, LockAnalysis* lsa)
     PTNumStatMap["NumOfNewSVFGEdges"] = MTASVFGBuilder::numOfNewSVFGEdges;
     PTNumStatMap["NumOfRemovedEdges"] = MTASVFGBuilder::numOfRemovedSVFGEdges;
     PTNumStatMap["NumOfRemovedPTS"] = MTASVFGBuilder::numOfRemovedPTS;
+    PTNumStatMap["NumOfTDEdgeCheckedPairs"] = MTASVFGBuilder::numOfCheckedPairs;
+    PTNumStatMap["NumOfTDEdgeAllPairs"] = MTASVFGBuilder::numOfAllPairs;
+    timeStatMap["TDEdgeTime"] = MTASVFGBuilder::connectMHPEdgesTime;
     timeStatMap["InterlevAnaTime"] = mhp->interleavingTime;
     timeStatMap["LockAnaTime"] = lsa->lockTime;
     timeStatMap["InterlevQueryTime"] = mhp->interleavingQueriesTime;
     timeStatMap["LockQueryTime"] = lsa->lockQueriesTime;
     timeStatMap["MHPAnalysisTime"] = MHPTime;
+    timeStatMap["LockAnalysisTime"] = LockTime;
     timeStatMap["MFSPTATime"] = FSMPTATime;
 
     std::cout << "\n****MHP Stmt Pairs Statistics****\n";
     PTAStat::printStat();
 }
 
+/*!
+ * Time of each phase of the MHP and lock analyses
+ */
+void MTAStat::performPhaseTimeStat(MHP* mhp)
+{
+
+    generalNumMap.clear();
+    PTNumStatMap.clear();
+    timeStatMap.clear();
+    PTNumStatMap["InterlevThreads"] = mhp->numOfInterleavingThreads;
+    PTNumStatMap["InterlevUpdates"] = mhp->numOfInterleavingUpdates;
+    PTNumStatMap["InterlevRecheckUpdates"] = mhp->numOfRecheckUpdates;
+    timeStatMap["BuildingTCTTime"] = TCTTime;
+    timeStatMap["ForkJoinAnaTime"] = mhp->forkJoinTime;
+    timeStatMap["InterlevAnaTime"] = mhp->interleavingTime;
+    timeStatMap["InterlevMergeTime"] = mhp->interleavingMergeTime;
+    timeStatMap["InterlevRecheckTime"] = mhp->interleavingRecheckTime;
+    timeStatMap["MHPAnalysisTime"] = MHPTime;
+    timeStatMap["LockAnaTime"] = LockTime;
+
+    std::cout << "\n****MTA Phase Time Statistics****\n";
+    PTAStat::printStat();
+}
+
 void MTAStat::performAnnotationStat(MTAAnnotator* anno)
 {
 
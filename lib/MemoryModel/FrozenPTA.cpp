@@ -0,0 +1,140 @@
+//===- FrozenPTA.cpp -- Immutable snapshot of pointer analysis results -------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * FrozenPTA.cpp
+ *
+ * Immutable snapshot of pointer analysis results, see FrozenPTA.h
+ */
+
+#include "MemoryModel/FrozenPTA.h"
+#include "MemoryModel/PTAStat.h"
+
+using namespace SVF;
+using namespace SVFUtil;
+
+/*!
+ * Copy the points-to sets of all PAG nodes and the call graph.
+ *
+ * Everything the analysis would compute lazily on a query (fields of objects,
+ * empty sets of unknown pointers) is computed here, while only one thread runs.
+ */
+FrozenPTA::FrozenPTA(PointerAnalysis* pta) : buildTime(0), pag(pta->getPAG())
+{
+    double start = PTAStat::getClk(true);
+
+    NodeID maxId = 0;
+    for (PAG::iterator it = pag->begin(), eit = pag->end(); it != eit; ++it)
+        maxId = std::max(maxId, it->first + 1);
+
+    const PointsToID empty = PersistentPointsToCache<PointsTo>::emptyPointsToId();
+    nodeToPts.assign(maxId, empty);
+    nodeToExpandedPts.assign(maxId, empty);
+    Map<PointsToID, PointsToID> expandedOf;
+    expandedOf[empty] = empty;
+
+    for (PAG::iterator it = pag->begin(), eit = pag->end(); it != eit; ++it)
+    {
+        NodeID id = it->first;
+        const PointsTo& pts = pta->getPts(id);
+        PointsToID ptsId = ptsCache.emplacePts(pts);
+        nodeToPts[id] = ptsId;
+
+        /// field expansion as in BVDataPTAImpl::expandFIObjs, once per distinct set
+        Map<PointsToID, PointsToID>::const_iterator eIt = expandedOf.find(ptsId);
+        if (eIt == expandedOf.end())
+        {
+            PointsTo expanded = pts;
+            for (PointsTo::iterator pit = pts.begin(), epit = pts.end(); pit != epit; ++pit)
+            {
+                if (pag->getBaseObjNode(*pit) == *pit || pta->isFieldInsensitive(*pit))
+                    expanded |= pag->getAllFieldsObjNode(*pit);
+            }
+            eIt = expandedOf.insert(std::make_pair(ptsId, ptsCache.emplacePts(expanded))).first;
+        }
+        nodeToExpandedPts[id] = eIt->second;
+    }
+
+    mayAliasAll.assign(ptsCache.getNumOfUniquePts(), false);
+    for (PointsToID i = 0; i < ptsCache.getNumOfUniquePts(); ++i)
+        mayAliasAll[i] = pta->containBlackHoleNode(ptsCache.getActualPts(i));
+
+    PTACallGraph* callgraph = pta->getPTACallGraph();
+    const PAG::CallSiteSet& callSites = pag->getCallSiteSet();
+    for (PAG::CallSiteSet::const_iterator it = callSites.begin(), eit = callSites.end(); it != eit; ++it)
+        callgraph->getCallees(*it, callSiteToCallees[*it]);
+
+    for (PTACallGraph::iterator it = callgraph->begin(), eit = callgraph->end(); it != eit; ++it)
+    {
+        const SVFFunction* fun = it->second->getFunction();
+        if (pta->isInRecursion(fun))
+            recursiveFuns.insert(fun);
+    }
+
+    double end = PTAStat::getClk(true);
+    buildTime = (end - start) / TIMEINTERVAL;
+}
+
+/*!
+ * Return alias results based on the snapshot
+ */
+AliasResult FrozenPTA::alias(NodeID node1, NodeID node2) const
+{
+    const PointsToID empty = PersistentPointsToCache<PointsTo>::emptyPointsToId();
+    PointsToID p1 = node1 < nodeToExpandedPts.size() ? nodeToExpandedPts[node1] : empty;
+    PointsToID p2 = node2 < nodeToExpandedPts.size() ? nodeToExpandedPts[node2] : empty;
+
+    if (mayAliasAll[p1] || mayAliasAll[p2])
+        return llvm::MayAlias;
+    /// sets are stored once, equal IDs mean equal sets
+    if (p1 == p2)
+        return p1 == empty ? llvm::NoAlias : llvm::MayAlias;
+    if (ptsCache.getActualPts(p1).intersects(ptsCache.getActualPts(p2)))
+        return llvm::MayAlias;
+    return llvm::NoAlias;
+}
+
+/*!
+ * Return alias results based on the snapshot
+ */
+AliasResult FrozenPTA::alias(const Value* V1, const Value* V2) const
+{
+    return alias(pag->getValueNode(V1), pag->getValueNode(V2));
+}
+
+/*!
+ * Callees of a call site
+ */
+const FrozenPTA::FunctionSet& FrozenPTA::getCallees(const CallBlockNode* cs) const
+{
+    static const FunctionSet noCallees;
+    Map<const CallBlockNode*, FunctionSet>::const_iterator it = callSiteToCallees.find(cs);
+    return it == callSiteToCallees.end() ? noCallees : it->second;
+}
+
+/*!
+ * Whether a function is in a cycle of the call graph
+ */
+bool FrozenPTA::isInRecursion(const SVFFunction* fun) const
+{
+    return recursiveFuns.find(fun) != recursiveFuns.end();
+}
@@ -37,6 +37,11 @@ using namespace SVF;
 static llvm::cl::opt<bool> singleStride("stride-only", llvm::cl::init(false),
                                         llvm::cl::desc("Only use single stride in LocMemoryModel"));
 
+bool LocationSet::isSingleStride()
+{
+    return singleStride;
+}
+
 /*!
  * Add element num and stride pair
  */
@@ -0,0 +1,169 @@
+//===- ObjectClusterer.cpp -- Renumbering objects inside points-to sets------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * ObjectClusterer.cpp
+ */
+
+#include "MemoryModel/ObjectClusterer.h"
+#include "MemoryModel/PointerAnalysisImpl.h"
+#include "MemoryModel/PTAStat.h"
+#include <algorithm>
+
+using namespace SVF;
+using namespace SVFUtil;
+
+u32_t ObjectClusterer::numOfClusteredObjs = 0;
+u32_t ObjectClusterer::numOfDistinctPts = 0;
+u32_t ObjectClusterer::numOfElementsBefore = 0;
+u32_t ObjectClusterer::numOfElementsAfter = 0;
+bool ObjectClusterer::mappingInstalled = false;
+double ObjectClusterer::timeOfClustering = 0;
+
+/*!
+ * Statistics are per analysis run
+ */
+void ObjectClusterer::resetStat()
+{
+    numOfClusteredObjs = 0;
+    numOfDistinctPts = 0;
+    numOfElementsBefore = 0;
+    numOfElementsAfter = 0;
+    mappingInstalled = false;
+    timeOfClustering = 0;
+}
+
+/*!
+ * Number of SparseBitVector elements a set occupies, i.e., the number of distinct
+ * aligned blocks of BITS_PER_ELEMENT positions its (mapped) IDs fall in
+ */
+u32_t ObjectClusterer::numOfElements(const PointsTo& pts, const std::vector<NodeID>* mapping)
+{
+    const u32_t bitsPerElement = llvm::SparseBitVectorElement<>::BITS_PER_ELEMENT;
+    std::vector<u32_t> blocks;
+    blocks.reserve(pts.count());
+    for (NodeID o : pts)
+    {
+        NodeID pos = (mapping && o < mapping->size()) ? (*mapping)[o] : o;
+        blocks.push_back(pos / bitsPerElement);
+    }
+    std::sort(blocks.begin(), blocks.end());
+    return std::unique(blocks.begin(), blocks.end()) - blocks.begin();
+}
+
+/*!
+ * Greedy clustering: visit the distinct points-to sets of aux, the most common
+ * (and then the largest) first, and give the objects of each set the next free
+ * positions. Objects thus share elements with the objects they are most often
+ * pointed to with. Objects in no such set follow, then all non-object nodes,
+ * which never occur in points-to sets.
+ */
+void ObjectClusterer::computeMapping(BVDataPTAImpl* aux, std::vector<NodeID>& mapping)
+{
+    PAG* pag = aux->getPAG();
+
+    NodeID numOfNodes = 0;
+    for (PAG::iterator it = pag->begin(), eit = pag->end(); it != eit; ++it)
+        numOfNodes = std::max(numOfNodes, it->first + 1);
+
+    /// Distinct points-to sets and the number of pointers having each
+    Map<PointsTo, u32_t> ptsOccurrences;
+    NodeSet keys;
+    aux->getAllKeysWithPts(keys);
+    for (NodeID key : keys)
+    {
+        const PointsTo& pts = aux->getPts(key);
+        if (pts.count() > 1)
+            ++ptsOccurrences[pts];
+    }
+
+    typedef std::pair<const PointsTo*, u32_t> PtsWithOccurrences;
+    std::vector<PtsWithOccurrences> sortedPts;
+    sortedPts.reserve(ptsOccurrences.size());
+    for (const auto& it : ptsOccurrences)
+        sortedPts.push_back(std::make_pair(&it.first, it.second));
+    std::sort(sortedPts.begin(), sortedPts.end(),
+              [](const PtsWithOccurrences& a, const PtsWithOccurrences& b)
+    {
+        if (a.second != b.second)
+            return a.second > b.second;
+        return a.first->count() > b.first->count();
+    });
+
+    const NodeID unassigned = numOfNodes;
+    mapping.assign(numOfNodes, unassigned);
+    NodeID next = 0;
+    for (const PtsWithOccurrences& p : sortedPts)
+    {
+        for (NodeID o : *p.first)
+        {
+            if (o < numOfNodes && mapping[o] == unassigned)
+                mapping[o] = next++;
+        }
+    }
+    numOfClusteredObjs = next;
+    numOfDistinctPts = sortedPts.size();
+
+    for (PAG::iterator it = pag->begin(), eit = pag->end(); it != eit; ++it)
+    {
+        if (isa<ObjPN>(it->second) && mapping[it->first] == unassigned)
+            mapping[it->first] = next++;
+    }
+    /// the rest, including IDs with no PAG node, so that mapping is a permutation
+    for (NodeID n = 0; n < numOfNodes; ++n)
+    {
+        if (mapping[n] == unassigned)
+            mapping[n] = next++;
+    }
+    assert(next == numOfNodes && "not every node has been numbered!");
+
+    numOfElementsBefore = numOfElementsAfter = 0;
+    for (const PtsWithOccurrences& p : sortedPts)
+    {
+        numOfElementsBefore += p.second * numOfElements(*p.first, NULL);
+        numOfElementsAfter += p.second * numOfElements(*p.first, &mapping);
+    }
+}
+
+/*!
+ * Compute the numbering of objects and return it as a node mapping if it helps
+ */
+const PointsTo::NodeMapping* ObjectClusterer::cluster(BVDataPTAImpl* aux)
+{
+    resetStat();
+    double start = PTAStat::getClk(true);
+
+    std::vector<NodeID> mapping;
+    computeMapping(aux, mapping);
+
+    mappingInstalled = numOfElementsAfter < numOfElementsBefore;
+    const PointsTo::NodeMapping* nodeMapping = mappingInstalled ? PointsTo::createNodeMapping(mapping) : NULL;
+
+    double end = PTAStat::getClk(true);
+    timeOfClustering = (end - start) / TIMEINTERVAL;
+
+    DBOUT(DGENERAL, outs() << pasMsg("Object clustering: ") << numOfElementsBefore << " -> "
+          << numOfElementsAfter << " bit vector elements"
+          << (mappingInstalled ? "\n" : ", mapping not used\n"));
+
+    return nodeMapping;
+}
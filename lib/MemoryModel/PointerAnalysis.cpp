@@ -40,6 +40,7 @@
 #include "MemoryModel/PTAStat.h"
 #include "Graphs/ThreadCallGraph.h"
 #include "Graphs/ICFG.h"
+#include "Graphs/GraphStreamer.h"
 #include "MemoryModel/PTAType.h"
 #include "Graphs/ExternalPAG.h"
 #include "WPA/FlowSensitiveTBHC.h"
@@ -120,6 +121,7 @@ PointerAnalysis::PointerAnalysis(PAG* p, PTATY ty, bool alias_check) :
     pag = p;
 	OnTheFlyIterBudgetForStat = statBudget;
     print_stat = PStat;
+    auxiliary = false;
     ptaImplTy = BaseImpl;
     alias_validation = (alias_check && EnableAliasCheck);
 }
@@ -172,15 +174,15 @@ void PointerAnalysis::initialize()
     svfMod = pag->getModule();
 
     // dump PAG
-    if (dumpGraph())
+    if (dumpGraph() && !auxiliary)
         pag->dump("pag_initial");
 
     // dump ICFG
-    if (DumpICFG)
+    if (DumpICFG && !auxiliary)
     	pag->getICFG()->dump("icfg_initial");
 
     // print to command line of the PAG graph
-    if (PAGPrint)
+    if (PAGPrint && !auxiliary)
         pag->print();
 
     /// initialise pta call graph for every pointer analysis instance
@@ -199,7 +201,7 @@ void PointerAnalysis::initialize()
     callGraphSCCDetection();
 
     // dump callgraph
-	if (CallGraphDotGraph)
+	if (CallGraphDotGraph && !auxiliary)
 		getPTACallGraph()->dump("callgraph_initial");
 }
 
@@ -259,6 +261,14 @@ void PointerAnalysis::dumpStat()
  */
 void PointerAnalysis::finalize()
 {
+    /// An auxiliary analysis leaves no output, but the objects it collapsed
+    /// must be field-sensitive again for the analysis it runs for
+    if (auxiliary)
+    {
+        if (!UsePreCompFieldSensitive)
+            resetObjFieldSensitive();
+        return;
+    }
 
     /// Print statistics
     dumpStat();
@@ -271,6 +281,8 @@ void PointerAnalysis::finalize()
     // dump ICFG
     if (DumpICFG)
     	pag->getICFG()->dump("icfg_final");
+    GraphStreamer::stream(pag->getICFG(), "icfg", "icfg_final");
+    GraphStreamer::stream(pag, "pag", "pag_final");
 
     if (!DumpPAGFunctions.empty()) ExternalPAG::dumpFunctions(DumpPAGFunctions);
 
@@ -381,7 +393,7 @@ void PointerAnalysis::dumpPts(NodeID ptr, const PointsTo& pts)
 
     outs() << "";
 
-    for (NodeBS::iterator it = pts.begin(), eit = pts.end(); it != eit; ++it)
+    for (PointsTo::iterator it = pts.begin(), eit = pts.end(); it != eit; ++it)
     {
         const PAGNode* node = pag->getPAGNode(*it);
         if(SVFUtil::isa<ObjPN>(node) == false)
@@ -9,6 +9,8 @@
 #include "MemoryModel/PointerAnalysisImpl.h"
 #include "SVF-FE/CPPUtil.h"
 #include "SVF-FE/DCHG.h"
+#include <llvm/Support/MemoryBuffer.h>
+#include <cstring>
 #include <fstream>
 #include <sstream>
 
@@ -20,25 +22,128 @@ using namespace std;
 static llvm::cl::opt<bool> INCDFPTData("incdata", llvm::cl::init(true),
                                        llvm::cl::desc("Enable incremental DFPTData for flow-sensitive analysis"));
 
+enum PTDataBacking
+{
+    MutablePTD,
+    PersistentPTD
+};
+
+static llvm::cl::opt<PTDataBacking> PTDBacking("ptd", llvm::cl::init(MutablePTD),
+        llvm::cl::desc("Backing of the points-to data"),
+        llvm::cl::values(
+            clEnumValN(MutablePTD, "mutable", "each variable owns its points-to set"),
+            clEnumValN(PersistentPTD, "persistent", "variables share hash-consed points-to sets")));
+
+static llvm::cl::opt<u32_t> AliasCacheSize("alias-cache-size", llvm::cl::init(1 << 20),
+        llvm::cl::desc("Maximum number of cached alias results after the analysis has finished (0 disables the cache)"));
+
+enum PTAFileFormat
+{
+    BinaryPTAFile,
+    TextPTAFile
+};
+
+static llvm::cl::opt<PTAFileFormat> PTAFileFmt("ptafile-format", llvm::cl::init(BinaryPTAFile),
+        llvm::cl::desc("Format of the pointer analysis results written to a file (e.g., -write-ander)"),
+        llvm::cl::values(
+            clEnumValN(BinaryPTAFile, "binary", "versioned binary format, memory-mapped when read"),
+            clEnumValN(TextPTAFile, "text", "human readable \"var -> { objs }\" lines")));
+
+namespace
+{
+
+/*!
+ * Layout of a binary result file. The header is followed by these sections,
+ * each starting at a multiple of 8 bytes:
+ *   u64_t        setBegins[numOfSets + 1]   index of the first element of each set
+ *   NodeID       elements[numOfElements]    objects of all distinct points-to sets
+ *   VarRecord    vars[numOfVars]            points-to set of each variable
+ *   GepObjRecord gepObjs[numOfGepObjs]      GepObjPNs created when solving, by ID
+ * Integers are stored in host byte order; a file from a host of the other byte
+ * order fails the magic check.
+ */
+const char PTAFileMagic[8] = {'S', 'V', 'F', 'P', 'T', 'A', '\0', '\1'};
+const u32_t PTAFileVersion = 1;
+
+struct PTAFileHeader
+{
+    char magic[8];
+    u32_t version;
+    u32_t numOfPAGNodes;    ///< nodes after building the PAG
+    u64_t fingerprint;      ///< BVDataPTAImpl::getPAGFingerprint()
+    u64_t numOfElements;
+    u32_t numOfSets;
+    u32_t numOfVars;
+    u32_t numOfGepObjs;
+    u32_t padding;
+};
+
+struct VarRecord
+{
+    NodeID var;
+    u32_t set;
+};
+
+struct GepObjRecord
+{
+    NodeID id;
+    NodeID base;
+    s64_t offset;
+};
+
+inline u64_t alignTo8(u64_t n)
+{
+    return (n + 7) & ~(u64_t)7;
+}
+
+inline u64_t hashCombine(u64_t seed, u64_t v)
+{
+    return seed ^ (v + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+}
+
+}
+
 
 /*!
  * Constructor
  */
 BVDataPTAImpl::BVDataPTAImpl(PAG* p, PointerAnalysis::PTATY type, bool alias_check) :
-    PointerAnalysis(p, type, alias_check)
+    PointerAnalysis(p, type, alias_check), aliasCacheEnabled(false),
+    numOfAliasCacheHits(0), numOfAliasCacheMisses(0)
 {
     if (type == Andersen_WPA || type == AndersenWaveDiff_WPA || type == AndersenHCD_WPA || type == AndersenHLCD_WPA
             || type == AndersenLCD_WPA || type == TypeCPP_WPA || type == FlowS_DDA || type == AndersenWaveDiffWithType_WPA
             || type == AndersenSCD_WPA || type == AndersenSFR_WPA)
     {
-        ptD = new MutDiffPTDataTy();
+        if (PTDBacking == PersistentPTD)
+            ptD = new PersDiffPTDataTy(ptCache);
+        else
+            ptD = new MutDiffPTDataTy();
     }
     else if (type == FSSPARSE_WPA || type == FSTBHC_WPA)
     {
-        if (INCDFPTData)
-            ptD = new IncMutDFPTDataTy();
+        if (PTDBacking == PersistentPTD)
+        {
+            if (INCDFPTData)
+                ptD = new PersIncDFPTDataTy(ptCache);
+            else
+                ptD = new PersDFPTDataTy(ptCache);
+        }
         else
-            ptD = new MutDFPTDataTy();
+        {
+            if (INCDFPTData)
+                ptD = new IncMutDFPTDataTy();
+            else
+                ptD = new MutDFPTDataTy();
+        }
+    }
+    else if (type == VFS_WPA)
+    {
+        /// versioned points-to sets are kept by the analysis itself
+        if (PTDBacking == PersistentPTD)
+            ptD = new PersPTDataTy(ptCache);
+        else
+            ptD = new MutPTDataTy();
     }
     else
         assert(false && "no points-to data available");
@@ -46,6 +151,41 @@ BVDataPTAImpl::BVDataPTAImpl(PAG* p, PointerAnalysis::PTATY type, bool alias_che
     ptaImplTy = BVDataImpl;
 }
 
+/*!
+ * Collect keys of the points-to map, for the backings which have one
+ */
+void BVDataPTAImpl::getAllKeysWithPts(NodeSet& keys) const
+{
+    if (hasPtsMap())
+    {
+        for (const auto& it : getPtsMap())
+            keys.insert(it.first);
+    }
+    else if (PersDiffPTDataTy* pd = SVFUtil::dyn_cast<PersDiffPTDataTy>(ptD))
+    {
+        for (const auto& it : pd->getPtsMap())
+            keys.insert(it.first);
+    }
+    else if (PersPTDataTy* p = SVFUtil::dyn_cast<PersPTDataTy>(ptD))
+    {
+        for (const auto& it : p->getPtsMap())
+            keys.insert(it.first);
+    }
+    /// top-level pointers of the data-flow backings, IN/OUT sets are per location
+    else if (MutDFPTDataTy* mdf = SVFUtil::dyn_cast<MutDFPTDataTy>(ptD))
+    {
+        for (const auto& it : mdf->getPtsMap())
+            keys.insert(it.first);
+    }
+    else if (PersDFPTDataTy* pdf = SVFUtil::dyn_cast<PersDFPTDataTy>(ptD))
+    {
+        for (const auto& it : pdf->getPtsMap())
+            keys.insert(it.first);
+    }
+    else
+        assert(false && "BVDataPTAImpl::getAllKeysWithPts: unknown points-to data backing!");
+}
+
 /*!
  * Expand all fields of an aggregate in all points-to sets
  */
@@ -61,12 +201,75 @@ void BVDataPTAImpl::expandFIObjs(const PointsTo& pts, PointsTo& expandedPts)
     }
 }
 
+/*!
+ * Hash the kinds of the nodes and edges of the PAG built from the module.
+ * Edges are visited in the deterministic order of each node's out-edge set.
+ */
+u64_t BVDataPTAImpl::getPAGFingerprint() const
+{
+    const NodeID numOfPAGNodes = pag->getNodeNumAfterPAGBuild();
+    u64_t fingerprint = hashCombine(0, numOfPAGNodes);
+    for (NodeID id = 0; id < numOfPAGNodes; ++id)
+    {
+        if (!pag->hasGNode(id))
+            continue;
+
+        const PAGNode* node = pag->getPAGNode(id);
+        fingerprint = hashCombine(fingerprint, id);
+        fingerprint = hashCombine(fingerprint, node->getNodeKind());
+        for (const PAGEdge* edge : node->getOutEdges())
+        {
+            if (edge->getDstID() >= numOfPAGNodes)
+                continue;
+            fingerprint = hashCombine(fingerprint, edge->getDstID());
+            fingerprint = hashCombine(fingerprint, edge->getEdgeKind());
+        }
+    }
+    return fingerprint;
+}
+
 /*!
  * Store pointer analysis result into a file.
  * It includes the points-to relations, and all PAG nodes including those
  * created when solving Andersen's constraints.
  */
 void BVDataPTAImpl::writeToFile(const string& filename)
+{
+    if (PTAFileFmt == BinaryPTAFile)
+        writeToBinaryFile(filename);
+    else
+        writeToTextFile(filename);
+}
+
+/*!
+ * Load pointer analysis result form a file, recognising its format.
+ */
+bool BVDataPTAImpl::readFromFile(const string& filename)
+{
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> bufOrErr =
+        llvm::MemoryBuffer::getFile(filename, -1, false);
+    if (!bufOrErr)
+    {
+        outs() << "Loading pointer analysis results from '" << filename << "'...";
+        outs() << "  error opening file for reading!\n";
+        return false;
+    }
+
+    const llvm::MemoryBuffer& buffer = *bufOrErr.get();
+    if (buffer.getBufferSize() >= sizeof(PTAFileMagic)
+            && memcmp(buffer.getBufferStart(), PTAFileMagic, sizeof(PTAFileMagic)) == 0)
+    {
+        outs() << "Loading pointer analysis results from '" << filename << "'...";
+        return readFromBinaryFile(buffer);
+    }
+
+    return readFromTextFile(filename);
+}
+
+/*!
+ * Store the distinct points-to sets once, and each variable as an index into them
+ */
+void BVDataPTAImpl::writeToBinaryFile(const string& filename)
 {
     outs() << "Storing pointer analysis results to '" << filename << "'...";
 
@@ -79,30 +282,269 @@ void BVDataPTAImpl::writeToFile(const string& filename)
         return;
     }
 
-    // Write analysis results to file
-    PTDataTy *ptD = getPTDataTy();
-    if (hasPtsMap())
+    std::vector<u64_t> setBegins;
+    std::vector<NodeID> elements;
+    std::vector<VarRecord> vars;
+    std::vector<GepObjRecord> gepObjs;
+
+    Map<PointsTo, u32_t> setIds;
+    NodeSet keys;
+    getAllKeysWithPts(keys);
+    OrderedNodeSet sortedKeys(keys.begin(), keys.end());
+    for (NodeID var : sortedKeys)
     {
-        auto &ptsMap = getPtsMap();
-        for (auto it = ptsMap.begin(), ie = ptsMap.end(); it != ie; ++it)
+        const PointsTo& pts = getPts(var);
+        std::pair<Map<PointsTo, u32_t>::iterator, bool> res = setIds.emplace(pts, setBegins.size());
+        if (res.second)
         {
-            NodeID var = it->first;
-            const PointsTo &pts = getPts(var);
+            setBegins.push_back(elements.size());
+            /// sets may be stored under a node mapping, so sort the original IDs
+            size_t begin = elements.size();
+            for (NodeID o : pts)
+                elements.push_back(o);
+            std::sort(elements.begin() + begin, elements.end());
+        }
+        vars.push_back({var, res.first->second});
+    }
+    setBegins.push_back(elements.size());
 
-            F.os() << var << " -> { ";
-            if (pts.empty())
-            {
-                F.os() << " ";
-            }
-            else
+    for (auto it = pag->begin(), ie = pag->end(); it != ie; ++it)
+    {
+        if (GepObjPN *gepObjPN = SVFUtil::dyn_cast<GepObjPN>(it->second))
+            gepObjs.push_back({it->first, pag->getBaseObjNode(it->first), gepObjPN->getLocationSet().getOffset()});
+    }
+    std::sort(gepObjs.begin(), gepObjs.end(), [](const GepObjRecord& a, const GepObjRecord& b)
+    {
+        return a.id < b.id;
+    });
+
+    PTAFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, PTAFileMagic, sizeof(PTAFileMagic));
+    header.version = PTAFileVersion;
+    header.numOfPAGNodes = pag->getNodeNumAfterPAGBuild();
+    header.fingerprint = getPAGFingerprint();
+    header.numOfElements = elements.size();
+    header.numOfSets = setBegins.size() - 1;
+    header.numOfVars = vars.size();
+    header.numOfGepObjs = gepObjs.size();
+
+    u64_t written = 0;
+    auto writeSection = [&F, &written](const void* data, u64_t size)
+    {
+        static const char zeros[8] = {0};
+        F.os().write(static_cast<const char*>(data), size);
+        written += size;
+        F.os().write(zeros, alignTo8(written) - written);
+        written = alignTo8(written);
+    };
+    writeSection(&header, sizeof(header));
+    writeSection(setBegins.data(), setBegins.size() * sizeof(u64_t));
+    writeSection(elements.data(), elements.size() * sizeof(NodeID));
+    writeSection(vars.data(), vars.size() * sizeof(VarRecord));
+    writeSection(gepObjs.data(), gepObjs.size() * sizeof(GepObjRecord));
+
+    F.os().close();
+    if (!F.os().has_error())
+    {
+        outs() << "\n";
+        F.keep();
+    }
+}
+
+/*!
+ * Load a binary result file, rejecting files of another version or of another
+ * module. Nothing is loaded unless the whole file is well-formed and all its IDs
+ * are nodes of this PAG (GepObjPNs recreated from a rejected file are kept, the
+ * analysis creates them anyway).
+ */
+bool BVDataPTAImpl::readFromBinaryFile(const llvm::MemoryBuffer& buffer)
+{
+    const char* start = buffer.getBufferStart();
+    const u64_t size = buffer.getBufferSize();
+    if (size < sizeof(PTAFileHeader))
+    {
+        outs() << "  truncated file!\n";
+        return false;
+    }
+
+    const PTAFileHeader* header = reinterpret_cast<const PTAFileHeader*>(start);
+    if (header->version != PTAFileVersion)
+    {
+        outs() << "  unsupported version " << header->version << " (expected " << PTAFileVersion << ")!\n";
+        return false;
+    }
+    if (header->numOfPAGNodes != pag->getNodeNumAfterPAGBuild() || header->fingerprint != getPAGFingerprint())
+    {
+        outs() << "  results are of a different module, not loaded!\n";
+        return false;
+    }
+
+    /// Locate the sections, bounding the counts first so that the offsets cannot overflow
+    if (header->numOfElements > size / sizeof(NodeID))
+    {
+        outs() << "  truncated file!\n";
+        return false;
+    }
+    u64_t pos = alignTo8(sizeof(PTAFileHeader));
+    const u64_t setBeginsPos = pos;
+    pos = alignTo8(pos + ((u64_t)header->numOfSets + 1) * sizeof(u64_t));
+    const u64_t elementsPos = pos;
+    pos = alignTo8(pos + header->numOfElements * sizeof(NodeID));
+    const u64_t varsPos = pos;
+    pos = alignTo8(pos + (u64_t)header->numOfVars * sizeof(VarRecord));
+    const u64_t gepObjsPos = pos;
+    pos = alignTo8(pos + (u64_t)header->numOfGepObjs * sizeof(GepObjRecord));
+    if (pos > size)
+    {
+        outs() << "  truncated file!\n";
+        return false;
+    }
+
+    const u64_t* setBegins = reinterpret_cast<const u64_t*>(start + setBeginsPos);
+    const NodeID* elements = reinterpret_cast<const NodeID*>(start + elementsPos);
+    const VarRecord* vars = reinterpret_cast<const VarRecord*>(start + varsPos);
+    const GepObjRecord* gepObjs = reinterpret_cast<const GepObjRecord*>(start + gepObjsPos);
+
+    if (setBegins[header->numOfSets] != header->numOfElements)
+    {
+        outs() << "  corrupted file!\n";
+        return false;
+    }
+    for (u32_t i = 0; i < header->numOfSets; ++i)
+    {
+        if (setBegins[i] > setBegins[i + 1])
+        {
+            outs() << "  corrupted file!\n";
+            return false;
+        }
+    }
+    for (u32_t i = 0; i < header->numOfVars; ++i)
+    {
+        if (vars[i].set >= header->numOfSets)
+        {
+            outs() << "  corrupted file!\n";
+            return false;
+        }
+    }
+
+    /// Every ID must be a node of the PAG or one of the GepObjPNs below, whose
+    /// bases are objects of the PAG as built
+    NodeID numOfNodes = header->numOfPAGNodes;
+    for (u32_t i = 0; i < header->numOfGepObjs; ++i)
+    {
+        const GepObjRecord& gep = gepObjs[i];
+        if ((i > 0 && gep.id <= gepObjs[i - 1].id) || gep.base >= header->numOfPAGNodes
+                || !pag->hasGNode(gep.base) || !SVFUtil::isa<ObjPN>(pag->getGNode(gep.base)))
+        {
+            writeWrnMsg("corrupted GepObjPN record in the result file, not loaded!");
+            return false;
+        }
+        numOfNodes = std::max(numOfNodes, gep.id + 1);
+    }
+    for (u64_t e = 0; e < header->numOfElements; ++e)
+    {
+        if (elements[e] >= numOfNodes)
+        {
+            writeWrnMsg("points-to element out of range in the result file, not loaded!");
+            return false;
+        }
+    }
+    for (u32_t i = 0; i < header->numOfVars; ++i)
+    {
+        if (vars[i].var >= numOfNodes)
+        {
+            writeWrnMsg("variable out of range in the result file, not loaded!");
+            return false;
+        }
+    }
+
+    /// GepObjPNs first, in ID order, so that they get their original IDs
+    for (u32_t i = 0; i < header->numOfGepObjs; ++i)
+    {
+        const GepObjRecord& gep = gepObjs[i];
+        NodeID n = pag->getGepObjNode(pag->getObject(gep.base), LocationSet(gep.offset));
+        if (gep.id != n)
+        {
+            writeWrnMsg("GepObjPN of the result file gets another ID, not loaded!");
+            return false;
+        }
+    }
+
+    /// The remaining IDs must now be objects and nodes respectively
+    for (u64_t e = 0; e < header->numOfElements; ++e)
+    {
+        if (!pag->hasGNode(elements[e]) || !SVFUtil::isa<ObjPN>(pag->getGNode(elements[e])))
+        {
+            writeWrnMsg("points-to element of the result file is not an object, not loaded!");
+            return false;
+        }
+    }
+    for (u32_t i = 0; i < header->numOfVars; ++i)
+    {
+        if (!pag->hasGNode(vars[i].var))
+        {
+            writeWrnMsg("variable of the result file is not a PAG node, not loaded!");
+            return false;
+        }
+    }
+
+    /// Build each distinct points-to set once
+    std::vector<PointsTo> sets(header->numOfSets);
+    for (u32_t i = 0; i < header->numOfSets; ++i)
+    {
+        for (u64_t e = setBegins[i]; e < setBegins[i + 1]; ++e)
+            sets[i].set(elements[e]);
+    }
+
+    clearAliasCache();
+    PTDataTy *ptD = getPTDataTy();
+    for (u32_t i = 0; i < header->numOfVars; ++i)
+        ptD->unionPts(vars[i].var, sets[vars[i].set]);
+
+    // Update callgraph
+    updateCallGraph(pag->getIndirectCallsites());
+
+    outs() << "\n";
+    return true;
+}
+
+/*!
+ * Store pointer analysis result into a text file.
+ */
+void BVDataPTAImpl::writeToTextFile(const string& filename)
+{
+    outs() << "Storing pointer analysis results to '" << filename << "'...";
+
+    error_code err;
+    ToolOutputFile F(filename.c_str(), err, llvm::sys::fs::F_None);
+    if (err)
+    {
+        outs() << "  error opening file for writing!\n";
+        F.os().clear_error();
+        return;
+    }
+
+    // Write analysis results to file
+    NodeSet vars;
+    getAllKeysWithPts(vars);
+    for (NodeID var : vars)
+    {
+        const PointsTo &pts = getPts(var);
+
+        F.os() << var << " -> { ";
+        if (pts.empty())
+        {
+            F.os() << " ";
+        }
+        else
+        {
+            for (auto it = pts.begin(), ie = pts.end(); it != ie; ++it)
             {
-                for (auto it = pts.begin(), ie = pts.end(); it != ie; ++it)
-                {
-                    F.os() << *it << " ";
-                }
+                F.os() << *it << " ";
             }
-            F.os() << "}\n";
         }
+        F.os() << "}\n";
     }
 
     // Write GepPAGNodes to file
@@ -128,11 +570,11 @@ void BVDataPTAImpl::writeToFile(const string& filename)
 }
 
 /*!
- * Load pointer analysis result form a file.
+ * Load pointer analysis result form a text file.
  * It populates BVDataPTAImpl with the points-to data, and updates PAG with
  * the PAG offset nodes created during Andersen's solving stage.
  */
-bool BVDataPTAImpl::readFromFile(const string& filename)
+bool BVDataPTAImpl::readFromTextFile(const string& filename)
 {
     outs() << "Loading pointer analysis results from '" << filename << "'...";
 
@@ -144,6 +586,7 @@ bool BVDataPTAImpl::readFromFile(const string& filename)
     }
 
     // Read analysis results from file
+    clearAliasCache();
     PTDataTy *ptD = getPTDataTy();
     string line;
 
@@ -303,7 +746,35 @@ AliasResult BVDataPTAImpl::alias(const Value* V1,
  */
 AliasResult BVDataPTAImpl::alias(NodeID node1, NodeID node2)
 {
-    return alias(getPts(node1),getPts(node2));
+    if (!aliasCacheEnabled)
+        return alias(getPts(node1),getPts(node2));
+
+    NodePair key = node1 < node2 ? std::make_pair(node1, node2) : std::make_pair(node2, node1);
+    Map<NodePair, AliasResult>::const_iterator it = aliasCache.find(key);
+    if (it != aliasCache.end())
+    {
+        numOfAliasCacheHits++;
+        return it->second;
+    }
+
+    numOfAliasCacheMisses++;
+    AliasResult result = alias(getPts(node1), getPts(node2));
+    /// start over rather than grow without bound
+    if (aliasCache.size() >= AliasCacheSize)
+        aliasCache.clear();
+    aliasCache.insert(std::make_pair(key, result));
+    return result;
+}
+
+/*!
+ * Points-to sets no longer change once the analysis has finished, cache alias results from now on.
+ * Any later update of a points-to set (unionPts/addPts/clear*Pts, reading results) drops the cache.
+ */
+void BVDataPTAImpl::finalize()
+{
+    aliasCache.clear();
+    aliasCacheEnabled = AliasCacheSize > 0;
+    PointerAnalysis::finalize();
 }
 
 /*!
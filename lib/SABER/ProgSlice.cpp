@@ -33,6 +33,15 @@
 using namespace SVF;
 using namespace SVFUtil;
 
+static llvm::cl::opt<bool> CacheVFGuards("cache-vf-guards", llvm::cl::init(true),
+        llvm::cl::desc("Reuse the guards of value-flow edges across slices"));
+
+u32_t ProgSlice::numOfGuardHits = 0;
+u32_t ProgSlice::numOfGuardMisses = 0;
+u64_t ProgSlice::numOfSavedCondNodes = 0;
+bool ProgSlice::countSavedCondNodes = false;
+ProgSlice::SVFGEdgeToCondMap ProgSlice::vfGuardCache;
+
 /*!
  * Compute path conditions for nodes on the backward slice
  * path condition of each node is calculated starting from root node (source)
@@ -60,23 +69,7 @@ bool ProgSlice::AllPathReachableSolve()
             const SVFGNode* succ = edge->getDstNode();
             if(inBackwardSlice(succ))
             {
-                Condition* vfCond = NULL;
-                const BasicBlock* nodeBB = getSVFGNodeBB(node);
-                const BasicBlock* succBB = getSVFGNodeBB(succ);
-                /// clean up the control flow conditions for next round guard computation
-                clearCFCond();
-
-                if(edge->isCallVFGEdge())
-                {
-                    vfCond = ComputeInterCallVFGGuard(nodeBB,succBB, getCallSite(edge)->getParent());
-                }
-                else if(edge->isRetVFGEdge())
-                {
-                    vfCond = ComputeInterRetVFGGuard(nodeBB,succBB, getRetSite(edge)->getParent());
-                }
-                else
-                    vfCond = ComputeIntraVFGGuard(nodeBB,succBB);
-
+                Condition* vfCond = getVFGuard(edge);
                 Condition* succPathCond = condAnd(cond, vfCond);
                 if(setVFCond(succ,  condOr(getVFCond(succ), succPathCond) ))
                     worklist.push(succ);
@@ -90,6 +83,47 @@ bool ProgSlice::AllPathReachableSolve()
     return isSatisfiableForAll();
 }
 
+/*!
+ * Compute the guard of a value-flow edge from its source node (the current SVFG node)
+ */
+ProgSlice::Condition* ProgSlice::getVFGuard(const SVFGEdge* edge)
+{
+    if (CacheVFGuards)
+    {
+        SVFGEdgeToCondMap::const_iterator it = vfGuardCache.find(edge);
+        if (it != vfGuardCache.end())
+        {
+            numOfGuardHits++;
+            /// sizing a guard walks its DAG, only worth it for the statistics
+            if (countSavedCondNodes)
+                numOfSavedCondNodes += pathAllocator->getCondSize(it->second);
+            return it->second;
+        }
+    }
+    numOfGuardMisses++;
+
+    Condition* vfCond = NULL;
+    const BasicBlock* nodeBB = getSVFGNodeBB(edge->getSrcNode());
+    const BasicBlock* succBB = getSVFGNodeBB(edge->getDstNode());
+    /// clean up the control flow conditions for next round guard computation
+    clearCFCond();
+
+    if(edge->isCallVFGEdge())
+    {
+        vfCond = ComputeInterCallVFGGuard(nodeBB,succBB, getCallSite(edge)->getParent());
+    }
+    else if(edge->isRetVFGEdge())
+    {
+        vfCond = ComputeInterRetVFGGuard(nodeBB,succBB, getRetSite(edge)->getParent());
+    }
+    else
+        vfCond = ComputeIntraVFGGuard(nodeBB,succBB);
+
+    if (CacheVFGuards)
+        vfGuardCache[edge] = vfCond;
+    return vfCond;
+}
+
 /*!
  * Solve by computing disjunction of conditions from all sinks (e.g., memory leak)
  */
@@ -105,11 +105,11 @@ NodeBS& SaberSVFGBuilder::CollectPtsChain(BVDataPTAImpl* pta,NodeID id, NodeToPT
         return it->second;
     else
     {
-        PointsTo& pts = cachedPtsMap[baseId];
+        NodeBS& pts = cachedPtsMap[baseId];
         pts |= pag->getFieldsAfterCollapse(baseId);
 
         WorkList worklist;
-        for(PointsTo::iterator it = pts.begin(), eit = pts.end(); it!=eit; ++it)
+        for(NodeBS::iterator it = pts.begin(), eit = pts.end(); it!=eit; ++it)
             worklist.push(*it);
 
         while(!worklist.empty())
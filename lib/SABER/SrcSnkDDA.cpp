@@ -31,6 +31,7 @@
 #include "SABER/SrcSnkDDA.h"
 #include "Graphs/SVFGStat.h"
 #include "SVF-FE/PAGBuilder.h"
+#include "Util/Parallel.h"
 
 using namespace SVF;
 using namespace SVFUtil;
@@ -41,6 +42,12 @@ static llvm::cl::opt<bool> DumpSlice("dump-slice", llvm::cl::init(false),
 static llvm::cl::opt<unsigned> cxtLimit("cxtlimit",  llvm::cl::init(3),
                                         llvm::cl::desc("Source-Sink Analysis Contexts Limit"));
 
+static llvm::cl::opt<bool> GuardStat("guard-stat", llvm::cl::init(false),
+                                     llvm::cl::desc("Print BDD and value-flow guard cache statistics"));
+
+static llvm::cl::opt<u32_t> SaberThreads("saber-threads",  llvm::cl::init(1),
+        llvm::cl::desc("Number of threads slicing sources concurrently (0: all hardware threads)"));
+
 /// Initialize analysis
 void SrcSnkDDA::initialize(SVFModule* module)
 {
@@ -65,6 +72,16 @@ void SrcSnkDDA::analyze(SVFModule* module)
     initialize(module);
 
     ContextCond::setMaxCxtLen(cxtLimit);
+    ProgSlice::countSavedCondNodes = GuardStat;
+
+    if (ParallelUtil::getNumOfThreads(SaberThreads) > 1)
+    {
+        analyzeInParallel();
+        if (GuardStat)
+            printBDDStat();
+        finalize();
+        return;
+    }
 
     for (SVFGNodeSetIter iter = sourcesBegin(), eiter = sourcesEnd();
             iter != eiter; ++iter)
@@ -95,22 +112,83 @@ void SrcSnkDDA::analyze(SVFModule* module)
             }
 
             DBOUT(DSaber, outs() << "Backward process for slice:" << (*iter)->getId() << " (size = " << getCurSlice()->getBackwardSliceSize() << ")\n");
+        }
 
-            if(DumpSlice)
-                annotateSlice(_curSlice);
+        solveCurSlice();
+    }
 
-            if(_curSlice->AllPathReachableSolve()== true)
-                _curSlice->setAllReachable();
+    if (GuardStat)
+        printBDDStat();
+    finalize();
+}
 
-            DBOUT(DSaber, outs() << "Guard computation for slice:" << (*iter)->getId() << ")\n");
-        }
+/*!
+ * Compute the guards of the current slice and report its bugs
+ */
+void SrcSnkDDA::solveCurSlice()
+{
+    if (_curSlice->isReachGlobal() == false)
+    {
+        if(DumpSlice)
+            annotateSlice(_curSlice);
+
+        if(_curSlice->AllPathReachableSolve()== true)
+            _curSlice->setAllReachable();
 
-        reportBug(getCurSlice());
+        DBOUT(DSaber, outs() << "Guard computation for slice:" << _curSlice->getSource()->getId() << ")\n");
     }
 
-    finalize();
+    reportBug(_curSlice);
 }
 
+/*!
+ * Slice the sources on several threads over the read-only SVFG, a batch at a time.
+ * Each thread traverses with its own worklist and visited maps; the longest context
+ * is recorded in the atomic ContextCond::maximumCxt.
+ * Guards are still computed and bugs reported on this thread. The condition manager
+ * (PathCondAllocator::getCondManager) is process-wide and not thread-safe: the branch
+ * conditions of the whole module are allocated in it before slicing, and the true/false
+ * conditions, guards and the conditions printed in reports all come from it, so a
+ * manager per thread would mean allocating every branch condition once per thread.
+ * Slices are solved in the order of the source set, as in a serial run, so that
+ * reports do not depend on the scheduling.
+ */
+void SrcSnkDDA::analyzeInParallel()
+{
+    u32_t numOfThreads = ParallelUtil::getNumOfThreads(SaberThreads);
+
+    std::vector<const SVFGNode*> srcs(sourcesBegin(), sourcesEnd());
+
+    std::vector<SliceTraversal*> workers;
+    for (u32_t i = 0; i < numOfThreads; i++)
+        workers.push_back(new SliceTraversal(this));
+
+    /// keep the number of live slices bounded
+    const u32_t batchSize = numOfThreads * 16;
+    for (u32_t begin = 0; begin < srcs.size(); begin += batchSize)
+    {
+        u32_t end = std::min<u32_t>(begin + batchSize, srcs.size());
+        std::vector<ProgSlice*> slices;
+        for (u32_t i = begin; i < end; i++)
+            slices.push_back(new ProgSlice(srcs[i], getPathAllocator(), getSVFG()));
+
+        ParallelUtil::parallelFor(slices.size(), numOfThreads, [&](u32_t i, u32_t tid)
+        {
+            workers[tid]->slice(slices[i]);
+        }, 1);
+
+        for (ProgSlice* slice : slices)
+        {
+            if (_curSlice != NULL)
+                delete _curSlice;
+            _curSlice = slice;
+            solveCurSlice();
+        }
+    }
+
+    for (SliceTraversal* worker : workers)
+        delete worker;
+}
 
 /*!
  * determine whether a SVFGNode n is in a allocation wrapper function,
@@ -173,24 +251,64 @@ bool SrcSnkDDA::isInAWrapper(const SVFGNode* src, CallSiteSet& csIdSet)
 }
 
 
+/*!
+ * Add a node reached forward to a slice
+ */
+void SrcSnkDDA::FWProcessNode(ProgSlice* slice, const SVFGNode* node)
+{
+    if(isSink(node))
+    {
+        slice->addToSinks(node);
+        slice->addToForwardSlice(node);
+        slice->setPartialReachable();
+    }
+    else
+        slice->addToForwardSlice(node);
+}
+
 /*!
  * Propagate information forward by matching context
  */
 void SrcSnkDDA::FWProcessOutgoingEdge(const DPIm& item, SVFGEdge* edge)
 {
-    DBOUT(DSaber,outs() << "\n##processing source: " << getCurSlice()->getSource()->getId() <<" forward propagate from (" << edge->getSrcID());
+    DPIm newItem(item);
+    if (FWGetItem(getCurSlice(), item, edge, newItem) == false)
+        return;
+
+    const SVFGNode* dstNode = edge->getDstNode();
+    /// whether this dstNode has been visited or not
+    if(forwardVisited(dstNode,newItem))
+    {
+        DBOUT(DSaber,outs() << " node "<< dstNode->getId() <<" has been visited\n");
+        return;
+    }
+    else
+        addForwardVisited(dstNode, newItem);
+
+    if(pushIntoWorklist(newItem))
+        DBOUT(DSaber,outs() << " --> " << edge->getDstID() << ", cxt size: " << newItem.getContexts().cxtSize() <<")\n");
+
+}
+
+/*!
+ * Compute the item propagated forward along an edge by matching context,
+ * return false if nothing is propagated
+ */
+bool SrcSnkDDA::FWGetItem(ProgSlice* slice, const DPIm& item, const SVFGEdge* edge, DPIm& newItem)
+{
+    DBOUT(DSaber,outs() << "\n##processing source: " << slice->getSource()->getId() <<" forward propagate from (" << edge->getSrcID());
 
     // for indirect SVFGEdge, the propagation should follow the def-use chains
     // points-to on the edge indicate whether the object of source node can be propagated
 
     const SVFGNode* dstNode = edge->getDstNode();
-    DPIm newItem(dstNode->getId(),item.getContexts());
+    newItem = DPIm(dstNode->getId(),item.getContexts());
 
     /// handle globals here
-    if(isGlobalSVFGNode(dstNode) || getCurSlice()->isReachGlobal())
+    if(isGlobalSVFGNode(dstNode) || slice->isReachGlobal())
     {
-        getCurSlice()->setReachGlobal();
-        return;
+        slice->setReachGlobal();
+        return false;
     }
 
 
@@ -219,23 +337,12 @@ void SrcSnkDDA::FWProcessOutgoingEdge(const DPIm& item, SVFGEdge* edge)
         if (newItem.matchContext(csId) == false)
         {
             DBOUT(DSaber, outs() << "-|-\n");
-            return;
+            return false;
         }
         DBOUT(DSaber, outs() << " pop cxt [" << csId << "] ");
     }
 
-    /// whether this dstNode has been visited or not
-    if(forwardVisited(dstNode,newItem))
-    {
-        DBOUT(DSaber,outs() << " node "<< dstNode->getId() <<" has been visited\n");
-        return;
-    }
-    else
-        addForwardVisited(dstNode, newItem);
-
-    if(pushIntoWorklist(newItem))
-        DBOUT(DSaber,outs() << " --> " << edge->getDstID() << ", cxt size: " << newItem.getContexts().cxtSize() <<")\n");
-
+    return true;
 }
 
 /*!
@@ -268,6 +375,51 @@ void SrcSnkDDA::setCurSlice(const SVFGNode* src)
     _curSlice = new ProgSlice(src,getPathAllocator(), getSVFG());
 }
 
+/*!
+ * Compute the forward and backward slices of slice's source
+ */
+void SliceTraversal::slice(ProgSlice* s)
+{
+    curSlice = s;
+    nodeToDPItemsMap.clear();
+    visitedSet.clear();
+
+    ContextCond cxt;
+    SrcSnkDDA::DPIm item(s->getSource()->getId(), cxt);
+    forwardTraverse(item);
+
+    if (s->isReachGlobal() == false)
+    {
+        for (const SVFGNode* sink : s->getSinks())
+        {
+            SrcSnkDDA::DPIm sinkItem(sink->getId(), cxt);
+            backwardTraverse(sinkItem);
+        }
+    }
+    curSlice = NULL;
+}
+
+void SliceTraversal::FWProcessOutgoingEdge(const SrcSnkDDA::DPIm& item, SVFGEdge* edge)
+{
+    SrcSnkDDA::DPIm newItem(item);
+    if (dda->FWGetItem(curSlice, item, edge, newItem) == false)
+        return;
+
+    if (nodeToDPItemsMap[edge->getDstNode()].insert(newItem).second)
+        pushIntoWorklist(newItem);
+}
+
+void SliceTraversal::BWProcessIncomingEdge(const SrcSnkDDA::DPIm&, SVFGEdge* edge)
+{
+    const SVFGNode* srcNode = edge->getSrcNode();
+    if (visitedSet.insert(srcNode).second)
+    {
+        ContextCond cxt;
+        SrcSnkDDA::DPIm newItem(srcNode->getId(), cxt);
+        pushIntoWorklist(newItem);
+    }
+}
+
 void SrcSnkDDA::annotateSlice(ProgSlice* slice)
 {
     getSVFG()->getStat()->addToSources(slice->getSource());
@@ -289,7 +441,13 @@ void SrcSnkDDA::dumpSlices()
 void SrcSnkDDA::printBDDStat()
 {
 
+    outs() << "Condition backend: " << PathCondAllocator::getCondBackendName() << "\n";
     outs() << "BDD Mem usage: " << PathCondAllocator::getMemUsage() << "\n";
     outs() << "BDD Number: " << PathCondAllocator::getCondNum() << "\n";
     outs() << "BDD max live number: " << PathCondAllocator::getMaxLiveCondNumber() << "\n";
+    outs() << "Over-approximated conditions: " << PathCondAllocator::getNumOfApproxCond() << "\n";
+    outs() << "Cached VF guards: " << ProgSlice::getGuardCacheSize() << "\n";
+    outs() << "VF guard cache hits: " << ProgSlice::numOfGuardHits << "\n";
+    outs() << "VF guard cache misses: " << ProgSlice::numOfGuardMisses << "\n";
+    outs() << "BDD nodes in reused VF guards: " << ProgSlice::numOfSavedCondNodes << "\n";
 }
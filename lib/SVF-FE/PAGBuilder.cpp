@@ -35,6 +35,7 @@
 #include "Graphs/ExternalPAG.h"
 #include "Util/BasicTypes.h"
 #include "MemoryModel/PAGBuilderFromFile.h"
+#include "SVF-FE/PAGSnapshot.h"
 
 using namespace std;
 using namespace SVF;
@@ -63,6 +64,25 @@ PAG* PAGBuilder::build(SVFModule* svfModule)
     /// initial external library information
     /// initial PAG nodes
     initalNode();
+
+    /// restore the rest of the PAG from a snapshot of the same modules if there is one
+    if (PAGSnapshot::isEnabled())
+    {
+        PAGSnapshot snapshot(pag);
+        if (snapshot.read(snapshot.getFileName()))
+        {
+            sanityCheck();
+            pag->initialiseCandidatePointers();
+            pag->setNodeNumAfterPAGBuild(pag->getTotalNodeNum());
+            return pag;
+        }
+        if (snapshot.isPAGDiscarded())
+        {
+            pag = PAG::getPAG();
+            initalNode();
+        }
+    }
+
     /// initial PAG edges:
     ///// handle globals
     visitGlobal(svfModule);
@@ -120,6 +140,12 @@ PAG* PAGBuilder::build(SVFModule* svfModule)
 
     sanityCheck();
 
+    if (PAGSnapshot::isEnabled())
+    {
+        PAGSnapshot snapshot(pag);
+        snapshot.write(snapshot.getFileName());
+    }
+
     pag->initialiseCandidatePointers();
 
     pag->setNodeNumAfterPAGBuild(pag->getTotalNodeNum());
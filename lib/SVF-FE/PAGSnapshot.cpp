@@ -0,0 +1,895 @@
+//===- PAGSnapshot.cpp -- Saving and restoring a built PAG -------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * PAGSnapshot.cpp
+ *
+ * Saving and restoring a built PAG, see PAGSnapshot.h
+ */
+
+#include "SVF-FE/PAGSnapshot.h"
+#include "SVF-FE/LLVMModule.h"
+#include "SVF-FE/SymbolTableInfo.h"
+#include "Util/SVFModule.h"
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+using namespace SVF;
+using namespace SVFUtil;
+
+static llvm::cl::opt<std::string> PAGSnapshotDir("pag-snapshot-dir", llvm::cl::init(""),
+        llvm::cl::value_desc("directory"),
+        llvm::cl::desc("Restore the PAG from a snapshot of the same modules in this directory, or write one after building it"));
+
+extern llvm::cl::list<std::string> ExternalPAGArgs;
+
+namespace
+{
+
+/*!
+ * Layout of a snapshot, all words are u32_t in host byte order:
+ *   header       magic[2] version fingerprint[2] checksum[2] numOfWords
+ *   nodes        num, {kind id payload}           nodes created by PAGBuilder, by ID
+ *   gepValMap    num, {curInst base ls id}        PAG::GepValNodeMap
+ *   edges        num, {kind id src dst value bb icfgNode payload}   by edge ID
+ *   instEdges    num, {icfgNode num, {edge}}      PAG::inst2PAGEdgesMap
+ *   globalEdges  num, {edge}
+ *   phi, binary, unary, cmp maps   num, {node num, {edge}}
+ *   funArgs      num, {fun num, {node}}
+ *   funRets      num, {fun node}
+ *   csArgs       num, {callsite num, {node}}
+ *   csRets       num, {callsite node}
+ *   callSites    num, {callsite}
+ *   indCallSites num, {callsite funPtr}
+ * Values are numbered from 2 (0: none, 1: the i8* null constant of PAGBuilder::addNullPtrNode),
+ * basic blocks and types from 1 (0: none).
+ */
+const u32_t PAGSnapshotMagic[2] = {0x50465653, 0x01474150};	// "SVFPPAG\1"
+const u32_t PAGSnapshotVersion = 1;
+const u32_t HeaderWords = 8;
+const u32_t NoId = ~0u;
+
+/// Node kinds in a snapshot
+enum SnapshotNodeKind
+{
+    GepValNodeKind, GepObjNodeKind, DummyValNodeKind
+};
+
+inline u64_t hashCombine(u64_t seed, u64_t v)
+{
+    return seed ^ (v + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+}
+
+inline void writeU64(std::vector<u32_t>& out, u64_t v)
+{
+    out.push_back((u32_t) v);
+    out.push_back((u32_t) (v >> 32));
+}
+
+/// Cursor over the words of a snapshot, reading past the end yields zeros and clears ok
+struct WordReader
+{
+    const std::vector<u32_t>& in;
+    size_t pos;
+    bool ok;
+
+    WordReader(const std::vector<u32_t>& w, size_t p) : in(w), pos(p), ok(true) {}
+
+    inline u32_t next()
+    {
+        if (pos >= in.size())
+        {
+            ok = false;
+            return 0;
+        }
+        return in[pos++];
+    }
+};
+
+u64_t checksum(const std::vector<u32_t>& words, size_t begin)
+{
+    u64_t sum = words.size();
+    for (size_t i = begin; i < words.size(); ++i)
+        sum = hashCombine(sum, words[i]);
+    return sum;
+}
+
+}
+
+/*!
+ * Constructor
+ */
+PAGSnapshot::PAGSnapshot(PAG* p) : pag(p), fingerprint(0), discarded(false)
+{
+    numberValues();
+    fingerprint = getFingerprint();
+}
+
+/*!
+ * Snapshots are not used for PAGs read from a text file or with external PAGs
+ */
+bool PAGSnapshot::isEnabled()
+{
+    return !PAGSnapshotDir.empty() && ExternalPAGArgs.empty() && !SVFModule::pagReadFromTXT();
+}
+
+/*!
+ * Snapshot file of the current modules
+ */
+std::string PAGSnapshot::getFileName() const
+{
+    std::ostringstream os;
+    os << PAGSnapshotDir << "/" << std::hex << std::setw(16) << std::setfill('0') << fingerprint << ".pag";
+    return os.str();
+}
+
+/*!
+ * Number the values, basic blocks and types of all modules in a deterministic order
+ */
+void PAGSnapshot::numberValues()
+{
+    LLVMModuleSet* modSet = LLVMModuleSet::getLLVMModuleSet();
+    for (u32_t i = 0; i < modSet->getModuleNum(); ++i)
+    {
+        Module* mod = modSet->getModule(i);
+        for (Module::global_iterator it = mod->global_begin(), eit = mod->global_end(); it != eit; ++it)
+            numberValue(&*it);
+        for (Module::alias_iterator it = mod->alias_begin(), eit = mod->alias_end(); it != eit; ++it)
+            numberValue(&*it);
+        for (Module::iterator fit = mod->begin(), efit = mod->end(); fit != efit; ++fit)
+        {
+            Function& fun = *fit;
+            numberValue(&fun);
+            for (Function::arg_iterator ait = fun.arg_begin(), eait = fun.arg_end(); ait != eait; ++ait)
+                numberValue(&*ait);
+            for (Function::iterator bit = fun.begin(), ebit = fun.end(); bit != ebit; ++bit)
+            {
+                bbToId[&*bit] = idToBB.size() + 1;
+                idToBB.push_back(&*bit);
+                for (BasicBlock::iterator iit = bit->begin(), eiit = bit->end(); iit != eiit; ++iit)
+                    numberValue(&*iit);
+            }
+        }
+    }
+
+    for (u32_t i = 0; i < idToValue.size(); ++i)
+        numberType(idToValue[i]->getType());
+}
+
+/*!
+ * Number a value and the constants it uses (global initializers, constant operands)
+ */
+void PAGSnapshot::numberValue(const Value* val)
+{
+    if (!valueToId.insert(std::make_pair(val, (u32_t) idToValue.size() + 2)).second)
+        return;
+    idToValue.push_back(val);
+
+    if (const User* user = SVFUtil::dyn_cast<User>(val))
+    {
+        for (u32_t i = 0; i < user->getNumOperands(); ++i)
+        {
+            if (const Constant* c = SVFUtil::dyn_cast<Constant>(user->getOperand(i)))
+                numberValue(c);
+        }
+    }
+}
+
+/*!
+ * Number a type and its contained types
+ */
+void PAGSnapshot::numberType(const Type* type)
+{
+    if (!typeToId.insert(std::make_pair(type, (u32_t) idToType.size() + 1)).second)
+        return;
+    idToType.push_back(type);
+
+    for (Type::subtype_iterator it = type->subtype_begin(), eit = type->subtype_end(); it != eit; ++it)
+        numberType(*it);
+}
+
+u32_t PAGSnapshot::getValueId(const Value* val) const
+{
+    if (val == NULL)
+        return 0;
+    Map<const Value*, u32_t>::const_iterator it = valueToId.find(val);
+    if (it != valueToId.end())
+        return it->second;
+    LLVMContext& cxt = LLVMModuleSet::getLLVMModuleSet()->getContext();
+    if (val == ConstantPointerNull::get(Type::getInt8PtrTy(cxt)))
+        return 1;
+    return NoId;
+}
+
+u32_t PAGSnapshot::getBBId(const BasicBlock* bb) const
+{
+    if (bb == NULL)
+        return 0;
+    Map<const BasicBlock*, u32_t>::const_iterator it = bbToId.find(bb);
+    return it == bbToId.end() ? NoId : it->second;
+}
+
+u32_t PAGSnapshot::getTypeId(const Type* type) const
+{
+    if (type == NULL)
+        return 0;
+    Map<const Type*, u32_t>::const_iterator it = typeToId.find(type);
+    return it == typeToId.end() ? NoId : it->second;
+}
+
+const Value* PAGSnapshot::getValue(u32_t id) const
+{
+    if (id == 0)
+        return NULL;
+    if (id == 1)
+        return ConstantPointerNull::get(Type::getInt8PtrTy(LLVMModuleSet::getLLVMModuleSet()->getContext()));
+    assert(id - 2 < idToValue.size() && "value not in the modules?");
+    return idToValue[id - 2];
+}
+
+/*!
+ * Fingerprint of a value: its kind, type, name, operands (by number) and, for constants
+ * and instructions, what their operands do not capture
+ */
+u64_t PAGSnapshot::getValueFingerprint(const Value* val) const
+{
+    std::hash<std::string> strHash;
+    u64_t fp = hashCombine(val->getValueID(), getTypeId(val->getType()));
+    if (val->hasName())
+        fp = hashCombine(fp, strHash(val->getName().str()));
+
+    if (const User* user = SVFUtil::dyn_cast<User>(val))
+    {
+        fp = hashCombine(fp, user->getNumOperands());
+        for (u32_t i = 0; i < user->getNumOperands(); ++i)
+        {
+            const Value* op = user->getOperand(i);
+            if (const BasicBlock* bb = SVFUtil::dyn_cast<BasicBlock>(op))
+                fp = hashCombine(fp, ((u64_t) 1 << 32) | getBBId(bb));
+            else
+                fp = hashCombine(fp, getValueId(op));
+        }
+    }
+
+    if (const ConstantInt* ci = SVFUtil::dyn_cast<ConstantInt>(val))
+        fp = hashCombine(fp, llvm::hash_value(ci->getValue()));
+    else if (const ConstantFP* cf = SVFUtil::dyn_cast<ConstantFP>(val))
+        fp = hashCombine(fp, llvm::hash_value(cf->getValueAPF().bitcastToAPInt()));
+    else if (const ConstantDataSequential* cds = SVFUtil::dyn_cast<ConstantDataSequential>(val))
+        fp = hashCombine(fp, strHash(cds->getRawDataValues().str()));
+    else if (const ConstantExpr* ce = SVFUtil::dyn_cast<ConstantExpr>(val))
+        fp = hashCombine(fp, ce->getOpcode());
+    else if (const Instruction* inst = SVFUtil::dyn_cast<Instruction>(val))
+    {
+        fp = hashCombine(fp, inst->getOpcode());
+        if (const AllocaInst* alloca = SVFUtil::dyn_cast<AllocaInst>(inst))
+            fp = hashCombine(fp, getTypeId(alloca->getAllocatedType()));
+        else if (const GetElementPtrInst* gep = SVFUtil::dyn_cast<GetElementPtrInst>(inst))
+            fp = hashCombine(fp, getTypeId(gep->getSourceElementType()));
+        else if (const CmpInst* cmp = SVFUtil::dyn_cast<CmpInst>(inst))
+            fp = hashCombine(fp, cmp->getPredicate());
+    }
+    return fp;
+}
+
+/*!
+ * Fingerprint of a type: its kind, contained types (by number) and shape
+ */
+u64_t PAGSnapshot::getTypeFingerprint(const Type* type) const
+{
+    u64_t fp = hashCombine(type->getTypeID(), type->getNumContainedTypes());
+    for (Type::subtype_iterator it = type->subtype_begin(), eit = type->subtype_end(); it != eit; ++it)
+        fp = hashCombine(fp, getTypeId(*it));
+
+    if (const IntegerType* intTy = SVFUtil::dyn_cast<IntegerType>(type))
+        fp = hashCombine(fp, intTy->getBitWidth());
+    else if (const ArrayType* arrTy = SVFUtil::dyn_cast<ArrayType>(type))
+        fp = hashCombine(fp, arrTy->getNumElements());
+    else if (const VectorType* vecTy = SVFUtil::dyn_cast<VectorType>(type))
+        fp = hashCombine(fp, vecTy->getNumElements());
+    else if (const StructType* stTy = SVFUtil::dyn_cast<StructType>(type))
+    {
+        fp = hashCombine(fp, stTy->isPacked());
+        if (stTy->hasName())
+            fp = hashCombine(fp, std::hash<std::string>()(stTy->getName().str()));
+    }
+    return fp;
+}
+
+/*!
+ * Fingerprint of the values and types of the modules, of the symbol table built from them
+ * and of the options and external API models shaping the PAG
+ */
+u64_t PAGSnapshot::getFingerprint() const
+{
+    u64_t fp = hashCombine(PAGSnapshotVersion, idToValue.size());
+    for (const Value* val : idToValue)
+        fp = hashCombine(fp, getValueFingerprint(val));
+    fp = hashCombine(fp, idToBB.size());
+    fp = hashCombine(fp, idToType.size());
+    for (const Type* type : idToType)
+        fp = hashCombine(fp, getTypeFingerprint(type));
+
+    SymbolTableInfo* symInfo = SymbolTableInfo::Symbolnfo();
+    fp = hashCombine(fp, symInfo->getTotalSymNum());
+    fp = hashCombine(fp, symInfo->valSyms().size());
+    fp = hashCombine(fp, symInfo->objSyms().size());
+    fp = hashCombine(fp, StInfo::getMaxFieldLimit());
+    fp = hashCombine(fp, symInfo->getModelConstants());
+    fp = hashCombine(fp, SymbolTableInfo::isLocMemModel());
+    fp = hashCombine(fp, LocationSet::isSingleStride());
+    fp = hashCombine(fp, PAG::isHandlingBlackHole());
+    fp = hashCombine(fp, PAG::isFirstFieldEqBase());
+
+    /// how external functions are modelled, which the PAG edges of their calls follow
+    SVFModule* svfModule = pag->getModule();
+    for (SVFModule::const_iterator it = svfModule->begin(), eit = svfModule->end(); it != eit; ++it)
+    {
+        if ((*it)->isDeclaration())
+            fp = hashCombine(fp, ExtAPI::getExtAPI()->get_type(*it));
+    }
+    return fp;
+}
+
+void PAGSnapshot::writeICFGNode(Words& out, const ICFGNode* node) const
+{
+    out.push_back(node->getNodeKind());
+    if (const IntraBlockNode* intra = SVFUtil::dyn_cast<IntraBlockNode>(node))
+        out.push_back(getValueId(intra->getInst()));
+    else if (const FunEntryBlockNode* entry = SVFUtil::dyn_cast<FunEntryBlockNode>(node))
+        out.push_back(getValueId(entry->getFun()->getLLVMFun()));
+    else if (const FunExitBlockNode* exit = SVFUtil::dyn_cast<FunExitBlockNode>(node))
+        out.push_back(getValueId(exit->getFun()->getLLVMFun()));
+    else if (const CallBlockNode* call = SVFUtil::dyn_cast<CallBlockNode>(node))
+        out.push_back(getValueId(call->getCallSite()));
+    else if (const RetBlockNode* ret = SVFUtil::dyn_cast<RetBlockNode>(node))
+        out.push_back(getValueId(ret->getCallSite()));
+    else
+        out.push_back(0);
+}
+
+ICFGNode* PAGSnapshot::readICFGNode(u32_t kind, u32_t val) const
+{
+    ICFG* icfg = pag->getICFG();
+    const Value* v = getValue(val);
+    switch (kind)
+    {
+    case ICFGNode::IntraBlock:
+        return icfg->getIntraBlockNode(SVFUtil::cast<Instruction>(v));
+    case ICFGNode::FunEntryBlock:
+        return icfg->getFunEntryBlockNode(LLVMModuleSet::getLLVMModuleSet()->getSVFFunction(SVFUtil::cast<Function>(v)));
+    case ICFGNode::FunExitBlock:
+        return icfg->getFunExitBlockNode(LLVMModuleSet::getLLVMModuleSet()->getSVFFunction(SVFUtil::cast<Function>(v)));
+    case ICFGNode::FunCallBlock:
+        return icfg->getCallBlockNode(SVFUtil::cast<Instruction>(v));
+    case ICFGNode::FunRetBlock:
+        return icfg->getRetBlockNode(SVFUtil::cast<Instruction>(v));
+    default:
+        return icfg->getGlobalBlockNode();
+    }
+}
+
+void PAGSnapshot::writeLocationSet(Words& out, const LocationSet& ls) const
+{
+    out.push_back((u32_t) ls.getOffset());
+    out.push_back((u32_t) ls.getByteOffset());
+    const LocationSet::ElemNumStridePairVec& vec = ls.getNumStridePair();
+    out.push_back(vec.size());
+    for (LocationSet::ElemNumStridePairVec::const_iterator it = vec.begin(), eit = vec.end(); it != eit; ++it)
+    {
+        out.push_back(it->first);
+        out.push_back(it->second);
+    }
+}
+
+LocationSet PAGSnapshot::readLocationSet(const Words& in, size_t& pos) const
+{
+    WordReader r(in, pos);
+    LocationSet ls((Size_t) (s32_t) r.next());
+    ls.setByteOffset((Size_t) (s32_t) r.next());
+    u32_t num = r.next();
+    for (u32_t i = 0; i < num && r.ok; ++i)
+    {
+        u32_t elemNum = r.next();
+        u32_t stride = r.next();
+        ls.addElemNumStridePair(std::make_pair(elemNum, stride));
+    }
+    pos = r.pos;
+    return ls;
+}
+
+/*!
+ * Write the PAG just built by PAGBuilder
+ */
+bool PAGSnapshot::write(const std::string& filename)
+{
+    Words out(HeaderWords, 0);
+    bool ok = true;
+    SymbolTableInfo* symInfo = SymbolTableInfo::Symbolnfo();
+
+    /// nodes created while building, i.e., beyond the symbol table
+    OrderedMap<NodeID, const PAGNode*> nodes;
+    for (PAG::iterator it = pag->begin(), eit = pag->end(); it != eit; ++it)
+    {
+        if (it->first >= (NodeID) symInfo->getTotalSymNum())
+            nodes[it->first] = it->second;
+    }
+    out.push_back(nodes.size());
+    for (OrderedMap<NodeID, const PAGNode*>::const_iterator it = nodes.begin(), eit = nodes.end(); it != eit; ++it)
+    {
+        if (const GepValPN* gepVal = SVFUtil::dyn_cast<GepValPN>(it->second))
+        {
+            out.push_back(GepValNodeKind);
+            out.push_back(it->first);
+            out.push_back(getValueId(gepVal->getValue()));
+            writeLocationSet(out, gepVal->getLocationSet());
+            out.push_back(getTypeId(gepVal->getType()));
+            out.push_back(gepVal->getFieldIdx());
+            ok &= out[out.size() - 2] != NoId;
+        }
+        else if (const GepObjPN* gepObj = SVFUtil::dyn_cast<GepObjPN>(it->second))
+        {
+            out.push_back(GepObjNodeKind);
+            out.push_back(it->first);
+            out.push_back(gepObj->getMemObj()->getSymId());
+            writeLocationSet(out, gepObj->getLocationSet());
+        }
+        else if (SVFUtil::isa<DummyValPN>(it->second))
+        {
+            out.push_back(DummyValNodeKind);
+            out.push_back(it->first);
+        }
+        else
+        {
+            writeWrnMsg("PAG snapshot: unsupported node " + it->second->toString());
+            return false;
+        }
+    }
+
+    u32_t numOfGepVals = 0;
+    size_t numPos = out.size();
+    out.push_back(0);
+    for (PAG::GepValPNMap::const_iterator it = pag->GepValNodeMap.begin(), eit = pag->GepValNodeMap.end(); it != eit; ++it)
+    {
+        for (PAG::NodeLocationSetMap::const_iterator lit = it->second.begin(), elit = it->second.end(); lit != elit; ++lit)
+        {
+            out.push_back(getValueId(it->first));
+            ok &= out.back() != NoId;
+            out.push_back(lit->first.first);
+            writeLocationSet(out, lit->first.second);
+            out.push_back(lit->second);
+            numOfGepVals++;
+        }
+    }
+    out[numPos] = numOfGepVals;
+
+    /// edges, in the order they were created
+    OrderedMap<EdgeID, const PAGEdge*> edges;
+    for (PAGEdge::PAGKindToEdgeSetMapTy::const_iterator it = pag->PAGEdgeKindToSetMap.begin(),
+            eit = pag->PAGEdgeKindToSetMap.end(); it != eit; ++it)
+    {
+        for (PAGEdge::PAGEdgeSetTy::const_iterator eIt = it->second.begin(), eEit = it->second.end(); eIt != eEit; ++eIt)
+            edges[(*eIt)->getEdgeID()] = *eIt;
+    }
+    out.push_back(edges.size());
+    for (OrderedMap<EdgeID, const PAGEdge*>::const_iterator it = edges.begin(), eit = edges.end(); it != eit; ++it)
+    {
+        const PAGEdge* edge = it->second;
+        out.push_back(edge->getEdgeKind());
+        out.push_back(it->first);
+        out.push_back(edge->getSrcID());
+        out.push_back(edge->getDstID());
+        out.push_back(getValueId(edge->getValue()));
+        ok &= out.back() != NoId;
+        out.push_back(getBBId(edge->getBB()));
+        ok &= out.back() != NoId;
+        if (edge->getICFGNode() == NULL)
+        {
+            writeWrnMsg("PAG snapshot: edge without ICFG node " + edge->toString());
+            return false;
+        }
+        writeICFGNode(out, edge->getICFGNode());
+        if (const NormalGepPE* gep = SVFUtil::dyn_cast<NormalGepPE>(edge))
+            writeLocationSet(out, gep->getLocationSet());
+        else if (const CallPE* call = SVFUtil::dyn_cast<CallPE>(edge))
+            out.push_back(getValueId(call->getCallSite()->getCallSite()));
+        else if (const RetPE* ret = SVFUtil::dyn_cast<RetPE>(edge))
+            out.push_back(getValueId(ret->getCallSite()->getCallSite()));
+    }
+
+    out.push_back(pag->inst2PAGEdgesMap.size());
+    for (PAG::Inst2PAGEdgesMap::const_iterator it = pag->inst2PAGEdgesMap.begin(), eit = pag->inst2PAGEdgesMap.end(); it != eit; ++it)
+    {
+        writeICFGNode(out, it->first);
+        out.push_back(it->second.size());
+        for (const PAGEdge* edge : it->second)
+            out.push_back(edge->getEdgeID());
+    }
+
+    out.push_back(pag->globPAGEdgesSet.size());
+    for (const PAGEdge* edge : pag->globPAGEdgesSet)
+        out.push_back(edge->getEdgeID());
+
+    /// phi, binary, unary and cmp maps have the same shape
+    auto writeNodeToEdges = [&out](const PAGNode* node, u32_t num)
+    {
+        out.push_back(node->getId());
+        out.push_back(num);
+    };
+    out.push_back(pag->phiNodeMap.size());
+    for (PAG::PHINodeMap::const_iterator it = pag->phiNodeMap.begin(), eit = pag->phiNodeMap.end(); it != eit; ++it)
+    {
+        writeNodeToEdges(it->first, it->second.size());
+        for (const PAGEdge* edge : it->second)
+            out.push_back(edge->getEdgeID());
+    }
+    out.push_back(pag->binaryNodeMap.size());
+    for (PAG::BinaryNodeMap::const_iterator it = pag->binaryNodeMap.begin(), eit = pag->binaryNodeMap.end(); it != eit; ++it)
+    {
+        writeNodeToEdges(it->first, it->second.size());
+        for (const PAGEdge* edge : it->second)
+            out.push_back(edge->getEdgeID());
+    }
+    out.push_back(pag->unaryNodeMap.size());
+    for (PAG::UnaryNodeMap::const_iterator it = pag->unaryNodeMap.begin(), eit = pag->unaryNodeMap.end(); it != eit; ++it)
+    {
+        writeNodeToEdges(it->first, it->second.size());
+        for (const PAGEdge* edge : it->second)
+            out.push_back(edge->getEdgeID());
+    }
+    out.push_back(pag->cmpNodeMap.size());
+    for (PAG::CmpNodeMap::const_iterator it = pag->cmpNodeMap.begin(), eit = pag->cmpNodeMap.end(); it != eit; ++it)
+    {
+        writeNodeToEdges(it->first, it->second.size());
+        for (const PAGEdge* edge : it->second)
+            out.push_back(edge->getEdgeID());
+    }
+
+    /// arguments and returns of functions and call sites
+    out.push_back(pag->funArgsListMap.size());
+    for (PAG::FunToArgsListMap::const_iterator it = pag->funArgsListMap.begin(), eit = pag->funArgsListMap.end(); it != eit; ++it)
+    {
+        out.push_back(getValueId(it->first->getLLVMFun()));
+        out.push_back(it->second.size());
+        for (const PAGNode* node : it->second)
+            out.push_back(node->getId());
+    }
+    out.push_back(pag->funRetMap.size());
+    for (PAG::FunToRetMap::const_iterator it = pag->funRetMap.begin(), eit = pag->funRetMap.end(); it != eit; ++it)
+    {
+        out.push_back(getValueId(it->first->getLLVMFun()));
+        out.push_back(it->second->getId());
+    }
+    out.push_back(pag->callSiteArgsListMap.size());
+    for (PAG::CSToArgsListMap::const_iterator it = pag->callSiteArgsListMap.begin(), eit = pag->callSiteArgsListMap.end(); it != eit; ++it)
+    {
+        out.push_back(getValueId(it->first->getCallSite()));
+        out.push_back(it->second.size());
+        for (const PAGNode* node : it->second)
+            out.push_back(node->getId());
+    }
+    out.push_back(pag->callSiteRetMap.size());
+    for (PAG::CSToRetMap::const_iterator it = pag->callSiteRetMap.begin(), eit = pag->callSiteRetMap.end(); it != eit; ++it)
+    {
+        out.push_back(getValueId(it->first->getCallSite()));
+        out.push_back(it->second->getId());
+    }
+    out.push_back(pag->callSiteSet.size());
+    for (const CallBlockNode* cs : pag->callSiteSet)
+        out.push_back(getValueId(cs->getCallSite()));
+    out.push_back(pag->indCallSiteToFunPtrMap.size());
+    for (PAG::CallSiteToFunPtrMap::const_iterator it = pag->indCallSiteToFunPtrMap.begin(),
+            eit = pag->indCallSiteToFunPtrMap.end(); it != eit; ++it)
+    {
+        out.push_back(getValueId(it->first->getCallSite()));
+        out.push_back(it->second);
+    }
+
+    if (!ok)
+    {
+        writeWrnMsg("PAG snapshot: a value of the PAG is not in the modules, no snapshot written");
+        return false;
+    }
+
+    out[0] = PAGSnapshotMagic[0];
+    out[1] = PAGSnapshotMagic[1];
+    out[2] = PAGSnapshotVersion;
+    out[3] = (u32_t) fingerprint;
+    out[4] = (u32_t) (fingerprint >> 32);
+    u64_t sum = checksum(out, HeaderWords);
+    out[5] = (u32_t) sum;
+    out[6] = (u32_t) (sum >> 32);
+    out[7] = out.size();
+
+    std::ofstream F(filename.c_str(), std::ios::binary);
+    if (!F.is_open())
+    {
+        writeWrnMsg("PAG snapshot: cannot write " + filename);
+        return false;
+    }
+    F.write((const char*) out.data(), out.size() * sizeof(u32_t));
+    F.close();
+    outs() << "PAG snapshot written to '" << filename << "'\n";
+    return true;
+}
+
+/*!
+ * Read a snapshot, restoring the PAG only if the snapshot is complete and matches the modules
+ */
+bool PAGSnapshot::read(const std::string& filename)
+{
+    std::ifstream F(filename.c_str(), std::ios::binary | std::ios::ate);
+    if (!F.is_open())
+        return false;
+
+    std::streamsize size = F.tellg();
+    if (size < (std::streamsize) (HeaderWords * sizeof(u32_t)) || size % sizeof(u32_t) != 0)
+        return false;
+    Words in(size / sizeof(u32_t));
+    F.seekg(0);
+    if (!F.read((char*) in.data(), size))
+        return false;
+
+    u64_t fp = ((u64_t) in[4] << 32) | in[3];
+    u64_t sum = ((u64_t) in[6] << 32) | in[5];
+    if (in[0] != PAGSnapshotMagic[0] || in[1] != PAGSnapshotMagic[1] || in[2] != PAGSnapshotVersion
+            || fp != fingerprint || in[7] != in.size() || sum != checksum(in, HeaderWords))
+    {
+        writeWrnMsg("PAG snapshot: ignoring " + filename + " (does not match the modules)");
+        return false;
+    }
+
+    if (!restore(in))
+    {
+        writeWrnMsg("PAG snapshot: ignoring " + filename + " (malformed), discarding the partly restored PAG");
+        pag = PAG::resetPAG();
+        discarded = true;
+        return false;
+    }
+    outs() << "PAG restored from snapshot '" << filename << "'\n";
+    return true;
+}
+
+/*!
+ * Recreate the nodes, edges and maps recorded in a snapshot
+ */
+bool PAGSnapshot::restore(const Words& in)
+{
+    WordReader r(in, HeaderWords);
+    SymbolTableInfo* symInfo = SymbolTableInfo::Symbolnfo();
+    LLVMModuleSet* modSet = LLVMModuleSet::getLLVMModuleSet();
+
+    u32_t numOfNodes = r.next();
+    for (u32_t i = 0; i < numOfNodes && r.ok; ++i)
+    {
+        u32_t kind = r.next();
+        NodeID id = r.next();
+        if (kind == GepValNodeKind)
+        {
+            const Value* val = getValue(r.next());
+            LocationSet ls = readLocationSet(in, r.pos);
+            u32_t typeId = r.next();
+            const Type* type = typeId == 0 || typeId > idToType.size() ? NULL : idToType[typeId - 1];
+            u32_t fieldIdx = r.next();
+            pag->addValNode(val, new GepValPN(val, id, ls, type, fieldIdx), id);
+        }
+        else if (kind == GepObjNodeKind)
+        {
+            const MemObj* obj = symInfo->getObj(r.next());
+            LocationSet ls = readLocationSet(in, r.pos);
+            NodeID gepId = pag->addGepObjNode(obj, ls);
+            if (gepId != id)
+                return false;
+        }
+        else if (kind == DummyValNodeKind)
+            pag->addDummyValNode(id);
+        else
+            return false;
+    }
+
+    u32_t numOfGepVals = r.next();
+    for (u32_t i = 0; i < numOfGepVals && r.ok; ++i)
+    {
+        const Value* curInst = getValue(r.next());
+        NodeID base = r.next();
+        LocationSet ls = readLocationSet(in, r.pos);
+        pag->GepValNodeMap[curInst][std::make_pair(base, ls)] = r.next();
+    }
+
+    /// edges created by initalNode are found again, the lists below replace its lists
+    pag->inst2PAGEdgesMap.clear();
+    pag->inst2PTAPAGEdgesMap.clear();
+    pag->globPAGEdgesSet.clear();
+
+    Map<EdgeID, PAGEdge*> idToEdge;
+    u32_t numOfEdges = r.next();
+    for (u32_t i = 0; i < numOfEdges && r.ok; ++i)
+    {
+        u32_t kind = r.next();
+        EdgeID id = r.next();
+        NodeID src = r.next();
+        NodeID dst = r.next();
+        const Value* val = getValue(r.next());
+        u32_t bbId = r.next();
+        const BasicBlock* bb = bbId == 0 || bbId > idToBB.size() ? NULL : idToBB[bbId - 1];
+        u32_t icfgKind = r.next();
+        ICFGNode* icfgNode = readICFGNode(icfgKind, r.next());
+        if (!r.ok || !pag->hasGNode(src) || !pag->hasGNode(dst))
+            return false;
+
+        PAGEdge* edge = NULL;
+        switch (kind)
+        {
+        case PAGEdge::Addr:
+            edge = pag->addAddrPE(src, dst);
+            break;
+        case PAGEdge::Copy:
+            edge = pag->addCopyPE(src, dst);
+            break;
+        case PAGEdge::Cmp:
+            edge = pag->addCmpPE(src, dst);
+            break;
+        case PAGEdge::BinaryOp:
+            edge = pag->addBinaryOPPE(src, dst);
+            break;
+        case PAGEdge::UnaryOp:
+            edge = pag->addUnaryOPPE(src, dst);
+            break;
+        case PAGEdge::Load:
+            edge = pag->addLoadPE(src, dst);
+            break;
+        case PAGEdge::Store:
+        {
+            const Instruction* inst = val ? SVFUtil::dyn_cast<Instruction>(val) : NULL;
+            edge = pag->addStorePE(src, dst, inst ? pag->getICFG()->getIntraBlockNode(inst) : NULL);
+            break;
+        }
+        case PAGEdge::NormalGep:
+            edge = pag->addNormalGepPE(src, dst, readLocationSet(in, r.pos));
+            break;
+        case PAGEdge::VariantGep:
+            edge = pag->addVariantGepPE(src, dst);
+            break;
+        case PAGEdge::Call:
+        case PAGEdge::ThreadFork:
+        {
+            const CallBlockNode* cs = pag->getICFG()->getCallBlockNode(SVFUtil::cast<Instruction>(getValue(r.next())));
+            edge = kind == PAGEdge::Call ? (PAGEdge*) pag->addCallPE(src, dst, cs) : (PAGEdge*) pag->addThreadForkPE(src, dst, cs);
+            break;
+        }
+        case PAGEdge::Ret:
+        case PAGEdge::ThreadJoin:
+        {
+            const CallBlockNode* cs = pag->getICFG()->getCallBlockNode(SVFUtil::cast<Instruction>(getValue(r.next())));
+            edge = kind == PAGEdge::Ret ? (PAGEdge*) pag->addRetPE(src, dst, cs) : (PAGEdge*) pag->addThreadJoinPE(src, dst, cs);
+            break;
+        }
+        default:
+            return false;
+        }
+        edge->setValue(val);
+        edge->setBB(bb);
+        edge->setICFGNode(icfgNode);
+        idToEdge[id] = edge;
+    }
+
+    auto readEdge = [&r, &idToEdge]() -> PAGEdge*
+    {
+        Map<EdgeID, PAGEdge*>::const_iterator it = idToEdge.find(r.next());
+        if (it == idToEdge.end())
+        {
+            r.ok = false;
+            return NULL;
+        }
+        return it->second;
+    };
+
+    u32_t numOfInsts = r.next();
+    for (u32_t i = 0; i < numOfInsts && r.ok; ++i)
+    {
+        u32_t icfgKind = r.next();
+        ICFGNode* icfgNode = readICFGNode(icfgKind, r.next());
+        u32_t num = r.next();
+        PAG::PAGEdgeList& edgeList = pag->inst2PAGEdgesMap[icfgNode];
+        for (u32_t j = 0; j < num && r.ok; ++j)
+        {
+            if (PAGEdge* edge = readEdge())
+            {
+                edgeList.push_back(edge);
+                if (edge->isPTAEdge())
+                    pag->inst2PTAPAGEdgesMap[icfgNode].push_back(edge);
+            }
+        }
+    }
+
+    u32_t numOfGlobalEdges = r.next();
+    for (u32_t i = 0; i < numOfGlobalEdges && r.ok; ++i)
+    {
+        if (PAGEdge* edge = readEdge())
+            pag->addGlobalPAGEdge(edge);
+    }
+
+    for (u32_t map = 0; map < 4 && r.ok; ++map)
+    {
+        u32_t numOfNodesInMap = r.next();
+        for (u32_t i = 0; i < numOfNodesInMap && r.ok; ++i)
+        {
+            const PAGNode* node = pag->getGNode(r.next());
+            u32_t num = r.next();
+            for (u32_t j = 0; j < num && r.ok; ++j)
+            {
+                PAGEdge* edge = readEdge();
+                if (edge == NULL)
+                    break;
+                if (map == 0)
+                    pag->addPhiNode(node, SVFUtil::cast<CopyPE>(edge));
+                else if (map == 1)
+                    pag->addBinaryNode(node, SVFUtil::cast<BinaryOPPE>(edge));
+                else if (map == 2)
+                    pag->addUnaryNode(node, SVFUtil::cast<UnaryOPPE>(edge));
+                else
+                    pag->addCmpNode(node, SVFUtil::cast<CmpPE>(edge));
+            }
+        }
+    }
+
+    u32_t numOfFunArgs = r.next();
+    for (u32_t i = 0; i < numOfFunArgs && r.ok; ++i)
+    {
+        const SVFFunction* fun = modSet->getSVFFunction(SVFUtil::cast<Function>(getValue(r.next())));
+        u32_t num = r.next();
+        for (u32_t j = 0; j < num && r.ok; ++j)
+            pag->addFunArgs(fun, pag->getGNode(r.next()));
+    }
+    u32_t numOfFunRets = r.next();
+    for (u32_t i = 0; i < numOfFunRets && r.ok; ++i)
+    {
+        const SVFFunction* fun = modSet->getSVFFunction(SVFUtil::cast<Function>(getValue(r.next())));
+        pag->addFunRet(fun, pag->getGNode(r.next()));
+    }
+    u32_t numOfCSArgs = r.next();
+    for (u32_t i = 0; i < numOfCSArgs && r.ok; ++i)
+    {
+        CallBlockNode* cs = pag->getICFG()->getCallBlockNode(SVFUtil::cast<Instruction>(getValue(r.next())));
+        u32_t num = r.next();
+        for (u32_t j = 0; j < num && r.ok; ++j)
+            pag->addCallSiteArgs(cs, pag->getGNode(r.next()));
+    }
+    u32_t numOfCSRets = r.next();
+    for (u32_t i = 0; i < numOfCSRets && r.ok; ++i)
+    {
+        RetBlockNode* cs = pag->getICFG()->getRetBlockNode(SVFUtil::cast<Instruction>(getValue(r.next())));
+        pag->addCallSiteRets(cs, pag->getGNode(r.next()));
+    }
+    u32_t numOfCallSites = r.next();
+    for (u32_t i = 0; i < numOfCallSites && r.ok; ++i)
+        pag->addCallSite(pag->getICFG()->getCallBlockNode(SVFUtil::cast<Instruction>(getValue(r.next()))));
+    u32_t numOfIndCallSites = r.next();
+    for (u32_t i = 0; i < numOfIndCallSites && r.ok; ++i)
+    {
+        const CallBlockNode* cs = pag->getICFG()->getCallBlockNode(SVFUtil::cast<Instruction>(getValue(r.next())));
+        pag->addIndirectCallsites(cs, r.next());
+    }
+
+    return r.ok && r.pos == in.size();
+}
@@ -55,6 +55,11 @@ static llvm::cl::opt<bool> LocMemModel("locMM", llvm::cl::init(false),
 static llvm::cl::opt<bool> modelConsts("modelConsts", llvm::cl::init(false),
                                        llvm::cl::desc("Modeling individual constant objects"));
 
+bool SymbolTableInfo::isLocMemModel()
+{
+    return LocMemModel;
+}
+
 
 
 /*
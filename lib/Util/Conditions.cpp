@@ -31,15 +31,26 @@
 #include "Util/Conditions.h"
 #include "Util/SVFUtil.h"
 
+#include <algorithm>
+
 using namespace SVF;
 
 static llvm::cl::opt<unsigned> maxBddSize("maxbddsize",  llvm::cl::init(100000),
         llvm::cl::desc("Maximum context limit for DDA"));
 
+static llvm::cl::opt<unsigned> maxCondDagVars("cond-dag-vars",  llvm::cl::init(10),
+        llvm::cl::desc("Maximum number of branch conditions of a DAG condition keeping a truth table (at most 16)"));
+
+/// Truth tables have 2^n bits, and larger ones would take too long to build
+static const unsigned maxTruthTableVars = 16;
+
+static llvm::cl::opt<unsigned> maxCondDagSize("max-cond-dag-size",  llvm::cl::init(100000),
+        llvm::cl::desc("Maximum number of nodes of a DAG condition"));
+
 /// Operations on conditions.
 //@{
 /// use Cudd_bddAndLimit interface to avoid bdds blow up
-DdNode* BddCondManager::AND(DdNode* lhs, DdNode* rhs)
+CondExpr* BddCondManager::AND(CondExpr* lhs, CondExpr* rhs)
 {
     if (lhs == getFalseCond() || rhs == getFalseCond())
         return getFalseCond();
@@ -49,17 +60,18 @@ DdNode* BddCondManager::AND(DdNode* lhs, DdNode* rhs)
         return lhs;
     else
     {
-        DdNode* tmp = Cudd_bddAndLimit(m_bdd_mgr, lhs, rhs, maxBddSize);
+        DdNode* tmp = Cudd_bddAndLimit(m_bdd_mgr, toBdd(lhs), toBdd(rhs), maxBddSize);
         if(tmp==NULL)
         {
             SVFUtil::writeWrnMsg("exceeds max bdd size \n");
+            numOfApprox++;
             ///drop the rhs condition
             return lhs;
         }
         else
         {
             Cudd_Ref(tmp);
-            return tmp;
+            return toCond(tmp);
         }
     }
 }
@@ -67,7 +79,7 @@ DdNode* BddCondManager::AND(DdNode* lhs, DdNode* rhs)
 /*!
  * Use Cudd_bddOrLimit interface to avoid bdds blow up
  */
-DdNode* BddCondManager::OR(DdNode* lhs, DdNode* rhs)
+CondExpr* BddCondManager::OR(CondExpr* lhs, CondExpr* rhs)
 {
     if (lhs == getTrueCond() || rhs == getTrueCond())
         return getTrueCond();
@@ -77,29 +89,30 @@ DdNode* BddCondManager::OR(DdNode* lhs, DdNode* rhs)
         return lhs;
     else
     {
-        DdNode* tmp = Cudd_bddOrLimit(m_bdd_mgr, lhs, rhs, maxBddSize);
+        DdNode* tmp = Cudd_bddOrLimit(m_bdd_mgr, toBdd(lhs), toBdd(rhs), maxBddSize);
         if(tmp==NULL)
         {
             SVFUtil::writeWrnMsg("exceeds max bdd size \n");
+            numOfApprox++;
             /// drop the two conditions here
             return getTrueCond();
         }
         else
         {
             Cudd_Ref(tmp);
-            return tmp;
+            return toCond(tmp);
         }
     }
 }
 
-DdNode* BddCondManager::NEG(DdNode* lhs)
+CondExpr* BddCondManager::NEG(CondExpr* lhs)
 {
     if (lhs == getTrueCond())
         return getFalseCond();
     else if (lhs == getFalseCond())
         return getTrueCond();
     else
-        return Cudd_Not(lhs);
+        return toCond(Cudd_Not(toBdd(lhs)));
 }
 //@}
 
@@ -133,16 +146,16 @@ void BddCondManager::BddSupportStep(DdNode * f, NodeBS &support) const
     f->next = Cudd_Complement(f->next);
 }
 
-void BddCondManager::BddSupport(DdNode * f, NodeBS &support) const
+void BddCondManager::BddSupport(CondExpr* f, NodeBS &support) const
 {
-    BddSupportStep( Cudd_Regular(f), support);
-    ddClearFlag(Cudd_Regular(f));
+    BddSupportStep( Cudd_Regular(toBdd(f)), support);
+    ddClearFlag(Cudd_Regular(toBdd(f)));
 }
 
 /*!
  * Dump BDD
  */
-void BddCondManager::dump(DdNode* lhs, raw_ostream & O)
+void BddCondManager::dump(CondExpr* lhs, raw_ostream & O)
 {
     if (lhs == getTrueCond())
         O << "T";
@@ -162,7 +175,7 @@ void BddCondManager::dump(DdNode* lhs, raw_ostream & O)
 /*!
  * Dump BDD
  */
-std::string BddCondManager::dumpStr(DdNode* lhs) const
+std::string BddCondManager::dumpStr(CondExpr* lhs) const
 {
     std::string str;
     if (lhs == getTrueCond())
@@ -184,3 +197,422 @@ std::string BddCondManager::dumpStr(DdNode* lhs) const
     return str;
 }
 
+/// Kinds of DAG nodes
+enum DagKind
+{
+    DAG_TRUE,
+    DAG_FALSE,
+    DAG_VAR,
+    DAG_NEG,
+    DAG_AND,
+    DAG_OR
+};
+
+/*!
+ * Node of a DAG condition
+ */
+struct DagCondManager::DagNode
+{
+    DagNode(u32_t k, u32_t v, const DagNodeVec& o) : id(0), kind(k), var(v), size(1), ops(o), hasTT(false) {}
+
+    u32_t id;
+    u32_t kind;
+    u32_t var;		///< branch index of an atomic condition
+    u32_t size;		///< number of nodes, shared operands counted once per use
+    DagNodeVec ops;	///< operands sorted by ID
+    NodeBS support;	///< branch indices the condition depends on
+    bool hasTT;		///< whether the support is narrow enough for a truth table
+    std::vector<u32_t> vars;	///< support as a sorted vector, if hasTT
+    TruthTable tt;	///< bit a is the value when vars[j] is bit j of a, if hasTT
+};
+
+/// Words of a truth table over n variables
+static inline u32_t ttWords(u32_t n)
+{
+    return n <= 6 ? 1 : (1u << (n - 6));
+}
+
+/// Mask of the bits used in the last word of a truth table over n variables
+static inline u64_t ttMask(u32_t n)
+{
+    return n >= 6 ? ~0ULL : ((1ULL << (1u << n)) - 1);
+}
+
+static inline bool ttBit(const std::vector<u64_t>& tt, u64_t a)
+{
+    return (tt[a >> 6] >> (a & 63)) & 1;
+}
+
+static inline void ttSet(std::vector<u64_t>& tt, u64_t a)
+{
+    tt[a >> 6] |= 1ULL << (a & 63);
+}
+
+size_t DagCondManager::KeyHash::operator()(const std::vector<u64_t>& key) const
+{
+    size_t h = key.size();
+    for (u64_t k : key)
+        h ^= std::hash<u64_t>()(k) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    return h;
+}
+
+DagCondManager::DagCondManager() : CondManager(DAG), memUsage(0)
+{
+    DagNode* t = new DagNode(DAG_TRUE, 0, DagNodeVec());
+    t->hasTT = true;
+    t->tt.push_back(1);
+    t->id = nodes.size();
+    nodes.push_back(t);
+    trueNode = t;
+
+    DagNode* f = new DagNode(DAG_FALSE, 0, DagNodeVec());
+    f->hasTT = true;
+    f->tt.push_back(0);
+    f->id = nodes.size();
+    nodes.push_back(f);
+    falseNode = f;
+}
+
+DagCondManager::~DagCondManager()
+{
+    for (DagNode* node : nodes)
+        delete node;
+}
+
+CondExpr* DagCondManager::createCond(u32_t i)
+{
+    return toCond(mkNode(DAG_VAR, i, DagNodeVec()));
+}
+
+CondExpr* DagCondManager::AND(CondExpr* lhs, CondExpr* rhs)
+{
+    return toCond(mkJunction(true, toDag(lhs), toDag(rhs)));
+}
+
+CondExpr* DagCondManager::OR(CondExpr* lhs, CondExpr* rhs)
+{
+    return toCond(mkJunction(false, toDag(lhs), toDag(rhs)));
+}
+
+CondExpr* DagCondManager::NEG(CondExpr* lhs)
+{
+    const DagNode* node = toDag(lhs);
+    if (node == trueNode)
+        return getFalseCond();
+    else if (node == falseNode)
+        return getTrueCond();
+    else if (node->kind == DAG_NEG)
+        return toCond(node->ops[0]);
+    else
+        return toCond(mkNode(DAG_NEG, 0, DagNodeVec(1, node)));
+}
+
+/*!
+ * Simplify and hash-cons the conjunction (isAnd) or disjunction of two conditions
+ */
+const DagCondManager::DagNode* DagCondManager::mkJunction(bool isAnd, const DagNode* lhs, const DagNode* rhs)
+{
+    const DagNode* unit = isAnd ? trueNode : falseNode;
+    const DagNode* zero = isAnd ? falseNode : trueNode;
+    if (lhs == zero || rhs == zero)
+        return zero;
+    else if (lhs == unit || lhs == rhs)
+        return rhs;
+    else if (rhs == unit)
+        return lhs;
+
+    u32_t kind = isAnd ? DAG_AND : DAG_OR;
+    u32_t dual = isAnd ? DAG_OR : DAG_AND;
+
+    /// flatten nested junctions of the same kind
+    DagNodeVec ops;
+    for (const DagNode* node : {lhs, rhs})
+    {
+        if (node->kind == kind)
+            ops.insert(ops.end(), node->ops.begin(), node->ops.end());
+        else
+            ops.push_back(node);
+    }
+    std::sort(ops.begin(), ops.end(), [](const DagNode* a, const DagNode* b)
+    {
+        return a->id < b->id;
+    });
+    ops.erase(std::unique(ops.begin(), ops.end()), ops.end());
+
+    NodeBS ids;
+    for (const DagNode* op : ops)
+        ids.set(op->id);
+
+    /// x & !x = false, x | !x = true
+    for (const DagNode* op : ops)
+    {
+        if (op->kind == DAG_NEG && ids.test(op->ops[0]->id))
+            return zero;
+    }
+
+    /// absorption: x | (x & y) = x, x & (x | y) = x
+    DagNodeVec kept;
+    u32_t size = 1;
+    for (const DagNode* op : ops)
+    {
+        bool absorbed = false;
+        if (op->kind == dual)
+        {
+            for (const DagNode* sub : op->ops)
+            {
+                if (ids.test(sub->id))
+                {
+                    absorbed = true;
+                    break;
+                }
+            }
+        }
+        if (!absorbed)
+        {
+            kept.push_back(op);
+            size += op->size;
+        }
+    }
+    if (kept.size() == 1)
+        return kept[0];
+
+    if (size > maxCondDagSize)
+    {
+        /// same over-approximation as BddCondManager: drop rhs of a conjunction,
+        /// a disjunction becomes true
+        numOfApprox++;
+        return isAnd ? lhs : trueNode;
+    }
+    return mkNode(kind, 0, kept);
+}
+
+/*!
+ * Return the node of a condition, creating it if neither a structurally equal
+ * node nor a node with the same truth table exists
+ */
+const DagCondManager::DagNode* DagCondManager::mkNode(u32_t kind, u32_t var, const DagNodeVec& ops)
+{
+    std::vector<u64_t> key;
+    key.reserve(ops.size() + 2);
+    key.push_back(kind);
+    key.push_back(var);
+    for (const DagNode* op : ops)
+        key.push_back(op->id);
+
+    UniqueTable::const_iterator sit = structTable.find(key);
+    if (sit != structTable.end())
+        return sit->second;
+
+    DagNode* node = new DagNode(kind, var, ops);
+    for (const DagNode* op : ops)
+        node->size += op->size;
+    computeTruthTable(node);
+
+    if (node->hasTT)
+    {
+        if (node->vars.empty())
+        {
+            const DagNode* cst = node->tt[0] ? trueNode : falseNode;
+            delete node;
+            structTable[key] = cst;
+            return cst;
+        }
+
+        std::vector<u64_t> ttKey;
+        ttKey.reserve(node->vars.size() + node->tt.size() + 1);
+        ttKey.push_back(node->vars.size());
+        ttKey.insert(ttKey.end(), node->vars.begin(), node->vars.end());
+        ttKey.insert(ttKey.end(), node->tt.begin(), node->tt.end());
+
+        UniqueTable::const_iterator tit = truthTable.find(ttKey);
+        if (tit != truthTable.end())
+        {
+            delete node;
+            structTable[key] = tit->second;
+            return tit->second;
+        }
+        truthTable[ttKey] = node;
+    }
+
+    node->id = nodes.size();
+    nodes.push_back(node);
+    structTable[key] = node;
+    memUsage += sizeof(DagNode) + node->ops.capacity() * sizeof(const DagNode*)
+                + node->vars.capacity() * sizeof(u32_t) + node->tt.capacity() * sizeof(u64_t);
+    return node;
+}
+
+/*!
+ * Compute the support of a node and its truth table if the support has at most
+ * -cond-dag-vars (and at most 16) branch conditions
+ */
+void DagCondManager::computeTruthTable(DagNode* node)
+{
+    if (node->kind == DAG_VAR)
+    {
+        node->support.set(node->var);
+        node->hasTT = true;
+        node->vars.push_back(node->var);
+        node->tt.push_back(2);
+        return;
+    }
+
+    bool hasTT = true;
+    for (const DagNode* op : node->ops)
+    {
+        node->support |= op->support;
+        hasTT &= op->hasTT;
+    }
+    if (!hasTT || node->support.count() > std::min<unsigned>(maxCondDagVars, maxTruthTableVars))
+    {
+        /// too wide to tell whether it is a tautology or contradiction
+        numOfApprox++;
+        return;
+    }
+
+    /// operands with truth tables depend on all their support
+    node->hasTT = true;
+    for (u32_t v : node->support)
+        node->vars.push_back(v);
+    u32_t n = node->vars.size();
+    u32_t words = ttWords(n);
+
+    if (node->kind == DAG_NEG)
+    {
+        node->tt = expand(node->ops[0], node->vars);
+        for (u64_t& w : node->tt)
+            w = ~w;
+    }
+    else
+    {
+        bool isAnd = node->kind == DAG_AND;
+        node->tt.assign(words, isAnd ? ~0ULL : 0);
+        for (const DagNode* op : node->ops)
+        {
+            TruthTable opTT = expand(op, node->vars);
+            for (u32_t i = 0; i < words; i++)
+            {
+                if (isAnd)
+                    node->tt[i] &= opTT[i];
+                else
+                    node->tt[i] |= opTT[i];
+            }
+        }
+    }
+    node->tt[words - 1] &= ttMask(n);
+
+    reduce(node->vars, node->tt);
+    node->support.clear();
+    for (u32_t v : node->vars)
+        node->support.set(v);
+}
+
+/*!
+ * Truth table of a node over vars, which contains the support of the node
+ */
+DagCondManager::TruthTable DagCondManager::expand(const DagNode* node, const std::vector<u32_t>& vars) const
+{
+    if (node->vars == vars)
+        return node->tt;
+
+    /// position in vars of each variable of the node
+    std::vector<u32_t> pos;
+    for (u32_t v : node->vars)
+        pos.push_back(std::lower_bound(vars.begin(), vars.end(), v) - vars.begin());
+
+    u32_t n = vars.size();
+    TruthTable tt(ttWords(n), 0);
+    for (u64_t a = 0; a < (1ULL << n); a++)
+    {
+        u64_t b = 0;
+        for (u32_t j = 0; j < pos.size(); j++)
+            b |= ((a >> pos[j]) & 1) << j;
+        if (ttBit(node->tt, b))
+            ttSet(tt, a);
+    }
+    return tt;
+}
+
+/*!
+ * Remove from vars the variables the truth table does not depend on
+ */
+void DagCondManager::reduce(std::vector<u32_t>& vars, TruthTable& tt) const
+{
+    for (u32_t j = vars.size(); j-- > 0;)
+    {
+        u32_t n = vars.size();
+        bool depends = false;
+        for (u64_t a = 0; a < (1ULL << n) && !depends; a++)
+        {
+            if (!((a >> j) & 1) && ttBit(tt, a) != ttBit(tt, a | (1ULL << j)))
+                depends = true;
+        }
+        if (depends)
+            continue;
+
+        TruthTable reduced(ttWords(n - 1), 0);
+        for (u64_t b = 0; b < (1ULL << (n - 1)); b++)
+        {
+            u64_t a = (b & ((1ULL << j) - 1)) | ((b >> j) << (j + 1));
+            if (ttBit(tt, a))
+                ttSet(reduced, b);
+        }
+        tt.swap(reduced);
+        vars.erase(vars.begin() + j);
+    }
+}
+
+void DagCondManager::BddSupport(CondExpr* f, NodeBS &support) const
+{
+    support |= toDag(f)->support;
+}
+
+u32_t DagCondManager::getCondSize(CondExpr* cond) const
+{
+    return toDag(cond)->size;
+}
+
+/*!
+ * Dump a DAG condition as a formula over branch indices
+ */
+void DagCondManager::dump(const DagNode* node, std::string& str) const
+{
+    switch (node->kind)
+    {
+    case DAG_TRUE:
+        str += "T";
+        break;
+    case DAG_FALSE:
+        str += "F";
+        break;
+    case DAG_VAR:
+        str += std::to_string(node->var);
+        break;
+    case DAG_NEG:
+        str += "!";
+        dump(node->ops[0], str);
+        break;
+    default:
+        str += "(";
+        for (u32_t i = 0; i < node->ops.size(); i++)
+        {
+            if (i > 0)
+                str += node->kind == DAG_AND ? " & " : " | ";
+            dump(node->ops[i], str);
+        }
+        str += ")";
+        break;
+    }
+}
+
+std::string DagCondManager::dumpStr(CondExpr* lhs) const
+{
+    std::string str;
+    dump(toDag(lhs), str);
+    return str;
+}
+
+void DagCondManager::printDbg(CondExpr* d)
+{
+    SVFUtil::outs() << dumpStr(d) << "\n";
+}
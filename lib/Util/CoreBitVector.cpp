@@ -0,0 +1,278 @@
+//===- CoreBitVector.cpp -- Dynamically sized bit vector data structure ------------//
+
+/*
+ * CoreBitVector.cpp
+ *
+ * Words outside the core are implicitly zero, so all binary operations only
+ * touch the overlap of the two cores (plus, for union, the part of rhs outside
+ * this core).
+ */
+
+#include "Util/CoreBitVector.h"
+
+using namespace SVF;
+
+u32_t CoreBitVector::count() const
+{
+    u32_t n = 0;
+    for (const Word &w : words)
+        n += __builtin_popcountll(w);
+    return n;
+}
+
+bool CoreBitVector::test(u32_t bit) const
+{
+    if (!canHold(bit))
+        return false;
+    return words[indexForBit(bit)] & ((Word)1 << (bit % WordSize));
+}
+
+bool CoreBitVector::test_and_set(u32_t bit)
+{
+    if (test(bit))
+        return false;
+    set(bit);
+    return true;
+}
+
+void CoreBitVector::set(u32_t bit)
+{
+    extendTo(bit);
+    words[indexForBit(bit)] |= (Word)1 << (bit % WordSize);
+}
+
+void CoreBitVector::reset(u32_t bit)
+{
+    if (!canHold(bit))
+        return;
+    size_t idx = indexForBit(bit);
+    words[idx] &= ~((Word)1 << (bit % WordSize));
+    if (words[idx] == 0 && (idx == 0 || idx == words.size() - 1))
+        trim();
+}
+
+bool CoreBitVector::contains(const CoreBitVector &rhs) const
+{
+    if (rhs.empty())
+        return true;
+    /// rhs' core must lie within ours since rhs' first and last words are non-zero
+    if (empty() || rhs.offset < offset || rhs.finalBit() > finalBit())
+        return false;
+
+    size_t start = (rhs.offset - offset) / WordSize;
+    for (size_t i = 0; i < rhs.words.size(); ++i)
+    {
+        if ((words[start + i] & rhs.words[i]) != rhs.words[i])
+            return false;
+    }
+    return true;
+}
+
+bool CoreBitVector::intersects(const CoreBitVector &rhs) const
+{
+    if (empty() || rhs.empty())
+        return false;
+
+    u32_t lo = std::max(offset, rhs.offset);
+    u32_t hi = std::min(finalBit(), rhs.finalBit());
+    if (lo > hi)
+        return false;
+
+    size_t thisIdx = indexForBit(lo);
+    size_t rhsIdx = rhs.indexForBit(lo);
+    size_t n = (hi - lo) / WordSize + 1;
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (words[thisIdx + i] & rhs.words[rhsIdx + i])
+            return true;
+    }
+    return false;
+}
+
+bool CoreBitVector::operator|=(const CoreBitVector &rhs)
+{
+    if (rhs.empty())
+        return false;
+    if (empty())
+    {
+        *this = rhs;
+        return true;
+    }
+
+    extendTo(rhs.offset);
+    extendTo(rhs.finalBit());
+
+    bool changed = false;
+    size_t start = indexForBit(rhs.offset);
+    for (size_t i = 0; i < rhs.words.size(); ++i)
+    {
+        Word old = words[start + i];
+        words[start + i] |= rhs.words[i];
+        changed |= old != words[start + i];
+    }
+    return changed;
+}
+
+bool CoreBitVector::operator&=(const CoreBitVector &rhs)
+{
+    if (empty())
+        return false;
+    if (rhs.empty())
+    {
+        clear();
+        return true;
+    }
+
+    bool changed = false;
+    for (size_t i = 0; i < words.size(); ++i)
+    {
+        u32_t bit = offset + i * WordSize;
+        Word other = rhs.canHold(bit) ? rhs.words[rhs.indexForBit(bit)] : 0;
+        Word old = words[i];
+        words[i] &= other;
+        changed |= old != words[i];
+    }
+
+    if (changed)
+        trim();
+    return changed;
+}
+
+bool CoreBitVector::operator-=(const CoreBitVector &rhs)
+{
+    if (empty() || rhs.empty())
+        return false;
+
+    u32_t lo = std::max(offset, rhs.offset);
+    u32_t hi = std::min(finalBit(), rhs.finalBit());
+    if (lo > hi)
+        return false;
+
+    bool changed = false;
+    size_t thisIdx = indexForBit(lo);
+    size_t rhsIdx = rhs.indexForBit(lo);
+    size_t n = (hi - lo) / WordSize + 1;
+    for (size_t i = 0; i < n; ++i)
+    {
+        Word old = words[thisIdx + i];
+        words[thisIdx + i] &= ~rhs.words[rhsIdx + i];
+        changed |= old != words[thisIdx + i];
+    }
+
+    if (changed)
+        trim();
+    return changed;
+}
+
+void CoreBitVector::intersectWithComplement(const CoreBitVector &lhs, const CoreBitVector &rhs)
+{
+    /// lhs/rhs may alias this
+    CoreBitVector result(lhs);
+    result -= rhs;
+    *this = std::move(result);
+}
+
+size_t CoreBitVector::hash() const
+{
+    std::hash<Word> h;
+    size_t seed = offset;
+    for (const Word &w : words)
+        seed ^= h(w) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    return seed;
+}
+
+CoreBitVector::const_iterator CoreBitVector::begin() const
+{
+    return CoreBitVectorIterator(this, false);
+}
+
+CoreBitVector::const_iterator CoreBitVector::end() const
+{
+    return CoreBitVectorIterator(this, true);
+}
+
+void CoreBitVector::extendBackward(u32_t bit)
+{
+    /// new offset is the start of the word holding bit
+    u32_t newOffset = bit - bit % WordSize;
+    size_t numOfNewWords = (offset - newOffset) / WordSize;
+    words.insert(words.begin(), numOfNewWords, 0);
+    offset = newOffset;
+}
+
+void CoreBitVector::extendForward(u32_t bit)
+{
+    size_t numOfNewWords = (bit - finalBit() + WordSize - 1) / WordSize;
+    words.insert(words.end(), numOfNewWords, 0);
+}
+
+void CoreBitVector::extendTo(u32_t bit)
+{
+    if (words.empty())
+    {
+        offset = bit - bit % WordSize;
+        words.push_back(0);
+    }
+    else if (bit < offset)
+        extendBackward(bit);
+    else if (bit > finalBit())
+        extendForward(bit);
+}
+
+void CoreBitVector::trim()
+{
+    size_t first = 0;
+    while (first < words.size() && words[first] == 0)
+        ++first;
+
+    if (first == words.size())
+    {
+        clear();
+        return;
+    }
+
+    size_t last = words.size();
+    while (words[last - 1] == 0)
+        --last;
+
+    words.erase(words.begin() + last, words.end());
+    words.erase(words.begin(), words.begin() + first);
+    offset += first * WordSize;
+}
+
+CoreBitVector::CoreBitVectorIterator::CoreBitVectorIterator(const CoreBitVector *cbv, bool end)
+    : cbv(cbv), wordIdx(0), curWord(0)
+{
+    if (end || cbv->words.empty())
+    {
+        wordIdx = cbv->words.size();
+        return;
+    }
+    /// the first word is non-zero by invariant
+    curWord = cbv->words[0];
+}
+
+const CoreBitVector::CoreBitVectorIterator &CoreBitVector::CoreBitVectorIterator::operator++()
+{
+    assert(wordIdx < cbv->words.size() && "incrementing past the end!");
+    /// drop the lowest set bit
+    curWord &= curWord - 1;
+    if (curWord == 0)
+        skipZeroWords();
+    return *this;
+}
+
+CoreBitVector::CoreBitVectorIterator CoreBitVector::CoreBitVectorIterator::operator++(int)
+{
+    CoreBitVectorIterator old = *this;
+    ++*this;
+    return old;
+}
+
+void CoreBitVector::CoreBitVectorIterator::skipZeroWords()
+{
+    ++wordIdx;
+    while (wordIdx < cbv->words.size() && cbv->words[wordIdx] == 0)
+        ++wordIdx;
+    curWord = wordIdx < cbv->words.size() ? cbv->words[wordIdx] : 0;
+}
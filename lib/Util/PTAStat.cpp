@@ -31,6 +31,7 @@
 #include "Graphs/PTACallGraph.h"
 #include "MemoryModel/PTAStat.h"
 #include "MemoryModel/PointerAnalysisImpl.h"
+#include "MemoryModel/ObjectClusterer.h"
 #include "Graphs/PAG.h"
 
 using namespace SVF;
@@ -93,6 +94,8 @@ const char* PTAStat:: NumOfGepFieldObjects = "DYFieldObjs";	///< PAG gep object
 const char* PTAStat:: AveragePointsToSetSize = "AvgPtsSetSize";		///< Average Points-to set size
 const char* PTAStat:: AverageTopLevPointsToSetSize = "AvgTopLvlPtsSize";		///< Average Points-to set size of top level pointers
 const char* PTAStat:: MaxPointsToSetSize = "MaxPtsSetSize";		///< Max Points-to set size
+const char* PTAStat:: PointsToSetMemUsage = "PtsSetMem(KB)";		///< Approximate memory of all points-to sets
+const char* PTAStat:: PeakMemUsage = "PeakMem(KB)";		///< Peak resident memory (VmHWM)
 
 const char* PTAStat:: NumOfIterations = "Iterations";	///< Number of iterations during resolution
 
@@ -221,6 +224,46 @@ void PTAStat::performStat()
 
 }
 
+void PTAStat::ptCacheStat()
+{
+    const BVDataPTAImpl* bvpta = SVFUtil::dyn_cast<BVDataPTAImpl>(pta);
+    if (bvpta == NULL || !bvpta->usePersistentPTData())
+        return;
+
+    const PersistentPointsToCache<PointsTo>& ptCache = bvpta->getPtCache();
+    PTNumStatMap["UniquePtsSets"] = ptCache.getNumOfUniquePts();
+    PTNumStatMap["PtsUnions"] = ptCache.getNumOfUnions();
+    PTNumStatMap["CachedPtsUnions"] = ptCache.getNumOfCheapUnions();
+    PTNumStatMap["PtsComplements"] = ptCache.getNumOfComplements();
+    PTNumStatMap["CachedPtsComplements"] = ptCache.getNumOfCheapComplements();
+    PTNumStatMap["PtsIntersections"] = ptCache.getNumOfIntersections();
+    PTNumStatMap["CachedPtsIntersects"] = ptCache.getNumOfCheapIntersections();
+}
+
+void PTAStat::aliasCacheStat()
+{
+    const BVDataPTAImpl* bvpta = SVFUtil::dyn_cast<BVDataPTAImpl>(pta);
+    if (bvpta == NULL)
+        return;
+
+    PTNumStatMap["AliasCacheHits"] = bvpta->getNumOfAliasCacheHits();
+    PTNumStatMap["AliasCacheMisses"] = bvpta->getNumOfAliasCacheMisses();
+    PTNumStatMap["AliasCacheSize"] = bvpta->getAliasCacheSize();
+}
+
+void PTAStat::clusterStat()
+{
+    if (!ObjectClusterer::hasClustered())
+        return;
+
+    PTNumStatMap["ClusteredObjs"] = ObjectClusterer::numOfClusteredObjs;
+    PTNumStatMap["ClusteredPtsSets"] = ObjectClusterer::numOfDistinctPts;
+    PTNumStatMap["PtsElemsBeforeClust"] = ObjectClusterer::numOfElementsBefore;
+    PTNumStatMap["PtsElemsAfterClust"] = ObjectClusterer::numOfElementsAfter;
+    PTNumStatMap["ClusterMappingUsed"] = ObjectClusterer::mappingInstalled;
+    timeStatMap["ClusteringTime"] = ObjectClusterer::timeOfClustering;
+}
+
 void PTAStat::callgraphStat()
 {
 
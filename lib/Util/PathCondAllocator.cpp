@@ -37,17 +37,33 @@
 using namespace SVF;
 using namespace SVFUtil;
 
-u64_t DPItem::maximumBudget = ULONG_MAX - 1;
+thread_local u64_t DPItem::maximumBudget = ULONG_MAX - 1;
 u32_t ContextCond::maximumCxtLen = 0;
-u32_t ContextCond::maximumCxt = 0;
+std::atomic<u32_t> ContextCond::maximumCxt(0);
 u32_t VFPathCond::maximumPathLen = 0;
 u32_t VFPathCond::maximumPath = 0;
 
 u32_t PathCondAllocator::totalCondNum = 0;
-BddCondManager* PathCondAllocator::bddCondMgr = NULL;
+CondManager* PathCondAllocator::bddCondMgr = NULL;
 static llvm::cl::opt<bool> PrintPathCond("print-pc", llvm::cl::init(false),
         llvm::cl::desc("Print out path condition"));
 
+static llvm::cl::opt<CondManager::CondManagerTy> CondBackend("cond-backend", llvm::cl::init(CondManager::BDD),
+        llvm::cl::desc("Representation of path conditions"),
+        llvm::cl::values(
+            clEnumValN(CondManager::BDD, "bdd", "BDDs (CUDD, default)"),
+            clEnumValN(CondManager::DAG, "dag", "hash-consed AND/OR DAGs")));
+
+/*!
+ * Create the condition backend
+ */
+CondManager* PathCondAllocator::createCondManager()
+{
+    if (CondBackend == CondManager::DAG)
+        return new DagCondManager();
+    return new BddCondManager();
+}
+
 /*!
  * Allocate path condition for each branch
  */
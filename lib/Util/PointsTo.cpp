@@ -0,0 +1,697 @@
+//===- PointsTo.cpp -- Points-to set abstraction ------------------------------//
+
+/*
+ * PointsTo.cpp
+ *
+ * Dispatches each operation to the active representation.
+ */
+
+#include "Util/PointsTo.h"
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+
+using namespace SVF;
+
+static PointsTo::Type defaultPtsType = PointsTo::SBV;
+
+static llvm::cl::opt<PointsTo::Type, true> PtsType("ptset", llvm::cl::location(defaultPtsType),
+        llvm::cl::init(PointsTo::SBV),
+        llvm::cl::desc("Representation of points-to sets"),
+        llvm::cl::values(
+            clEnumValN(PointsTo::SBV, "sbv", "sparse bit vector (default)"),
+            clEnumValN(PointsTo::CBV, "cbv", "core bit vector: dense bits between the smallest and largest element"),
+            clEnumValN(PointsTo::FSV, "fsv", "flat sorted vector of object IDs")));
+
+PointsTo::Type PointsTo::getDefaultType()
+{
+    return defaultPtsType;
+}
+
+void PointsTo::setDefaultType(Type type)
+{
+    defaultPtsType = type;
+}
+
+/// Mapping given to new sets, that of the innermost NodeMappingScope; NULL for the identity.
+static const PointsTo::NodeMapping *currentNodeMapping = NULL;
+/// Every mapping ever created, kept alive for the sets still referring to it.
+static std::vector<std::unique_ptr<PointsTo::NodeMapping>> allNodeMappings;
+
+const PointsTo::NodeMapping *PointsTo::createNodeMapping(const std::vector<NodeID> &externalToInternal)
+{
+    NodeMapping *m = new NodeMapping();
+    m->toInternal = externalToInternal;
+    m->toExternal.resize(externalToInternal.size(), 0);
+    for (NodeID n = 0; n < externalToInternal.size(); ++n)
+    {
+        assert(externalToInternal[n] < externalToInternal.size() && "node mapping is not a permutation!");
+        m->toExternal[externalToInternal[n]] = n;
+    }
+    allNodeMappings.push_back(std::unique_ptr<NodeMapping>(m));
+    return m;
+}
+
+const PointsTo::NodeMapping *PointsTo::getNodeMapping()
+{
+    return currentNodeMapping;
+}
+
+PointsTo::NodeMappingScope::NodeMappingScope(const NodeMapping *mapping) : prevMapping(currentNodeMapping)
+{
+    currentNodeMapping = mapping;
+}
+
+PointsTo::NodeMappingScope::~NodeMappingScope()
+{
+    currentNodeMapping = prevMapping;
+}
+
+const char *PointsTo::getTypeName(Type type)
+{
+    switch (type)
+    {
+    case SBV:
+        return "sbv";
+    case CBV:
+        return "cbv";
+    case FSV:
+        return "fsv";
+    }
+    return "unknown";
+}
+
+PointsTo::PointsTo() : type(defaultPtsType), mapping(currentNodeMapping)
+{
+    initMember(type);
+}
+
+PointsTo::PointsTo(Type type) : type(type), mapping(currentNodeMapping)
+{
+    initMember(type);
+}
+
+PointsTo::PointsTo(Type type, const NodeMapping *mapping) : type(type), mapping(mapping)
+{
+    initMember(type);
+}
+
+PointsTo::PointsTo(const PointsTo &pt) : type(pt.type), mapping(pt.mapping)
+{
+    copyFrom(pt);
+}
+
+PointsTo::PointsTo(PointsTo &&pt) : type(pt.type), mapping(pt.mapping)
+{
+    moveFrom(std::move(pt));
+}
+
+PointsTo::~PointsTo()
+{
+    destroyMember();
+}
+
+PointsTo &PointsTo::operator=(const PointsTo &rhs)
+{
+    if (this == &rhs)
+        return *this;
+
+    mapping = rhs.mapping;
+    if (type == rhs.type)
+    {
+        switch (type)
+        {
+        case SBV:
+            sbv = rhs.sbv;
+            break;
+        case CBV:
+            cbv = rhs.cbv;
+            break;
+        case FSV:
+            fsv = rhs.fsv;
+            break;
+        }
+    }
+    else
+    {
+        destroyMember();
+        type = rhs.type;
+        copyFrom(rhs);
+    }
+    return *this;
+}
+
+PointsTo &PointsTo::operator=(PointsTo &&rhs)
+{
+    if (this == &rhs)
+        return *this;
+
+    mapping = rhs.mapping;
+    if (type == rhs.type)
+    {
+        switch (type)
+        {
+        case SBV:
+            sbv = std::move(rhs.sbv);
+            break;
+        case CBV:
+            cbv = std::move(rhs.cbv);
+            break;
+        case FSV:
+            fsv = std::move(rhs.fsv);
+            break;
+        }
+    }
+    else
+    {
+        destroyMember();
+        type = rhs.type;
+        moveFrom(std::move(rhs));
+    }
+    return *this;
+}
+
+void PointsTo::initMember(Type t)
+{
+    switch (t)
+    {
+    case SBV:
+        new (&sbv) NodeBS();
+        break;
+    case CBV:
+        new (&cbv) CoreBitVector();
+        break;
+    case FSV:
+        new (&fsv) std::vector<NodeID>();
+        break;
+    }
+}
+
+void PointsTo::destroyMember()
+{
+    switch (type)
+    {
+    case SBV:
+        sbv.~NodeBS();
+        break;
+    case CBV:
+        cbv.~CoreBitVector();
+        break;
+    case FSV:
+        fsv.~vector<NodeID>();
+        break;
+    }
+}
+
+void PointsTo::copyFrom(const PointsTo &pt)
+{
+    switch (type)
+    {
+    case SBV:
+        new (&sbv) NodeBS(pt.sbv);
+        break;
+    case CBV:
+        new (&cbv) CoreBitVector(pt.cbv);
+        break;
+    case FSV:
+        new (&fsv) std::vector<NodeID>(pt.fsv);
+        break;
+    }
+}
+
+void PointsTo::moveFrom(PointsTo &&pt)
+{
+    switch (type)
+    {
+    case SBV:
+        new (&sbv) NodeBS(std::move(pt.sbv));
+        break;
+    case CBV:
+        new (&cbv) CoreBitVector(std::move(pt.cbv));
+        break;
+    case FSV:
+        new (&fsv) std::vector<NodeID>(std::move(pt.fsv));
+        break;
+    }
+}
+
+bool PointsTo::empty() const
+{
+    switch (type)
+    {
+    case SBV:
+        return sbv.empty();
+    case CBV:
+        return cbv.empty();
+    case FSV:
+        return fsv.empty();
+    }
+    return true;
+}
+
+u32_t PointsTo::count() const
+{
+    switch (type)
+    {
+    case SBV:
+        return sbv.count();
+    case CBV:
+        return cbv.count();
+    case FSV:
+        return fsv.size();
+    }
+    return 0;
+}
+
+void PointsTo::clear()
+{
+    switch (type)
+    {
+    case SBV:
+        sbv.clear();
+        break;
+    case CBV:
+        cbv.clear();
+        break;
+    case FSV:
+        fsv.clear();
+        break;
+    }
+}
+
+bool PointsTo::test(u32_t n) const
+{
+    n = toInternal(n);
+    switch (type)
+    {
+    case SBV:
+        return sbv.test(n);
+    case CBV:
+        return cbv.test(n);
+    case FSV:
+        return std::binary_search(fsv.begin(), fsv.end(), n);
+    }
+    return false;
+}
+
+bool PointsTo::test_and_set(u32_t n)
+{
+    n = toInternal(n);
+    switch (type)
+    {
+    case SBV:
+        return sbv.test_and_set(n);
+    case CBV:
+        return cbv.test_and_set(n);
+    case FSV:
+    {
+        std::vector<NodeID>::iterator it = std::lower_bound(fsv.begin(), fsv.end(), n);
+        if (it != fsv.end() && *it == n)
+            return false;
+        fsv.insert(it, n);
+        return true;
+    }
+    }
+    return false;
+}
+
+void PointsTo::set(u32_t n)
+{
+    test_and_set(n);
+}
+
+void PointsTo::reset(u32_t n)
+{
+    n = toInternal(n);
+    switch (type)
+    {
+    case SBV:
+        sbv.reset(n);
+        break;
+    case CBV:
+        cbv.reset(n);
+        break;
+    case FSV:
+    {
+        std::vector<NodeID>::iterator it = std::lower_bound(fsv.begin(), fsv.end(), n);
+        if (it != fsv.end() && *it == n)
+            fsv.erase(it);
+        break;
+    }
+    }
+}
+
+bool PointsTo::contains(const PointsTo &rhs) const
+{
+    if (!sameLayout(rhs))
+        return contains(rhs.convertTo(type, mapping));
+    switch (type)
+    {
+    case SBV:
+        return sbv.contains(rhs.sbv);
+    case CBV:
+        return cbv.contains(rhs.cbv);
+    case FSV:
+        return std::includes(fsv.begin(), fsv.end(), rhs.fsv.begin(), rhs.fsv.end());
+    }
+    return false;
+}
+
+bool PointsTo::intersects(const PointsTo &rhs) const
+{
+    if (!sameLayout(rhs))
+        return intersects(rhs.convertTo(type, mapping));
+    switch (type)
+    {
+    case SBV:
+        return sbv.intersects(rhs.sbv);
+    case CBV:
+        return cbv.intersects(rhs.cbv);
+    case FSV:
+    {
+        std::vector<NodeID>::const_iterator i = fsv.begin(), j = rhs.fsv.begin();
+        while (i != fsv.end() && j != rhs.fsv.end())
+        {
+            if (*i < *j)
+                ++i;
+            else if (*j < *i)
+                ++j;
+            else
+                return true;
+        }
+        return false;
+    }
+    }
+    return false;
+}
+
+int PointsTo::find_first() const
+{
+    if (empty())
+        return -1;
+    return *begin();
+}
+
+bool PointsTo::operator==(const PointsTo &rhs) const
+{
+    if (!sameLayout(rhs))
+        return *this == rhs.convertTo(type, mapping);
+    switch (type)
+    {
+    case SBV:
+        return sbv == rhs.sbv;
+    case CBV:
+        return cbv == rhs.cbv;
+    case FSV:
+        return fsv == rhs.fsv;
+    }
+    return false;
+}
+
+bool PointsTo::operator|=(const PointsTo &rhs)
+{
+    if (!sameLayout(rhs))
+        return *this |= rhs.convertTo(type, mapping);
+    switch (type)
+    {
+    case SBV:
+        return sbv |= rhs.sbv;
+    case CBV:
+        return cbv |= rhs.cbv;
+    case FSV:
+    {
+        if (rhs.fsv.empty())
+            return false;
+        std::vector<NodeID> result;
+        result.reserve(fsv.size() + rhs.fsv.size());
+        std::set_union(fsv.begin(), fsv.end(), rhs.fsv.begin(), rhs.fsv.end(), std::back_inserter(result));
+        if (result.size() == fsv.size())
+            return false;
+        fsv = std::move(result);
+        return true;
+    }
+    }
+    return false;
+}
+
+bool PointsTo::operator|=(const NodeBS &rhs)
+{
+    if (type == SBV && !mapping)
+        return sbv |= rhs;
+
+    bool changed = false;
+    for (NodeID n : rhs)
+        changed |= test_and_set(n);
+    return changed;
+}
+
+bool PointsTo::operator&=(const PointsTo &rhs)
+{
+    if (!sameLayout(rhs))
+        return *this &= rhs.convertTo(type, mapping);
+    switch (type)
+    {
+    case SBV:
+        return sbv &= rhs.sbv;
+    case CBV:
+        return cbv &= rhs.cbv;
+    case FSV:
+    {
+        std::vector<NodeID> result;
+        std::set_intersection(fsv.begin(), fsv.end(), rhs.fsv.begin(), rhs.fsv.end(), std::back_inserter(result));
+        if (result.size() == fsv.size())
+            return false;
+        fsv = std::move(result);
+        return true;
+    }
+    }
+    return false;
+}
+
+bool PointsTo::operator-=(const PointsTo &rhs)
+{
+    if (!sameLayout(rhs))
+        return *this -= rhs.convertTo(type, mapping);
+    switch (type)
+    {
+    case SBV:
+        return sbv.intersectWithComplement(rhs.sbv);
+    case CBV:
+        return cbv -= rhs.cbv;
+    case FSV:
+    {
+        std::vector<NodeID> result;
+        std::set_difference(fsv.begin(), fsv.end(), rhs.fsv.begin(), rhs.fsv.end(), std::back_inserter(result));
+        if (result.size() == fsv.size())
+            return false;
+        fsv = std::move(result);
+        return true;
+    }
+    }
+    return false;
+}
+
+void PointsTo::intersectWithComplement(const PointsTo &lhs, const PointsTo &rhs)
+{
+    if (!lhs.sameLayout(rhs))
+    {
+        intersectWithComplement(lhs, rhs.convertTo(lhs.type, lhs.mapping));
+        return;
+    }
+
+    if (type != lhs.type)
+    {
+        destroyMember();
+        type = lhs.type;
+        initMember(type);
+    }
+    mapping = lhs.mapping;
+
+    switch (type)
+    {
+    case SBV:
+        sbv.intersectWithComplement(lhs.sbv, rhs.sbv);
+        break;
+    case CBV:
+        cbv.intersectWithComplement(lhs.cbv, rhs.cbv);
+        break;
+    case FSV:
+    {
+        /// lhs/rhs may alias this
+        std::vector<NodeID> result;
+        std::set_difference(lhs.fsv.begin(), lhs.fsv.end(), rhs.fsv.begin(), rhs.fsv.end(), std::back_inserter(result));
+        fsv = std::move(result);
+        break;
+    }
+    }
+}
+
+PointsTo PointsTo::convertTo(Type t, const NodeMapping *m) const
+{
+    PointsTo pt(t, m);
+    for (NodeID n : *this)
+        pt.set(n);
+    return pt;
+}
+
+NodeBS PointsTo::toNodeBS() const
+{
+    if (type == SBV && !mapping)
+        return sbv;
+
+    NodeBS nbs;
+    for (NodeID n : *this)
+        nbs.set(n);
+    return nbs;
+}
+
+/*!
+ * Sums a mix of each object ID, so the hash depends neither on the bit positions
+ * (type and node mapping) nor on the order in which the elements are visited
+ */
+size_t PointsTo::hash() const
+{
+    u64_t seed = count();
+    for (NodeID n : *this)
+    {
+        u64_t x = n + 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        seed += x ^ (x >> 31);
+    }
+    return seed;
+}
+
+size_t PointsTo::getMemoryUsage() const
+{
+    switch (type)
+    {
+    case SBV:
+    {
+        /// each SparseBitVectorElement holds 128 bits plus a list node
+        size_t numOfElements = 0;
+        u32_t lastElement = ~0U;
+        for (NodeID n : sbv)
+        {
+            if (n / 128 != lastElement)
+            {
+                lastElement = n / 128;
+                ++numOfElements;
+            }
+        }
+        return sizeof(PointsTo) + numOfElements * (sizeof(llvm::SparseBitVectorElement<>) + 2 * sizeof(void*));
+    }
+    case CBV:
+        return sizeof(PointsTo) - sizeof(CoreBitVector) + cbv.getMemoryUsage();
+    case FSV:
+        return sizeof(PointsTo) + fsv.capacity() * sizeof(NodeID);
+    }
+    return sizeof(PointsTo);
+}
+
+PointsTo::const_iterator PointsTo::begin() const
+{
+    return PointsToIterator(this, false);
+}
+
+PointsTo::const_iterator PointsTo::end() const
+{
+    return PointsToIterator(this, true);
+}
+
+PointsTo SVF::operator|(const PointsTo &lhs, const PointsTo &rhs)
+{
+    PointsTo result = lhs;
+    result |= rhs;
+    return result;
+}
+
+PointsTo SVF::operator&(const PointsTo &lhs, const PointsTo &rhs)
+{
+    PointsTo result = lhs;
+    result &= rhs;
+    return result;
+}
+
+PointsTo SVF::operator-(const PointsTo &lhs, const PointsTo &rhs)
+{
+    PointsTo result = lhs;
+    result -= rhs;
+    return result;
+}
+
+PointsTo::PointsToIterator::PointsToIterator(const PointsTo *pt, bool end)
+    : type(pt->type), mapping(pt->mapping)
+{
+    switch (type)
+    {
+    case SBV:
+        sbvIt = end ? pt->sbv.end() : pt->sbv.begin();
+        break;
+    case CBV:
+        cbvIt = end ? pt->cbv.end() : pt->cbv.begin();
+        break;
+    case FSV:
+        fsvIt = end ? pt->fsv.end() : pt->fsv.begin();
+        break;
+    }
+}
+
+const PointsTo::PointsToIterator &PointsTo::PointsToIterator::operator++()
+{
+    switch (type)
+    {
+    case SBV:
+        ++sbvIt;
+        break;
+    case CBV:
+        ++cbvIt;
+        break;
+    case FSV:
+        ++fsvIt;
+        break;
+    }
+    return *this;
+}
+
+PointsTo::PointsToIterator PointsTo::PointsToIterator::operator++(int)
+{
+    PointsToIterator old = *this;
+    ++*this;
+    return old;
+}
+
+u32_t PointsTo::PointsToIterator::operator*() const
+{
+    u32_t n = 0;
+    switch (type)
+    {
+    case SBV:
+        n = *sbvIt;
+        break;
+    case CBV:
+        n = *cbvIt;
+        break;
+    case FSV:
+        n = *fsvIt;
+        break;
+    }
+    return mapping && n < mapping->toExternal.size() ? mapping->toExternal[n] : n;
+}
+
+bool PointsTo::PointsToIterator::operator==(const PointsToIterator &rhs) const
+{
+    if (type != rhs.type)
+        return false;
+    switch (type)
+    {
+    case SBV:
+        return sbvIt == rhs.sbvIt;
+    case CBV:
+        return cbvIt == rhs.cbvIt;
+    case FSV:
+        return fsvIt == rhs.fsvIt;
+    }
+    return false;
+}
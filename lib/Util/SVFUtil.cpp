@@ -135,6 +135,15 @@ void SVFUtil::dumpSet(NodeBS bs, raw_ostream & O)
     }
 }
 
+void SVFUtil::dumpSet(const PointsTo& pts, raw_ostream & O)
+{
+    for (PointsTo::iterator ii = pts.begin(), ie = pts.end();
+            ii != ie; ii++)
+    {
+        O << " " << *ii << " ";
+    }
+}
+
 /*!
  * Print memory usage
  */
@@ -195,6 +204,39 @@ bool SVFUtil::getMemoryUsageKB(u32_t* vmrss_kb, u32_t* vmsize_kb)
     return (found_vmrss && found_vmsize);
 }
 
+/*!
+ * Get peak memory usage
+ */
+bool SVFUtil::getPeakMemoryUsageKB(u32_t* vmhwm_kb)
+{
+    char buffer[8192];
+    FILE* procfile = fopen("/proc/self/status", "r");
+    if(procfile)
+    {
+        u32_t result = fread(buffer, sizeof(char), 8191, procfile);
+        buffer[result] = '\0';
+        fclose(procfile);
+    }
+    else
+    {
+        fputs ("/proc/self/status file not exit\n",stderr);
+        return false;
+    }
+
+    char delims[] = "\n";
+    char* line = strtok(buffer, delims);
+    while (line != NULL)
+    {
+        if (strstr(line, "VmHWM:") != NULL)
+        {
+            sscanf(line, "%*s %u", vmhwm_kb);
+            return true;
+        }
+        line = strtok(NULL, delims);
+    }
+    return false;
+}
+
 /*!
  * Increase stack size
  */
@@ -0,0 +1,69 @@
+//===- WorkList.cpp -- Internal worklist used in SVF -------------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * WorkList.cpp
+ *
+ * Strategy of the node worklists of the solvers.
+ */
+
+#include "Util/WorkList.h"
+
+using namespace SVF;
+
+const u32_t TopoWorkList::NoRank;
+
+static NodeWorkList::Strategy defaultStrategy = NodeWorkList::FIFO;
+
+static llvm::cl::opt<NodeWorkList::Strategy, true> WorkListStrategy("worklist", llvm::cl::location(defaultStrategy),
+        llvm::cl::init(NodeWorkList::FIFO),
+        llvm::cl::desc("Worklist strategy of the pointer analysis solvers"),
+        llvm::cl::values(
+            clEnumValN(NodeWorkList::FIFO, "fifo", "first in first out (default)"),
+            clEnumValN(NodeWorkList::DenseFIFO, "dfifo", "first in first out, membership kept in a bitmap"),
+            clEnumValN(NodeWorkList::LRF, "lrf", "least recently fired node first"),
+            clEnumValN(NodeWorkList::Topo, "topo", "two-phase, each phase in topological order")));
+
+NodeWorkList::Strategy NodeWorkList::getDefaultStrategy()
+{
+    return defaultStrategy;
+}
+
+void NodeWorkList::setDefaultStrategy(Strategy s)
+{
+    defaultStrategy = s;
+}
+
+const char* NodeWorkList::getStrategyName(Strategy s)
+{
+    switch (s)
+    {
+    case DenseFIFO:
+        return "dfifo";
+    case LRF:
+        return "lrf";
+    case Topo:
+        return "topo";
+    default:
+        return "fifo";
+    }
+}
@@ -29,6 +29,8 @@
 
 #include "SVF-FE/LLVMUtil.h"
 #include "WPA/Andersen.h"
+#include "MemoryModel/ObjectClusterer.h"
+#include "Graphs/GraphStreamer.h"
 
 using namespace SVF;
 using namespace SVFUtil;
@@ -53,6 +55,10 @@ double Andersen::timeOfProcessCopyGep = 0;
 double Andersen::timeOfProcessLoadStore = 0;
 double Andersen::timeOfUpdateCallGraph = 0;
 
+AndersenLCD* AndersenLCD::lcdAndersen = nullptr;
+AndersenHCD* AndersenHCD::hcdAndersen = nullptr;
+AndersenHLCD* AndersenHLCD::hlcdAndersen = nullptr;
+
 
 static llvm::cl::opt<bool> ConsCGDotGraph("dump-consG", llvm::cl::init(false),
         llvm::cl::desc("Dump dot graph of Constraint Graph"));
@@ -67,6 +73,10 @@ static llvm::cl::opt<bool> PtsDiff("diff",  llvm::cl::init(true),
                                    llvm::cl::desc("Disable diff pts propagation"));
 static llvm::cl::opt<bool> MergePWC("merge-pwc",  llvm::cl::init(true),
                                     llvm::cl::desc("Enable PWC in graph solving"));
+static llvm::cl::opt<string> IncAnderDB("ander-inc-db",  llvm::cl::init(""),
+                                        llvm::cl::desc("Re-analyse incrementally from the database of the previous run in this file, then update it"));
+static llvm::cl::opt<bool> ClusterAnder("cluster-ander",  llvm::cl::init(false),
+                                        llvm::cl::desc("Renumber objects after an auxiliary Andersen's analysis for denser points-to sets"));
 
 
 /*!
@@ -81,7 +91,7 @@ void AndersenBase::initialize()
     setGraph(consCG);
     /// Create statistic class
     stat = new AndersenStat(this);
-	if (ConsCGDotGraph)
+	if (ConsCGDotGraph && !isAuxiliary())
 		consCG->dump("consCG_initial");
 }
 
@@ -90,13 +100,17 @@ void AndersenBase::initialize()
  */
 void AndersenBase::finalize()
 {
-    /// dump constraint graph if PAGDotGraph flag is enabled
-	if (ConsCGDotGraph)
-		consCG->dump("consCG_final");
+    if (!isAuxiliary())
+    {
+        /// dump constraint graph if PAGDotGraph flag is enabled
+        if (ConsCGDotGraph)
+            consCG->dump("consCG_final");
+        GraphStreamer::stream(consCG, "consg", "consCG_final");
 
-	if (PrintCGGraph)
-		consCG->print();
-    PointerAnalysis::finalize();
+        if (PrintCGGraph)
+            consCG->print();
+    }
+    BVDataPTAImpl::finalize();
 }
 
 
@@ -105,15 +119,33 @@ void AndersenBase::finalize()
  */
 void Andersen::analyze()
 {
+    /// An auxiliary analysis neither clusters nor reads, seeds or writes results
+    const bool aux = isAuxiliary();
+
+    /// Statistics of this run only
+    ObjectClusterer::resetStat();
+
+    /// Renumber objects before any points-to set of this analysis is created
+    if (ClusterAnder && !aux)
+        cluster();
+    PointsTo::NodeMappingScope mappingScope(nodeMapping);
+
     /// Initialization for the Solver
     initialize();
 
     bool readResultsFromFile = false;
-    if(!ReadAnder.empty())
+    if(!ReadAnder.empty() && !aux)
         readResultsFromFile = this->readFromFile(ReadAnder);
 
     if(!readResultsFromFile)
     {
+        /// Reuse the unaffected part of the previous solution
+        if (!IncAnderDB.empty() && !aux)
+        {
+            recordInitialFIObjs();
+            seedFromIncrementalDB(IncAnderDB);
+        }
+
         // Start solving constraints
         DBOUT(DGENERAL, outs() << SVFUtil::pasMsg("Start Solving Constraints\n"));
         solve();
@@ -121,13 +153,28 @@ void Andersen::analyze()
 
         // Finalize the analysis
         finalize();
+
+        if (!IncAnderDB.empty() && !aux)
+            writeIncrementalDB(IncAnderDB);
     }
 
-    if (!WriteAnder.empty())
+    if (!WriteAnder.empty() && !aux)
         this->writeToFile(WriteAnder);
 }
 
 
+/*!
+ * Solve an auxiliary Andersen's analysis on the same PAG and renumber objects
+ * according to its points-to sets
+ */
+void Andersen::cluster()
+{
+    AndersenWaveDiff aux(pag, AndersenWaveDiff_WPA, false);
+    aux.setAuxiliary();
+    aux.analyze();
+    nodeMapping = ObjectClusterer::cluster(&aux);
+}
+
 /*!
  * Initilize analysis
  */
@@ -137,8 +184,15 @@ void Andersen::initialize()
     setDiffOpt(PtsDiff);
     setPWCOpt(MergePWC);
     AndersenBase::initialize();
+    /// Merge pointer equivalent nodes, unless the results are read or seeded by node
+    if (varSubst && ((ReadAnder.empty() && IncAnderDB.empty()) || isAuxiliary()))
+        substituteVariables();
     /// Initialize worklist
     processAllAddr();
+    /// Online cycle detection
+    delete cycleDetector;
+    cycleDetector = CycleDetector::create(cycleDetection, this);
+    cycleDetector->initialize();
 }
 
 /*!
@@ -152,6 +206,28 @@ void Andersen::finalize()
 	AndersenBase::finalize();
 }
 
+/*!
+ * Solve worklist, merging the cycles found by the cycle detector on the way
+ */
+void Andersen::solveWorklist()
+{
+    while (!isWorklistEmpty())
+    {
+        cycleDetector->mergeDetectedCycles();
+
+        NodeID nodeId = popFromWorklist();
+        collapsePWCNode(nodeId);
+        cycleDetector->beforeProcessNode(nodeId);
+        // The cycle detector may have merged this node, whose rep then holds its constraints.
+        NodeID rep = sccRepNode(nodeId);
+        if (rep != nodeId)
+            pushMergedRep(rep);
+        // Keep solving until workList is empty.
+        processNode(nodeId);
+        collapseFields();
+    }
+}
+
 /*!
  * Start constraint solving
  */
@@ -184,7 +260,10 @@ void Andersen::handleCopyGep(ConstraintNode* node)
     if (!getDiffPts(nodeId).empty())
     {
         for (ConstraintEdge* edge : node->getCopyOutEdges())
+        {
+            cycleDetector->beforeProcessCopy(nodeId, edge);
             processCopy(nodeId, edge);
+        }
         for (ConstraintEdge* edge : node->getGepOutEdges())
         {
             if (GepCGEdge* gepEdge = SVFUtil::dyn_cast<GepCGEdge>(edge))
@@ -410,11 +489,13 @@ void Andersen::mergeSccCycle()
 {
     NodeStack revTopoOrder;
     NodeStack & topoOrder = getSCCDetector()->topoNodeStack();
+    u32_t rank = 0;
     while (!topoOrder.empty())
     {
         NodeID repNodeId = topoOrder.top();
         topoOrder.pop();
         revTopoOrder.push(repNodeId);
+        worklist.setRank(repNodeId, rank++);
         const NodeBS& subNodes = getSCCDetector()->subNodes(repNodeId);
         // merge sub nodes to rep node
         mergeSccNodes(repNodeId, subNodes);
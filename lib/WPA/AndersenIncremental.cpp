@@ -0,0 +1,700 @@
+//===- AndersenIncremental.cpp -- Incremental Andersen's analysis------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * AndersenIncremental.cpp
+ *
+ * Re-analysis of a slightly changed module from the solution of its previous
+ * version (-ander-inc-db).
+ *
+ * Points-to sets only grow during solving, so solving from any seed which is below
+ * the least solution still ends in exactly the least solution. The database of the
+ * previous run records, in terms of names which survive recompilation (see
+ * IncrementalKeys), its points-to sets, a hash of the PAG constraints of every
+ * function, and the dependencies between nodes in its final constraint graph
+ * (including the copy edges derived from loads, stores and indirect calls).
+ *
+ * A function whose constraints hash differently has changed. Every node whose old
+ * points-to set may have come from the old constraints of a changed function is
+ * reachable along the recorded dependencies from the nodes those constraints
+ * define, and is not seeded. The other old sets are still derivable from the new
+ * constraints, so they are seeded and the solver re-propagates from them: a
+ * changed function only costs the work of its impacted nodes, plus one pass over
+ * the seeded ones.
+ */
+
+#include "WPA/Andersen.h"
+#include "Util/WorkList.h"
+#include <fstream>
+#include <functional>
+#include <sstream>
+
+using namespace SVF;
+using namespace SVFUtil;
+
+u32_t Andersen::numOfIncChangedFuns = 0;
+u32_t Andersen::numOfIncInvalidatedNodes = 0;
+u32_t Andersen::numOfIncSeededNodes = 0;
+
+namespace
+{
+
+const char* IncDBMagic = "SVF-INCANDER";
+const u32_t IncDBVersion = 1;
+
+/// FNV-1a, stable across runs and platforms
+inline u64_t stableHash(const std::string& str, u64_t seed = 0xcbf29ce484222325ULL)
+{
+    u64_t h = seed;
+    for (unsigned char c : str)
+    {
+        h ^= c;
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+/*!
+ * Names of PAG nodes which do not depend on node IDs, so that the same node gets the
+ * same name when the module is analysed again: globals by name, arguments, blocks and
+ * instructions by function and position, other constants by their text. Nodes with
+ * no such name (e.g., dummy nodes) get "", as do names shared by several nodes.
+ * Field objects are named relative to their base object (see isGepObj).
+ *
+ * Constraints are grouped by the function holding them ("" for global initialisers).
+ */
+class IncrementalKeys
+{
+public:
+    IncrementalKeys(PAG* p) : pag(p)
+    {
+        numOfNodes = 0;
+        for (PAG::iterator it = pag->begin(), eit = pag->end(); it != eit; ++it)
+            numOfNodes = std::max(numOfNodes, it->first + 1);
+
+        keys.resize(numOfNodes);
+        for (PAG::iterator it = pag->begin(), eit = pag->end(); it != eit; ++it)
+        {
+            if (!SVFUtil::isa<GepObjPN>(it->second))
+                keys[it->first] = computeKey(it->second);
+        }
+
+        /// names shared by several nodes identify none of them
+        Set<std::string> duplicates;
+        for (NodeID id = 0; id < numOfNodes; ++id)
+        {
+            if (keys[id].empty())
+                continue;
+            if (!idOfKey.emplace(keys[id], id).second)
+                duplicates.insert(keys[id]);
+        }
+        for (const std::string& dup : duplicates)
+            idOfKey.erase(dup);
+        for (NodeID id = 0; id < numOfNodes; ++id)
+        {
+            if (!keys[id].empty() && duplicates.count(keys[id]))
+                keys[id].clear();
+        }
+
+        computeGroups();
+    }
+
+    inline NodeID getNumOfNodes() const
+    {
+        return numOfNodes;
+    }
+    inline const std::string& getKey(NodeID id) const
+    {
+        static const std::string noKey;
+        return id < numOfNodes ? keys[id] : noKey;
+    }
+    /// Returns the node named key, or -1 when there is none.
+    inline s64_t getIdOfKey(const std::string& key) const
+    {
+        Map<std::string, NodeID>::const_iterator it = idOfKey.find(key);
+        return it == idOfKey.end() ? -1 : (s64_t)it->second;
+    }
+    inline bool isGepObj(NodeID id) const
+    {
+        return pag->hasGNode(id) && SVFUtil::isa<GepObjPN>(pag->getPAGNode(id));
+    }
+
+    /// Hash of the constraints (PAG edges) and nodes of each function.
+    inline const Map<std::string, u64_t>& getGroupHashes() const
+    {
+        return groupHash;
+    }
+    inline const NodeBS& getGroupNodes(const std::string& group)
+    {
+        return groupNodes[group];
+    }
+    inline const std::vector<const PAGEdge*>& getGroupEdges(const std::string& group)
+    {
+        return groupEdges[group];
+    }
+
+private:
+    /// Name of the function holding node/edge, "" for globals.
+    static std::string getGroup(const PAGNode* node)
+    {
+        if (node->hasValue())
+        {
+            if (const Function* fun = node->getFunction())
+                return fun->getName().str();
+        }
+        return "";
+    }
+    static std::string getGroup(const PAGEdge* edge)
+    {
+        if (const BasicBlock* bb = edge->getBB())
+            return bb->getParent()->getName().str();
+        return "";
+    }
+
+    std::string computeKey(const PAGNode* node)
+    {
+        NodeID id = node->getId();
+        if (id <= NullPtr)
+            return "s:" + std::to_string(id);
+        if (SVFUtil::isa<DummyValPN>(node) || SVFUtil::isa<DummyObjPN>(node) || !node->hasValue())
+            return "";
+        if (SVFUtil::isa<CloneGepObjPN>(node) || SVFUtil::isa<CloneFIObjPN>(node))
+            return "";
+
+        std::string valueKey = getValueKey(node->getValue());
+        if (valueKey.empty())
+            return "";
+
+        if (SVFUtil::isa<FIObjPN>(node))
+            return "o:" + valueKey;
+        if (const GepValPN* gepVal = SVFUtil::dyn_cast<GepValPN>(node))
+            return "gv:" + std::to_string(gepVal->getOffset()) + ":" + valueKey;
+        if (SVFUtil::isa<RetPN>(node))
+            return "r:" + valueKey;
+        if (SVFUtil::isa<VarArgPN>(node))
+            return "va:" + valueKey;
+        if (SVFUtil::isa<ValPN>(node))
+            return "v:" + valueKey;
+        return "";
+    }
+
+    std::string getValueKey(const Value* val)
+    {
+        if (const GlobalValue* gv = SVFUtil::dyn_cast<GlobalValue>(val))
+            return gv->hasName() ? "@" + gv->getName().str() : "";
+        if (const Argument* arg = SVFUtil::dyn_cast<Argument>(val))
+            return arg->getParent()->getName().str() + "%a" + std::to_string(arg->getArgNo());
+        if (const Instruction* inst = SVFUtil::dyn_cast<Instruction>(val))
+        {
+            const Function* fun = inst->getParent()->getParent();
+            numberFunction(fun);
+            return fun->getName().str() + "%i" + std::to_string(localNumbers[inst]);
+        }
+        if (const BasicBlock* bb = SVFUtil::dyn_cast<BasicBlock>(val))
+        {
+            const Function* fun = bb->getParent();
+            numberFunction(fun);
+            return fun->getName().str() + "%b" + std::to_string(localNumbers[bb]);
+        }
+        if (SVFUtil::isa<Constant>(val))
+        {
+            std::string str;
+            raw_string_ostream rawstr(str);
+            rawstr << *val;
+            return "c:" + rawstr.str();
+        }
+        return "";
+    }
+
+    /// Number the blocks and instructions of fun in layout order.
+    void numberFunction(const Function* fun)
+    {
+        if (!numberedFunctions.insert(fun).second)
+            return;
+        u32_t instNum = 0, bbNum = 0;
+        for (const BasicBlock& bb : *fun)
+        {
+            localNumbers[&bb] = bbNum++;
+            for (const Instruction& inst : bb)
+                localNumbers[&inst] = instNum++;
+        }
+    }
+
+    std::string getEdgeKey(const PAGEdge* edge) const
+    {
+        std::string key = std::to_string(edge->getEdgeKind()) + "|" + getKeyOrUnknown(edge->getSrcID())
+                          + "|" + getKeyOrUnknown(edge->getDstID());
+        if (const NormalGepPE* gep = SVFUtil::dyn_cast<NormalGepPE>(edge))
+            key += "|" + std::to_string(gep->getLocationSet().getOffset());
+        return key;
+    }
+    inline std::string getKeyOrUnknown(NodeID id) const
+    {
+        return keys[id].empty() ? "?" : keys[id];
+    }
+
+    /// Only the nodes and edges built from the module, not those added when solving.
+    void computeGroups()
+    {
+        NodeID numOfPAGNodes = pag->getNodeNumAfterPAGBuild();
+        Map<std::string, std::vector<std::string>> groupItems;
+        for (PAG::iterator it = pag->begin(), eit = pag->end(); it != eit; ++it)
+        {
+            if (it->first >= numOfPAGNodes)
+                continue;
+            const PAGNode* node = it->second;
+            std::string group = getGroup(node);
+            groupNodes[group].set(it->first);
+            groupItems[group].push_back(getKeyOrUnknown(it->first));
+            for (const PAGEdge* edge : node->getOutEdges())
+            {
+                if (edge->getDstID() >= numOfPAGNodes)
+                    continue;
+                std::string edgeGroup = getGroup(edge);
+                groupEdges[edgeGroup].push_back(edge);
+                groupItems[edgeGroup].push_back(getEdgeKey(edge));
+            }
+        }
+
+        for (auto& it : groupItems)
+        {
+            std::sort(it.second.begin(), it.second.end());
+            u64_t h = stableHash(it.first);
+            for (const std::string& item : it.second)
+                h = stableHash(item, h ^ 0x1f);
+            groupHash[it.first] = h;
+        }
+    }
+
+    PAG* pag;
+    NodeID numOfNodes;
+    std::vector<std::string> keys;
+    Map<std::string, NodeID> idOfKey;
+    Set<const Function*> numberedFunctions;
+    Map<const Value*, u32_t> localNumbers;
+    Map<std::string, u64_t> groupHash;
+    Map<std::string, NodeBS> groupNodes;
+    Map<std::string, std::vector<const PAGEdge*>> groupEdges;
+};
+
+}
+
+/*!
+ * Remember the objects which are field-insensitive before solving, so that the
+ * ones collapsed by solving can be told apart.
+ */
+void Andersen::recordInitialFIObjs()
+{
+    initialFIObjs.clear();
+    for (PAG::iterator it = pag->begin(), eit = pag->end(); it != eit; ++it)
+    {
+        if (SVFUtil::isa<FIObjPN>(it->second) && isFieldInsensitive(it->first))
+            initialFIObjs.set(it->first);
+    }
+}
+
+/*!
+ * Save the solution with what the next run needs to invalidate it.
+ * Format (one record per line, node references are NodeIDs of this run):
+ *   SVF-INCANDER <version>
+ *   N <n>, then "<id> k <key>" or "<id> g <base id> <offset>" for field objects
+ *   G <n>, then "<hash> <m> <m impacted node ids> <function>" per function
+ *   P <n>, then "<id> <m> <m objects>" per node with a non-empty points-to set
+ *   D <n>, then "<src> <dst>": dst may change when src changes
+ *   C <n>, then the objects whose base was collapsed when solving
+ */
+void Andersen::writeIncrementalDB(const std::string& filename)
+{
+    outs() << "Storing incremental Andersen's database to '" << filename << "'...";
+
+    std::ofstream F(filename.c_str());
+    if (!F.is_open())
+    {
+        outs() << "  error opening file for writing!\n";
+        return;
+    }
+
+    IncrementalKeys incKeys(pag);
+    NodeID numOfNodes = incKeys.getNumOfNodes();
+
+    F << IncDBMagic << " " << IncDBVersion << "\n";
+
+    /// Names
+    std::ostringstream nodes;
+    u32_t numOfNamed = 0;
+    for (NodeID id = 0; id < numOfNodes; ++id)
+    {
+        if (incKeys.isGepObj(id))
+        {
+            const GepObjPN* gep = SVFUtil::cast<GepObjPN>(pag->getPAGNode(id));
+            NodeID base = pag->getBaseObjNode(id);
+            if (incKeys.getKey(base).empty())
+                continue;
+            nodes << id << " g " << base << " " << gep->getLocationSet().getOffset() << "\n";
+            ++numOfNamed;
+        }
+        else if (!incKeys.getKey(id).empty())
+        {
+            nodes << id << " k " << incKeys.getKey(id) << "\n";
+            ++numOfNamed;
+        }
+    }
+    F << "N " << numOfNamed << "\n" << nodes.str();
+
+    /// Constraints of each function and the nodes they define. Removing a store
+    /// changes the objects its pointer points to rather than the pointer.
+    const Map<std::string, u64_t>& groupHashes = incKeys.getGroupHashes();
+    F << "G " << groupHashes.size() << "\n";
+    for (const auto& it : groupHashes)
+    {
+        NodeBS impacted = incKeys.getGroupNodes(it.first);
+        for (const PAGEdge* edge : incKeys.getGroupEdges(it.first))
+        {
+            if (edge->getEdgeKind() == PAGEdge::Store)
+            {
+                for (NodeID o : getPts(edge->getDstID()))
+                    impacted.set(o);
+            }
+            else
+                impacted.set(edge->getDstID());
+        }
+        F << it.second << " " << impacted.count();
+        for (NodeID id : impacted)
+            F << " " << id;
+        F << " " << it.first << "\n";
+    }
+
+    /// Points-to sets
+    std::ostringstream ptsStream;
+    u32_t numOfPts = 0;
+    for (NodeID id = 0; id < numOfNodes; ++id)
+    {
+        if (!pag->hasGNode(id))
+            continue;
+        const PointsTo& pts = getPts(id);
+        if (pts.empty())
+            continue;
+        ptsStream << id << " " << pts.count();
+        for (NodeID o : pts)
+            ptsStream << " " << o;
+        ptsStream << "\n";
+        ++numOfPts;
+    }
+    F << "P " << numOfPts << "\n" << ptsStream.str();
+
+    /// Dependencies in the final constraint graph
+    std::vector<std::pair<NodeID, NodeID>> deps;
+    for (ConstraintGraph::iterator it = consCG->begin(), eit = consCG->end(); it != eit; ++it)
+    {
+        NodeID n = it->first;
+        ConstraintNode* node = it->second;
+        for (ConstraintEdge* edge : node->getCopyOutEdges())
+            deps.push_back(std::make_pair(n, edge->getDstID()));
+        for (ConstraintEdge* edge : node->getGepOutEdges())
+            deps.push_back(std::make_pair(n, edge->getDstID()));
+        for (ConstraintEdge* edge : node->getLoadOutEdges())
+            deps.push_back(std::make_pair(n, edge->getDstID()));
+        /// a store's copy edges depend on the objects its pointer points to
+        if (!node->getStoreInEdges().empty())
+        {
+            for (NodeID o : getPts(n))
+                deps.push_back(std::make_pair(n, o));
+        }
+    }
+    /// merged nodes share their rep's points-to set
+    for (NodeID id = 0; id < numOfNodes; ++id)
+    {
+        if (!pag->hasGNode(id))
+            continue;
+        NodeID rep = sccRepNode(id);
+        if (rep != id)
+        {
+            deps.push_back(std::make_pair(id, rep));
+            deps.push_back(std::make_pair(rep, id));
+        }
+    }
+    /// the parameters connected at indirect callsites depend on the function pointer
+    for (const auto& it : getIndCallMap())
+    {
+        const CallBlockNode* cs = it.first;
+        if (!pag->isIndirectCallSites(cs))
+            continue;
+        NodeID funPtr = getFunPtr(cs);
+        const RetBlockNode* retBlockNode = cs->getRetBlockNode();
+        if (pag->callsiteHasRet(retBlockNode))
+            deps.push_back(std::make_pair(funPtr, pag->getCallSiteRet(retBlockNode)->getId()));
+        for (const SVFFunction* callee : it.second)
+        {
+            if (pag->hasFunArgsList(callee))
+            {
+                for (const PAGNode* arg : pag->getFunArgsList(callee))
+                    deps.push_back(std::make_pair(funPtr, arg->getId()));
+            }
+            if (callee->getLLVMFun()->isVarArg())
+                deps.push_back(std::make_pair(funPtr, pag->getVarargNode(callee)));
+        }
+    }
+    F << "D " << deps.size() << "\n";
+    for (const auto& dep : deps)
+        F << dep.first << " " << dep.second << "\n";
+
+    /// Objects collapsed when solving (e.g., by variant geps or PWCs)
+    NodeBS collapsed;
+    for (NodeID id = 0; id < numOfNodes; ++id)
+    {
+        if (!pag->hasGNode(id) || !SVFUtil::isa<FIObjPN>(pag->getPAGNode(id)))
+            continue;
+        if (isFieldInsensitive(id) && !initialFIObjs.test(id))
+            collapsed |= pag->getAllFieldsObjNode(id);
+    }
+    F << "C " << collapsed.count() << "\n";
+    for (NodeID id : collapsed)
+        F << id << "\n";
+
+    F.close();
+    outs() << "\n";
+}
+
+/*!
+ * Seed points-to sets from the database of the previous run (see
+ * writeIncrementalDB), skipping those which the changes may have invalidated.
+ * Returns false, seeding nothing, if there is no usable database.
+ */
+bool Andersen::seedFromIncrementalDB(const std::string& filename)
+{
+    std::ifstream F(filename.c_str());
+    if (!F.is_open())
+        return false;
+
+    outs() << "Loading incremental Andersen's database from '" << filename << "'...";
+
+    std::string magic;
+    u32_t version = 0;
+    F >> magic >> version;
+    if (magic != IncDBMagic || version != IncDBVersion)
+    {
+        outs() << "  unsupported database, solving from scratch\n";
+        return false;
+    }
+
+    auto readSection = [&F](const char* name, u32_t& num)
+    {
+        std::string tag;
+        F >> tag >> num;
+        return F.good() && tag == name;
+    };
+
+    /// Old names, and field objects as (base, offset)
+    u32_t num = 0;
+    if (!readSection("N", num))
+    {
+        outs() << "  corrupted database, solving from scratch\n";
+        return false;
+    }
+    Map<NodeID, std::string> oldKeys;
+    Map<NodeID, std::pair<NodeID, Size_t>> oldGepObjs;
+    for (u32_t i = 0; i < num; ++i)
+    {
+        NodeID id;
+        std::string kind;
+        F >> id >> kind;
+        if (kind == "g")
+        {
+            NodeID base;
+            Size_t offset;
+            F >> base >> offset;
+            oldGepObjs[id] = std::make_pair(base, offset);
+        }
+        else
+        {
+            F.get();
+            std::getline(F, oldKeys[id]);
+        }
+    }
+
+    /// Changed functions
+    IncrementalKeys incKeys(pag);
+    const Map<std::string, u64_t>& newHashes = incKeys.getGroupHashes();
+    NodeBS invalidated;
+    if (!readSection("G", num))
+    {
+        outs() << "  corrupted database, solving from scratch\n";
+        return false;
+    }
+    numOfIncChangedFuns = 0;
+    for (u32_t i = 0; i < num; ++i)
+    {
+        u64_t hash;
+        u32_t numOfImpacted;
+        F >> hash >> numOfImpacted;
+        NodeBS impacted;
+        for (u32_t j = 0; j < numOfImpacted; ++j)
+        {
+            NodeID id;
+            F >> id;
+            impacted.set(id);
+        }
+        std::string group;
+        F.get();
+        std::getline(F, group);
+
+        Map<std::string, u64_t>::const_iterator it = newHashes.find(group);
+        if (it == newHashes.end() || it->second != hash)
+        {
+            invalidated |= impacted;
+            ++numOfIncChangedFuns;
+        }
+    }
+
+    /// Translate an old object into this run, -1 if it cannot be
+    Map<NodeID, s64_t> translated;
+    std::function<s64_t(NodeID)> translate = [&](NodeID oldId) -> s64_t
+    {
+        Map<NodeID, s64_t>::iterator it = translated.find(oldId);
+        if (it != translated.end())
+            return it->second;
+
+        s64_t newId = -1;
+        Map<NodeID, std::pair<NodeID, Size_t>>::const_iterator git = oldGepObjs.find(oldId);
+        if (git != oldGepObjs.end())
+        {
+            s64_t base = translate(git->second.first);
+            if (base != -1 && SVFUtil::isa<FIObjPN>(pag->getPAGNode(base)) && !isFieldInsensitive(base))
+                newId = consCG->getGepObjNode(base, LocationSet(git->second.second));
+        }
+        else
+        {
+            Map<NodeID, std::string>::const_iterator kit = oldKeys.find(oldId);
+            if (kit != oldKeys.end())
+                newId = incKeys.getIdOfKey(kit->second);
+        }
+        translated[oldId] = newId;
+        return newId;
+    };
+
+    /// Old points-to sets; those with objects unknown to this run cannot be seeded
+    /// and, as their successors may have received the unknown objects' contents,
+    /// are treated as changed.
+    if (!readSection("P", num))
+    {
+        outs() << "  corrupted database, solving from scratch\n";
+        return false;
+    }
+    Map<NodeID, std::vector<NodeID>> oldPts;
+    for (u32_t i = 0; i < num; ++i)
+    {
+        NodeID id;
+        u32_t size;
+        F >> id >> size;
+        std::vector<NodeID>& pts = oldPts[id];
+        pts.resize(size);
+        for (u32_t j = 0; j < size; ++j)
+            F >> pts[j];
+    }
+
+    if (!readSection("D", num))
+    {
+        outs() << "  corrupted database, solving from scratch\n";
+        return false;
+    }
+    Map<NodeID, std::vector<NodeID>> deps;
+    for (u32_t i = 0; i < num; ++i)
+    {
+        NodeID src, dst;
+        F >> src >> dst;
+        deps[src].push_back(dst);
+    }
+
+    if (!readSection("C", num))
+    {
+        outs() << "  corrupted database, solving from scratch\n";
+        return false;
+    }
+    for (u32_t i = 0; i < num; ++i)
+    {
+        NodeID id;
+        F >> id;
+        invalidated.set(id);
+    }
+    if (F.fail())
+    {
+        outs() << "  corrupted database, solving from scratch\n";
+        return false;
+    }
+
+    for (const auto& it : oldPts)
+    {
+        if (translate(it.first) == -1)
+        {
+            invalidated.set(it.first);
+            continue;
+        }
+        for (NodeID o : it.second)
+        {
+            if (translate(o) == -1)
+            {
+                invalidated.set(it.first);
+                break;
+            }
+        }
+    }
+
+    /// Everything depending on a change
+    FIFOWorkList<NodeID> worklist;
+    for (NodeID id : invalidated)
+        worklist.push(id);
+    while (!worklist.empty())
+    {
+        NodeID id = worklist.pop();
+        Map<NodeID, std::vector<NodeID>>::const_iterator it = deps.find(id);
+        if (it == deps.end())
+            continue;
+        for (NodeID dst : it->second)
+        {
+            if (invalidated.test_and_set(dst))
+                worklist.push(dst);
+        }
+    }
+
+    /// Seed the rest
+    numOfIncInvalidatedNodes = 0;
+    numOfIncSeededNodes = 0;
+    for (const auto& it : oldPts)
+    {
+        if (invalidated.test(it.first))
+        {
+            ++numOfIncInvalidatedNodes;
+            continue;
+        }
+        NodeID id = translate(it.first);
+        PointsTo pts;
+        for (NodeID o : it.second)
+            pts.set(translate(o));
+        unionPts(id, pts);
+        pushIntoWorklist(id);
+        ++numOfIncSeededNodes;
+    }
+
+    outs() << " " << numOfIncChangedFuns << " changed functions, " << numOfIncSeededNodes
+           << " points-to sets seeded, " << numOfIncInvalidatedNodes << " invalidated\n";
+    return true;
+}
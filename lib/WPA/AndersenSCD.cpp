@@ -165,7 +165,7 @@ void AndersenSCD::processPWC(ConstraintNode* rep)
     for (NodeID nId : getSCCDetector()->subNodes(repId))
         pwcNodes.insert(nId);
 
-    WorkList tmpWorkList;
+    FIFOWorkList<NodeID> tmpWorkList;
     for (NodeID subId : pwcNodes)
         if (isInWorklist(subId))
             tmpWorkList.push(subId);
@@ -54,7 +54,9 @@ AndersenStat::AndersenStat(AndersenBase* p): PTAStat(p),pta(p)
 }
 
 /*!
- * Collect cycle information
+ * Collect cycle information.
+ * Nodes merged by variable substitution share the sub nodes of their rep with the
+ * nodes of a cycle, but are pointer equivalent rather than in a cycle, so they are not counted.
  */
 void AndersenStat::collectCycleInfo(ConstraintGraph* consCG)
 {
@@ -63,12 +65,15 @@ void AndersenStat::collectCycleInfo(ConstraintGraph* consCG)
     _NumOfNodesInCycles = 0;
     NodeSet repNodes;
     repNodes.clear();
+    const Andersen* ander = SVFUtil::dyn_cast<Andersen>(pta);
     for(ConstraintGraph::iterator it = consCG->begin(), eit = consCG->end(); it!=eit; ++it)
     {
         // sub nodes have been removed from the constraint graph, only rep nodes are left.
         NodeID repNode = consCG->sccRepNode(it->first);
         NodeBS& subNodes = consCG->sccSubNodes(repNode);
         NodeBS clone = subNodes;
+        if (ander)
+            clone.intersectWithComplement(ander->getVarSubstNodes());
         for (NodeBS::iterator it = subNodes.begin(), eit = subNodes.end(); it != eit; ++it)
         {
             NodeID nodeId = *it;
@@ -289,6 +294,7 @@ void AndersenStat::performStat()
     u32_t totalTopLevPointers = 0;
     u32_t totalPtsSize = 0;
     u32_t totalTopLevPtsSize = 0;
+    size_t totalPtsMem = 0;
     for (PAG::iterator iter = pta->getPAG()->begin(), eiter = pta->getPAG()->end();
             iter != eiter; ++iter)
     {
@@ -297,6 +303,7 @@ void AndersenStat::performStat()
         u32_t size = pts.count();
         totalPointers++;
         totalPtsSize+=size;
+        totalPtsMem += pts.getMemoryUsage();
 
         if(pta->getPAG()->isValidTopLevelPtr(pta->getPAG()->getPAGNode(node)))
         {
@@ -321,6 +328,7 @@ void AndersenStat::performStat()
     timeStatMap[ProcessLoadStoreTime] =  Andersen::timeOfProcessLoadStore;
     timeStatMap[ProcessCopyGepTime] =  Andersen::timeOfProcessCopyGep;
     timeStatMap[UpdateCallGraphTime] =  Andersen::timeOfUpdateCallGraph;
+    timeStatMap["VarSubstTime"] = Andersen::timeOfVarSubst;
 
     PTNumStatMap[TotalNumOfPointers] = pag->getValueNodeNum() + pag->getFieldValNodeNum();
     PTNumStatMap[TotalNumOfObjects] = pag->getObjectNodeNum() + pag->getFieldObjNodeNum();
@@ -344,8 +352,14 @@ void AndersenStat::performStat()
     timeStatMap[AverageTopLevPointsToSetSize] = (double)totalTopLevPtsSize/totalTopLevPointers;;
 
     PTNumStatMap[MaxPointsToSetSize] = _MaxPtsSize;
+    PTNumStatMap[PointsToSetMemUsage] = totalPtsMem / 1024;
+
+    u32_t vmhwm = 0;
+    if (SVFUtil::getPeakMemoryUsageKB(&vmhwm))
+        PTNumStatMap[PeakMemUsage] = vmhwm;
 
     PTNumStatMap[NumOfIterations] = pta->numOfIteration;
+    PTNumStatMap["WorklistPops"] = pta->getNumOfWorklistPops();
 
     PTNumStatMap[NumOfIndirectCallSites] = consCG->getIndirectCallsites().size();
     PTNumStatMap[NumOfIndirectEdgeSolved] = pta->getNumOfResolvedIndCallEdge();
@@ -358,6 +372,18 @@ void AndersenStat::performStat()
     PTNumStatMap[NumOfNullPointer] = _NumOfNullPtr;
     PTNumStatMap["PointsToConstPtr"] = _NumOfConstantPtr;
     PTNumStatMap["PointsToBlkPtr"] = _NumOfBlackholePtr;
+    PTNumStatMap["VarSubstNodes"] = Andersen::numOfVarSubstNodes;
+    PTNumStatMap["VarSubstEdges"] = Andersen::numOfVarSubstEdges;
+
+    ptCacheStat();
+    clusterStat();
+
+    if (Andersen::numOfIncSeededNodes || Andersen::numOfIncInvalidatedNodes)
+    {
+        PTNumStatMap["IncChangedFuns"] = Andersen::numOfIncChangedFuns;
+        PTNumStatMap["IncSeededPts"] = Andersen::numOfIncSeededNodes;
+        PTNumStatMap["IncInvalidatedPts"] = Andersen::numOfIncInvalidatedNodes;
+    }
 
     PTAStat::printStat("Andersen Pointer Analysis Stats");
 }
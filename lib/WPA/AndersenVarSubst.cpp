@@ -0,0 +1,106 @@
+//===- AndersenVarSubst.cpp -- Offline variable substitution of Andersen's ---//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * AndersenVarSubst.cpp
+ *
+ * Merging of pointer equivalent constraint nodes before solving (-ander-var-subst).
+ *
+ * Pointer equivalent nodes (see VarSubstitution.h) end with equal points-to sets,
+ * so each of them is merged into the smallest node of its value number exactly as
+ * the nodes of a cycle are, and clients reach the merged sets through sccRepNode.
+ * Nodes which never point to anything are all merged into one.
+ * The merged nodes are recorded so that cycle statistics leave them out.
+ */
+
+#include "WPA/Andersen.h"
+#include "Graphs/VarSubstitution.h"
+
+using namespace SVF;
+using namespace SVFUtil;
+
+static llvm::cl::opt<bool> AnderVarSubst("ander-var-subst",  llvm::cl::init(false),
+        llvm::cl::desc("Merge pointer equivalent constraint nodes before solving Andersen's analysis"));
+
+u32_t Andersen::numOfVarSubstNodes = 0;
+u32_t Andersen::numOfVarSubstEdges = 0;
+double Andersen::timeOfVarSubst = 0;
+
+bool Andersen::getDefaultVarSubstitution()
+{
+    return AnderVarSubst;
+}
+
+namespace
+{
+
+inline u32_t getNumOfConsNodes(ConstraintGraph* consCG)
+{
+    u32_t num = 0;
+    for (ConstraintGraph::iterator it = consCG->begin(), eit = consCG->end(); it != eit; ++it)
+        num++;
+    return num;
+}
+
+inline u32_t getNumOfConsEdges(ConstraintGraph* consCG)
+{
+    return consCG->getAddrCGEdges().size() + consCG->getDirectCGEdges().size()
+           + consCG->getLoadCGEdges().size() + consCG->getStoreCGEdges().size();
+}
+
+}
+
+/*!
+ * Hash-based value numbering of the initial constraint graph, called before any
+ * points-to set is built
+ */
+void Andersen::substituteVariables()
+{
+    double start = PTAStat::getClk();
+
+    u32_t numOfNodes = getNumOfConsNodes(consCG);
+    u32_t numOfEdges = getNumOfConsEdges(consCG);
+
+    VarSubstitution subst(consCG, pag);
+    subst.solve();
+
+    const VarSubstitution::NodeRepPairs& merges = subst.getMerges();
+    for (VarSubstitution::NodeRepPairs::const_iterator it = merges.begin(), eit = merges.end(); it != eit; ++it)
+    {
+        NodeID node = sccRepNode(it->first);
+        NodeID rep = sccRepNode(it->second);
+        if (node != rep)
+        {
+            varSubstNodes.set(node);
+            mergeNodeToRep(node, rep);
+        }
+    }
+
+    numOfVarSubstNodes = numOfNodes - getNumOfConsNodes(consCG);
+    numOfVarSubstEdges = numOfEdges - getNumOfConsEdges(consCG);
+
+    double end = PTAStat::getClk();
+    timeOfVarSubst = (end - start) / TIMEINTERVAL;
+
+    DBOUT(DGENERAL, outs() << SVFUtil::pasMsg("Variable substitution: ") << subst.getNumOfValueNumbers()
+          << " value numbers, " << numOfVarSubstNodes << " nodes and " << numOfVarSubstEdges << " edges removed\n");
+}
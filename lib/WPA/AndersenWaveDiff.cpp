@@ -28,10 +28,18 @@
  */
 
 #include "WPA/Andersen.h"
+#include "Util/Parallel.h"
 
 using namespace SVF;
 using namespace SVFUtil;
 
+static llvm::cl::opt<u32_t> WaveThreads("wave-threads", llvm::cl::init(1),
+                                        llvm::cl::desc("Number of threads for wave propagation (1: serial, 0: all hardware threads)"));
+
+/// Number of nodes whose loads/stores are scanned in one parallel round, this bounds
+/// the memory used to buffer candidate copy edges.
+static const u32_t LoadStoreBatchSize = 4096;
+
 AndersenWaveDiff* AndersenWaveDiff::diffWave = NULL;
 
 /*!
@@ -39,6 +47,14 @@ AndersenWaveDiff* AndersenWaveDiff::diffWave = NULL;
  */
 void AndersenWaveDiff::solveWorklist()
 {
+    u32_t numOfThreads = ParallelUtil::getNumOfThreads(WaveThreads);
+    // the call backs of the cycle detector are not thread-safe
+    if (numOfThreads > 1 && cycleDetector->getKind() == CycleDetector::None)
+    {
+        solveWorklistInParallel(numOfThreads);
+        return;
+    }
+
     // Initialize the nodeStack via a whole SCC detection
     // Nodes in nodeStack are in topological order by default.
     NodeStack& nodeStack = SCCDetect();
@@ -78,7 +94,17 @@ void AndersenWaveDiff::solveWorklist()
     // New nodes will be inserted into workList during processing.
     while (!isWorklistEmpty())
     {
+        cycleDetector->mergeDetectedCycles();
+
         NodeID nodeId = popFromWorklist();
+        cycleDetector->beforeProcessNode(nodeId);
+        // The cycle detector may have merged this node, whose rep then holds its constraints.
+        NodeID rep = sccRepNode(nodeId);
+        if (rep != nodeId)
+        {
+            pushMergedRep(rep);
+            continue;
+        }
         // process nodes in worklist
         postProcessNode(nodeId);
     }
@@ -141,7 +167,10 @@ void AndersenWaveDiff::handleCopyGep(ConstraintNode* node)
     {
         for (ConstraintEdge* edge : node->getCopyOutEdges())
             if (CopyCGEdge* copyEdge = SVFUtil::dyn_cast<CopyCGEdge>(edge))
+            {
+                cycleDetector->beforeProcessCopy(nodeId, copyEdge);
                 processCopy(nodeId, copyEdge);
+            }
         for (ConstraintEdge* edge : node->getGepOutEdges())
             if (GepCGEdge* gepEdge = SVFUtil::dyn_cast<GepCGEdge>(edge))
                 processGep(nodeId, gepEdge);
@@ -216,3 +245,237 @@ void AndersenWaveDiff::mergeNodeToRep(NodeID nodeId,NodeID newRepId)
 
     Andersen::mergeNodeToRep(nodeId, newRepId);
 }
+
+/*!
+ * Solve worklist with multiple threads.
+ * Same three phases as solveWorklist(), i.e., SCC detection, wave propagation in topological
+ * order and load/store processing, while the nodes of one topological level are propagated concurrently.
+ */
+void AndersenWaveDiff::solveWorklistInParallel(u32_t numOfThreads)
+{
+    // Initialize the nodeStack via a whole SCC detection
+    NodeStack& nodeStack = SCCDetect();
+
+    // Group nodes into topological levels, there are no copy edges between nodes in the same level
+    std::vector<NodeVector> levels;
+    computeWaveLevels(nodeStack, levels);
+    for (const NodeVector& level : levels)
+        processLevelInParallel(level, numOfThreads);
+
+    // This modification is to make WAVE feasible to handle PWC analysis
+    if (!mergePWC())
+    {
+        NodeStack tmpWorklist;
+        while (!isWorklistEmpty())
+        {
+            NodeID nodeId = popFromWorklist();
+            collapsePWCNode(nodeId);
+            processNode(nodeId);
+            collapseFields();
+            tmpWorklist.push(nodeId);
+        }
+        while (!tmpWorklist.empty())
+        {
+            NodeID nodeId = tmpWorklist.top();
+            tmpWorklist.pop();
+            pushIntoWorklist(nodeId);
+        }
+    }
+
+    // Processing loads and stores never pushes nodes, so the worklist can be drained up front.
+    NodeVector nodes;
+    NodeSet visited;
+    while (!isWorklistEmpty())
+    {
+        NodeID nodeId = popFromWorklist();
+        if (visited.insert(nodeId).second)
+            nodes.push_back(nodeId);
+    }
+    postProcessNodesInParallel(nodes, numOfThreads);
+}
+
+/*!
+ * Assign each node in nodeStack (in topological order) a level which is
+ * one more than the maximum level of its direct predecessors.
+ */
+void AndersenWaveDiff::computeWaveLevels(NodeStack& nodeStack, std::vector<NodeVector>& levels)
+{
+    Map<NodeID, u32_t> nodeToLevel;
+    while (!nodeStack.empty())
+    {
+        NodeID nodeId = nodeStack.top();
+        nodeStack.pop();
+
+        u32_t level = 0;
+        ConstraintNode* node = consCG->getConstraintNode(nodeId);
+        for (ConstraintEdge* edge : node->getDirectInEdges())
+        {
+            // predecessors not yet visited are reached via back edges (e.g., gep cycles when PWC is disabled)
+            Map<NodeID, u32_t>::const_iterator it = nodeToLevel.find(edge->getSrcID());
+            if (it != nodeToLevel.end() && it->second + 1 > level)
+                level = it->second + 1;
+        }
+        nodeToLevel[nodeId] = level;
+
+        if (level >= levels.size())
+            levels.resize(level + 1);
+        levels[level].push_back(nodeId);
+    }
+}
+
+/*!
+ * Propagate diff points-to sets from all nodes of one level.
+ * 1. (serial) collapse PWC nodes and compute diff points-to sets. All PWC nodes of the level
+ *    are collapsed before any edge or diff points-to set is collected, as collapsing merges
+ *    nodes and frees their edges;
+ * 2. (parallel) for every destination of a copy edge, union the diff points-to
+ *    of its sources in this level. Each destination is owned by one thread;
+ * 3. (serial) apply the new points-to to destinations and process gep edges.
+ */
+void AndersenWaveDiff::processLevelInParallel(const NodeVector& level, u32_t numOfThreads)
+{
+    double propStart = stat->getClk();
+
+    typedef std::pair<const ConstraintEdge*, const PointsTo*> EdgeAndDiffPts;
+
+    NodeVector srcNodes;
+    NodeVector dstNodes;
+    Map<NodeID, u32_t> dstToIdx;
+    std::vector<std::vector<EdgeAndDiffPts>> dstInEdges;
+    for (NodeID nodeId : level)
+        collapsePWCNode(nodeId);
+
+    for (NodeID nodeId : level)
+    {
+        // This node may be merged during collapseNodePts()
+        if (sccRepNode(nodeId) != nodeId)
+            continue;
+        computeDiffPts(nodeId);
+        if (!getDiffPts(nodeId).empty())
+            srcNodes.push_back(nodeId);
+    }
+
+    for (NodeID nodeId : srcNodes)
+    {
+        const PointsTo& diffPts = getDiffPts(nodeId);
+        ConstraintNode* node = consCG->getConstraintNode(nodeId);
+        for (ConstraintEdge* edge : node->getCopyOutEdges())
+        {
+            if (!SVFUtil::isa<CopyCGEdge>(edge))
+                continue;
+            NodeID dst = sccRepNode(edge->getDstID());
+            std::pair<Map<NodeID, u32_t>::iterator, bool> res = dstToIdx.insert(std::make_pair(dst, dstNodes.size()));
+            if (res.second)
+            {
+                dstNodes.push_back(dst);
+                dstInEdges.push_back(std::vector<EdgeAndDiffPts>());
+            }
+            dstInEdges[res.first->second].push_back(std::make_pair(edge, &diffPts));
+        }
+    }
+
+    // Points-to sets are only read by the workers, fetch them here so that no map is modified concurrently.
+    std::vector<const PointsTo*> dstPts;
+    dstPts.reserve(dstNodes.size());
+    for (NodeID dst : dstNodes)
+        dstPts.push_back(&getPts(dst));
+
+    std::vector<PointsTo> newPts(dstNodes.size());
+    ParallelUtil::parallelFor(dstNodes.size(), numOfThreads, [&](u32_t i, u32_t)
+    {
+        PointsTo& pts = newPts[i];
+        for (const EdgeAndDiffPts& inEdge : dstInEdges[i])
+            pts |= *inEdge.second;
+        pts.intersectWithComplement(*dstPts[i]);
+    });
+
+    for (u32_t i = 0; i < dstNodes.size(); ++i)
+    {
+        for (const EdgeAndDiffPts& inEdge : dstInEdges[i])
+        {
+            numOfProcessedCopy++;
+            processCast(inEdge.first);
+        }
+        if (!newPts[i].empty() && unionPts(dstNodes[i], newPts[i]))
+            pushIntoWorklist(dstNodes[i]);
+    }
+
+    for (NodeID nodeId : srcNodes)
+    {
+        if (sccRepNode(nodeId) != nodeId)
+            continue;
+        ConstraintNode* node = consCG->getConstraintNode(nodeId);
+        for (ConstraintEdge* edge : node->getGepOutEdges())
+            if (GepCGEdge* gepEdge = SVFUtil::dyn_cast<GepCGEdge>(edge))
+                processGep(nodeId, gepEdge);
+    }
+    collapseFields();
+
+    double propEnd = stat->getClk();
+    timeOfProcessCopyGep += (propEnd - propStart) / TIMEINTERVAL;
+}
+
+/*!
+ * Process loads and stores of nodes.
+ * Workers only look for (object, load/store edge) pairs which may introduce a copy edge
+ * not yet on the constraint graph, the edges are then added serially in the order of nodes.
+ * Note that numOfProcessedLoad/Store only count the pairs which may introduce new copy edges.
+ */
+void AndersenWaveDiff::postProcessNodesInParallel(const NodeVector& nodes, u32_t numOfThreads)
+{
+    double insertStart = stat->getClk();
+
+    typedef std::pair<NodeID, const ConstraintEdge*> ObjAndEdge;
+
+    for (u32_t begin = 0; begin < nodes.size(); begin += LoadStoreBatchSize)
+    {
+        u32_t num = std::min<u32_t>(LoadStoreBatchSize, nodes.size() - begin);
+
+        std::vector<const PointsTo*> nodePts(num);
+        for (u32_t i = 0; i < num; ++i)
+            nodePts[i] = &getPts(nodes[begin + i]);
+
+        std::vector<std::vector<ObjAndEdge>> candidates(num);
+        ParallelUtil::parallelFor(num, numOfThreads, [&](u32_t i, u32_t)
+        {
+            const ConstraintNode* node = consCG->getConstraintNode(nodes[begin + i]);
+            const PointsTo& pts = *nodePts[i];
+            for (ConstraintNode::const_iterator it = node->outgoingLoadsBegin(), eit = node->outgoingLoadsEnd();
+                    it != eit; ++it)
+            {
+                ConstraintNode* dstNode = consCG->getConstraintNode((*it)->getDstID());
+                for (PointsTo::iterator piter = pts.begin(), epiter = pts.end(); piter != epiter; ++piter)
+                {
+                    ConstraintNode* srcNode = consCG->getConstraintNode(*piter);
+                    if (srcNode != dstNode && !consCG->hasEdge(srcNode, dstNode, ConstraintEdge::Copy))
+                        candidates[i].push_back(std::make_pair(*piter, *it));
+                }
+            }
+            for (ConstraintNode::const_iterator it = node->incomingStoresBegin(), eit = node->incomingStoresEnd();
+                    it != eit; ++it)
+            {
+                ConstraintNode* srcNode = consCG->getConstraintNode((*it)->getSrcID());
+                for (PointsTo::iterator piter = pts.begin(), epiter = pts.end(); piter != epiter; ++piter)
+                {
+                    ConstraintNode* dstNode = consCG->getConstraintNode(*piter);
+                    if (srcNode != dstNode && !consCG->hasEdge(srcNode, dstNode, ConstraintEdge::Copy))
+                        candidates[i].push_back(std::make_pair(*piter, *it));
+                }
+            }
+        });
+
+        for (u32_t i = 0; i < num; ++i)
+        {
+            for (const ObjAndEdge& cand : candidates[i])
+            {
+                bool changed = SVFUtil::isa<LoadCGEdge>(cand.second) ? processLoad(cand.first, cand.second)
+                               : processStore(cand.first, cand.second);
+                if (changed)
+                    reanalyze = true;
+            }
+        }
+    }
+
+    double insertEnd = stat->getClk();
+    timeOfProcessLoadStore += (insertEnd - insertStart) / TIMEINTERVAL;
+}
@@ -0,0 +1,193 @@
+//===- CycleDetector.cpp -- Online cycle detection policies of Andersen's ---//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * CycleDetector.cpp
+ *
+ * Lazy and hybrid cycle detection, see CycleDetector.h.
+ * The policies were previously the analyses AndersenLCD, AndersenHCD and AndersenHLCD.
+ */
+
+#include "WPA/CycleDetector.h"
+#include "WPA/Andersen.h"
+
+using namespace SVF;
+using namespace SVFUtil;
+
+static llvm::cl::opt<CycleDetector::Kind> CycleDetection("cycle-detection", llvm::cl::init(CycleDetector::None),
+        llvm::cl::desc("Online cycle detection of Andersen's analyses (lander, hander and hlander choose their own)"),
+        llvm::cl::values(
+            clEnumValN(CycleDetector::None, "none", "only the SCC detection of the solver (default)"),
+            clEnumValN(CycleDetector::Lazy, "lazy", "lazy cycle detection"),
+            clEnumValN(CycleDetector::Hybrid, "hybrid", "hybrid cycle detection"),
+            clEnumValN(CycleDetector::HybridLazy, "hybrid-lazy", "hybrid and lazy cycle detection")));
+
+CycleDetector* CycleDetector::create(Kind kind, Andersen* ander)
+{
+    switch (kind)
+    {
+    case Lazy:
+        return new LazyCycleDetector(ander);
+    case Hybrid:
+        return new HybridCycleDetector(ander);
+    case HybridLazy:
+        return new HybridLazyCycleDetector(ander);
+    default:
+        return new CycleDetector(ander);
+    }
+}
+
+CycleDetector::Kind CycleDetector::getDefaultKind()
+{
+    return CycleDetection;
+}
+
+const char* CycleDetector::getKindName(Kind kind)
+{
+    switch (kind)
+    {
+    case Lazy:
+        return "lazy";
+    case Hybrid:
+        return "hybrid";
+    case HybridLazy:
+        return "hybrid-lazy";
+    default:
+        return "none";
+    }
+}
+
+/*!
+ * SCC detection starting from the candidates only, the reps of the merged cycles
+ * are processed again
+ */
+void CycleDetector::detectAndMergeCycles(const NodeSet& candidates)
+{
+    Andersen::numOfSCCDetection++;
+
+    NodeSet sccCandidates;
+    for (NodeSet::const_iterator it = candidates.begin(), eit = candidates.end(); it != eit; ++it)
+        if (ander->sccRepNode(*it) == *it)
+            sccCandidates.insert(*it);
+
+    double sccStart = PTAStat::getClk();
+    ander->getSCCDetector()->find(sccCandidates);
+    double sccEnd = PTAStat::getClk();
+    Andersen::timeOfSCCDetection += (sccEnd - sccStart) / TIMEINTERVAL;
+
+    double mergeStart = PTAStat::getClk();
+    ander->mergeSccCycle();
+    double mergeEnd = PTAStat::getClk();
+    Andersen::timeOfSCCMerges += (mergeEnd - mergeStart) / TIMEINTERVAL;
+
+    const NodeBS& reps = ander->getSCCDetector()->getRepNodes();
+    for (NodeBS::iterator it = reps.begin(), eit = reps.end(); it != eit; ++it)
+        ander->pushMergedRep(*it);
+}
+
+/*!
+ * Merge node and its points-to set into rep
+ */
+void CycleDetector::mergeNodeAndPts(NodeID node, NodeID rep)
+{
+    if (ander->unionPts(rep, node))
+        ander->pushMergedRep(rep);
+    // Once a node is merged to its rep, it is collapsed,
+    // only its ID remaining in the sub nodes of its rep node.
+    ander->mergeNodeToRep(node, rep);
+}
+
+/*!
+ * If the points-to sets of both ends of a copy edge are equal, the edge is
+ * likely to be in a cycle. Each edge is checked once.
+ */
+void LazyCycleDetector::beforeProcessCopy(NodeID src, const ConstraintEdge* edge)
+{
+    NodeID dst = edge->getDstID();
+    const PointsTo& srcPts = ander->getPts(src);
+    if (!srcPts.empty() && srcPts == ander->getPts(dst) && metEdges.insert(edge->getEdgeID()).second)
+        candidates.insert(dst);
+}
+
+/*!
+ * Collapse cycles through the candidates
+ */
+void LazyCycleDetector::mergeDetectedCycles()
+{
+    if (candidates.empty())
+        return;
+    detectAndMergeCycles(candidates);
+    candidates.clear();
+}
+
+HybridCycleDetector::~HybridCycleDetector()
+{
+    delete oCG;
+    oCG = NULL;
+}
+
+/*!
+ * Build the offline constraint graph and solve its cycles
+ */
+void HybridCycleDetector::initialize()
+{
+    oCG = new OfflineConsG(ander->getPAG());
+    OfflineConsG::OSCC* oscc = new OfflineConsG::OSCC(oCG);
+    oscc->find();
+    oCG->solveOfflineSCC(oscc);
+    delete oscc;
+}
+
+/*!
+ * If the dereference of nodeId is in an offline cycle, merge the targets
+ * nodeId points to with the online rep of that cycle
+ */
+void HybridCycleDetector::beforeProcessNode(NodeID nodeId)
+{
+    if (!oCG->hasOCGRep(nodeId))
+        return;
+
+    ConstraintGraph* consCG = ander->getConstraintGraph();
+    NodeID rep = consCG->sccRepNode(oCG->getOCGRep(nodeId));
+    const PointsTo& pts = ander->getPts(nodeId);
+    NodeVector targets;
+    for (PointsTo::iterator ptIt = pts.begin(), ptEit = pts.end(); ptIt != ptEit; ++ptIt)
+    {
+        NodeID tgt = *ptIt;
+        ConstraintNode* tgtNode = consCG->getConstraintNode(tgt);
+        if (!tgtNode->getDirectInEdges().empty())
+            continue;
+        if (tgtNode->getAddrOutEdges().size() > 1)
+            continue;
+        assert(!oCG->isaRef(tgt) && "Point-to target should not be a ref node!");
+        targets.push_back(tgt);
+    }
+
+    /// merging may change the points-to set being iterated, so merge afterwards
+    for (NodeVector::const_iterator it = targets.begin(), eit = targets.end(); it != eit; ++it)
+    {
+        NodeID node = ander->sccRepNode(*it);
+        NodeID tgtRep = ander->sccRepNode(rep);
+        if (node != tgtRep && mergedNodes.insert(node).second)
+            mergeNodeAndPts(node, tgtRep);
+    }
+}
@@ -33,8 +33,10 @@
 #include "WPA/WPAStat.h"
 #include "WPA/FlowSensitive.h"
 #include "WPA/Andersen.h"
+#include "MemoryModel/ObjectClusterer.h"
 
 static llvm::cl::opt<bool> CTirAliasEval("ctir-alias-eval", llvm::cl::init(false), llvm::cl::desc("Prints alias evaluation of ctir instructions in FS analyses"));
+static llvm::cl::opt<bool> ClusterFs("cluster-fs", llvm::cl::init(false), llvm::cl::desc("Renumber objects after the auxiliary Andersen's analysis for denser points-to sets"));
 
 using namespace SVF;
 using namespace SVFUtil;
@@ -54,6 +56,11 @@ void FlowSensitive::initialize()
     setGraph(svfg);
     //AndersenWaveDiff::releaseAndersenWaveDiff();
 
+    /// Done after building the SVFG so that the points-to sets used to build it
+    /// and those solved here rarely meet.
+    if (ClusterFs)
+        nodeMapping = ObjectClusterer::cluster(ander);
+
     stat = new FlowSensitiveStat(this);
 }
 
@@ -64,6 +71,7 @@ void FlowSensitive::analyze()
 {
     /// Initialization for the Solver
     initialize();
+    PointsTo::NodeMappingScope mappingScope(nodeMapping);
 
     double start = stat->getClk(true);
     /// Start solving constraints
@@ -120,7 +128,7 @@ void FlowSensitive::finalize()
         }
     }
 
-    PointerAnalysis::finalize();
+    BVDataPTAImpl::finalize();
 }
 
 /*!
@@ -30,6 +30,7 @@
 #include "SVF-FE/LLVMUtil.h"
 #include "WPA/WPAStat.h"
 #include "WPA/FlowSensitive.h"
+#include "WPA/VersionedFlowSensitive.h"
 
 using namespace SVF;
 using namespace SVFUtil;
@@ -47,6 +48,9 @@ void FlowSensitiveStat::clearStat()
     _AvgAddrTakenVarPtsSize = _NumOfAddrTakeVar = 0;
     _MaxAddrTakenVarPts = 0;
     _TotalPtsSize = 0;
+    _InOutPtsMem = 0;
+    _NumOfVersionedPts = 0;
+    _VersionedPtsMem = 0;
 
     for (int i=IN; i<=OUT; i++)
     {
@@ -96,6 +100,10 @@ void FlowSensitiveStat::performStat()
     // stat address-taken variables' points-to
     statAddrVarPtsSize();
 
+    const VersionedFlowSensitive* vfspta = SVFUtil::dyn_cast<VersionedFlowSensitive>(fspta);
+    if (vfspta)
+        statVersionedPts(vfspta);
+
     u32_t fiObjNumber = 0;
     u32_t fsObjNumber = 0;
     Set<SymID> nodeSet;
@@ -162,6 +170,7 @@ void FlowSensitiveStat::performStat()
     PTNumStatMap[NumOfStores] = numOfStore;
 
     PTNumStatMap[NumOfIterations] = fspta->numOfIteration;
+    PTNumStatMap["WorklistPops"] = fspta->getNumOfWorklistPops();
 
     PTNumStatMap[NumOfIndirectEdgeSolved] = fspta->getNumOfResolvedIndCallEdge();
 
@@ -169,6 +178,9 @@ void FlowSensitiveStat::performStat()
     PTNumStatMap["PointsToConstPtr"] = _NumOfConstantPtr;
     PTNumStatMap["PointsToBlkPtr"] = _NumOfBlackholePtr;
 
+    ptCacheStat();
+    clusterStat();
+
     PTNumStatMap["StrongUpdates"] = fspta->svfgHasSU.count();
 
     /// SVFG nodes.
@@ -235,6 +247,24 @@ void FlowSensitiveStat::performStat()
                                         0 : ((double)_AvgAddrTakenVarPtsSize / _NumOfAddrTakeVar);
     PTNumStatMap["MaxAddrTakenVarPts"] = _MaxAddrTakenVarPts;
 
+    /// memory of the points-to sets of address-taken objects, either in IN/OUT sets or in versions
+    PTNumStatMap["INOUTPtsMemKB"] = _InOutPtsMem / 1024;
+    u32_t vmhwm = 0;
+    if (SVFUtil::getPeakMemoryUsageKB(&vmhwm))
+        PTNumStatMap[PeakMemUsage] = vmhwm;
+
+    if (vfspta)
+    {
+        PTNumStatMap["Versions"] = vfspta->numOfVersions;
+        PTNumStatMap["Prelabels"] = vfspta->numOfPrelabels;
+        PTNumStatMap["VersionReliances"] = vfspta->numOfVersionReliances;
+        PTNumStatMap["VersionedPts"] = _NumOfVersionedPts;
+        PTNumStatMap["VersionedPtsMemKB"] = _VersionedPtsMem / 1024;
+        timeStatMap["MeldLabelTime"] = vfspta->meldLabelTime;
+        timeStatMap["RelianceTime"] = vfspta->relianceTime;
+        timeStatMap["VersionPropTime"] = vfspta->versionPropTime;
+    }
+
     timeStatMap["AvgINPtsSize"] = _AvgInOutPtsSize[IN];
     timeStatMap["AvgOUTPtsSize"] = _AvgInOutPtsSize[OUT];
 
@@ -410,6 +440,7 @@ void FlowSensitiveStat::statInOutPtsSize(const DFInOutMap& data, ENUM_INOUT inOr
                 assert(false && "unexpected node have IN/OUT set");
 
             inOutPtsSize += ptsNum;
+            _InOutPtsMem += ptsIt->second.getMemoryUsage();
 
             if (ptsNum > _MaxInOutPtsSize[inOrOut])
                 _MaxInOutPtsSize[inOrOut] = ptsNum;
@@ -424,6 +455,23 @@ void FlowSensitiveStat::statInOutPtsSize(const DFInOutMap& data, ENUM_INOUT inOr
     _TotalPtsSize += inOutPtsSize;
 }
 
+/*!
+ * Number and memory of the points-to sets of versions
+ */
+void FlowSensitiveStat::statVersionedPts(const VersionedFlowSensitive* vfspta)
+{
+    for (const auto& objIt : vfspta->versionPts)
+    {
+        for (const auto& versionIt : objIt.second)
+        {
+            if (versionIt.second.empty())
+                continue;
+            _NumOfVersionedPts++;
+            _VersionedPtsMem += versionIt.second.getMemoryUsage();
+        }
+    }
+}
+
 /*!
  * Points-to size
  */
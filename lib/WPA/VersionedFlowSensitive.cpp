@@ -0,0 +1,497 @@
+//===- VersionedFlowSensitive.cpp -- Versioned flow-sensitive pointer analysis-//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * VersionedFlowSensitive.cpp
+ */
+
+#include "WPA/VersionedFlowSensitive.h"
+#include "WPA/WPAStat.h"
+#include "Util/WorkList.h"
+
+using namespace SVF;
+using namespace SVFUtil;
+
+/*!
+ * Constructor
+ */
+VersionedFlowSensitive::VersionedFlowSensitive(PAG* _pag, PTATY type) : FlowSensitive(_pag, type)
+{
+    numOfVersions = numOfPrelabels = numOfVersionReliances = 0;
+    meldLabelTime = relianceTime = versionPropTime = 0;
+}
+
+/*!
+ * Hash of a set of labels
+ */
+size_t VersionedFlowSensitive::LabelsHash::operator()(const NodeBS& labels) const
+{
+    std::hash<std::pair<size_t, NodeID> > h;
+    size_t hash = labels.count();
+    for (NodeID l : labels)
+        hash = h(std::make_pair(hash, l));
+    return hash;
+}
+
+/*!
+ * Initialize analysis: build the SVFG, then version it
+ */
+void VersionedFlowSensitive::initialize()
+{
+    FlowSensitive::initialize();
+
+    double start = stat->getClk(true);
+    meldLabel();
+    double labelled = stat->getClk(true);
+    buildReliance();
+    double end = stat->getClk(true);
+
+    meldLabelTime += (labelled - start) / TIMEINTERVAL;
+    relianceTime += (end - labelled) / TIMEINTERVAL;
+}
+
+/*!
+ * Formal-ins of address-taken functions and actual-outs of indirect call sites
+ * are the nodes new call edges are connected to (the ones SVFGOPT keeps)
+ */
+bool VersionedFlowSensitive::isDelta(const SVFGNode* node) const
+{
+    if (const FormalINSVFGNode* fi = SVFUtil::dyn_cast<FormalINSVFGNode>(node))
+        return fi->getFun()->getLLVMFun()->hasAddressTaken();
+    else if (const ActualOUTSVFGNode* ao = SVFUtil::dyn_cast<ActualOUTSVFGNode>(node))
+        return pag->isIndirectCallSites(ao->getCallSite());
+    return false;
+}
+
+/*!
+ * Objects propagated along an indirect edge (see FlowSensitive::propAlongIndirectEdge)
+ */
+void VersionedFlowSensitive::getEdgeObjs(const IndirectSVFGEdge* edge, NodeBS& objs)
+{
+    objs.clear();
+    for (NodeID o : edge->getPointsTo())
+    {
+        objs.set(o);
+        if (isFieldInsensitive(o))
+            objs |= getAllFieldsObjNode(o);
+    }
+}
+
+/*!
+ * Get (or create) the version of a set of labels
+ */
+VersionedFlowSensitive::Version VersionedFlowSensitive::getVersion(const NodeBS& labels)
+{
+    auto it = labelsToVersion.find(labels);
+    if (it != labelsToVersion.end())
+        return it->second;
+
+    Version v = versionLabels.size();
+    versionLabels.push_back(labels);
+    labelsToVersion[labels] = v;
+    ++numOfVersions;
+    return v;
+}
+
+/*!
+ * Meld labelling.
+ * A node's consumed version of o is the meld (union of labels) of the versions of o
+ * yielded by its predecessors, starting from the fresh labels of stores and delta
+ * nodes. Only the objects whose yielded version changed are pushed along edges.
+ */
+void VersionedFlowSensitive::meldLabel()
+{
+    NodeID numOfNodes = 0;
+    for (SVFG::iterator it = svfg->begin(), eit = svfg->end(); it != eit; ++it)
+        numOfNodes = std::max(numOfNodes, it->first + 1);
+    consume.assign(numOfNodes, ObjToVersionMap());
+    yield.assign(numOfNodes, ObjToVersionMap());
+
+    /// version 0 stands for no version
+    versionLabels.push_back(NodeBS());
+
+    FIFOWorkList<NodeID> worklist;
+    std::vector<NodeBS> changedObjs(numOfNodes);
+    NodeID nextLabel = 0;
+    NodeBS objs;
+
+    /// prelabelling
+    for (SVFG::iterator it = svfg->begin(), eit = svfg->end(); it != eit; ++it)
+    {
+        NodeID id = it->first;
+        SVFGNode* node = it->second;
+        bool store = SVFUtil::isa<StoreSVFGNode>(node);
+        bool delta = isDelta(node);
+        if (!store && !delta)
+            continue;
+
+        /// stores label the objects they pass on, delta nodes those they may receive:
+        /// their indirect in-edges are added on the fly when callees are resolved, so
+        /// every object of their memory region is labelled, not only those of the
+        /// edges found before solving
+        NodeBS labelledObjs;
+        if (delta)
+        {
+            const MRSVFGNode* mrNode = SVFUtil::cast<MRSVFGNode>(node);
+            for (NodeID o : mrNode->getPointsTo())
+            {
+                labelledObjs.set(o);
+                if (isFieldInsensitive(o))
+                    labelledObjs |= getAllFieldsObjNode(o);
+            }
+        }
+        for (SVFGEdge* edge : (store ? node->getOutEdges() : node->getInEdges()))
+        {
+            const IndirectSVFGEdge* indEdge = SVFUtil::dyn_cast<IndirectSVFGEdge>(edge);
+            if (indEdge == NULL)
+                continue;
+            getEdgeObjs(indEdge, objs);
+            labelledObjs |= objs;
+        }
+
+        ObjToVersionMap& labelled = store ? yield[id] : consume[id];
+        for (NodeID o : labelledObjs)
+        {
+            NodeBS label;
+            label.set(nextLabel++);
+            labelled[o] = getVersion(label);
+            ++numOfPrelabels;
+            changedObjs[id].set(o);
+        }
+        if (!changedObjs[id].empty())
+            worklist.push(id);
+    }
+
+    while (!worklist.empty())
+    {
+        NodeID id = worklist.pop();
+        NodeBS changed;
+        std::swap(changed, changedObjs[id]);
+
+        SVFGNode* node = svfg->getSVFGNode(id);
+        for (SVFGEdge* edge : node->getOutEdges())
+        {
+            const IndirectSVFGEdge* indEdge = SVFUtil::dyn_cast<IndirectSVFGEdge>(edge);
+            if (indEdge == NULL)
+                continue;
+            const SVFGNode* dst = indEdge->getDstNode();
+            /// delta nodes keep their own version, new edges must not leak into others
+            if (isDelta(dst))
+                continue;
+
+            NodeID dstId = dst->getId();
+            getEdgeObjs(indEdge, objs);
+            for (NodeID o : changed)
+            {
+                if (!objs.test(o))
+                    continue;
+                Version y = getYield(id, o);
+                if (y == 0)
+                    continue;
+
+                Version& c = consume[dstId][o];
+                Version melded = y;
+                if (c != 0)
+                {
+                    NodeBS labels = versionLabels[c];
+                    if (!(labels |= versionLabels[y]))
+                        continue;
+                    melded = getVersion(labels);
+                }
+                if (melded == c)
+                    continue;
+                c = melded;
+
+                /// stores pass on their own versions
+                if (yield[dstId].count(o) == 0)
+                {
+                    if (changedObjs[dstId].empty())
+                        worklist.push(dstId);
+                    changedObjs[dstId].set(o);
+                }
+            }
+        }
+    }
+
+    /// the labels are not needed any more
+    versionLabels.clear();
+    labelsToVersion.clear();
+}
+
+/*!
+ * Build the reliances: along an indirect edge, the version consumed at the
+ * destination includes the version yielded at the source; loads and stores
+ * are re-processed whenever the version they consume changes.
+ */
+void VersionedFlowSensitive::buildReliance()
+{
+    NodeBS objs;
+    for (SVFG::iterator it = svfg->begin(), eit = svfg->end(); it != eit; ++it)
+    {
+        NodeID id = it->first;
+        SVFGNode* node = it->second;
+        for (SVFGEdge* edge : node->getOutEdges())
+        {
+            const IndirectSVFGEdge* indEdge = SVFUtil::dyn_cast<IndirectSVFGEdge>(edge);
+            if (indEdge == NULL)
+                continue;
+            getEdgeObjs(indEdge, objs);
+            for (NodeID o : objs)
+            {
+                Version y = getYield(id, o);
+                Version c = getConsume(indEdge->getDstID(), o);
+                if (y != 0 && c != 0 && y != c)
+                    addVersionReliance(o, y, c);
+            }
+        }
+
+        if (SVFUtil::isa<LoadSVFGNode>(node) || SVFUtil::isa<StoreSVFGNode>(node))
+        {
+            for (const ObjToVersionMap::value_type& ov : consume[id])
+                stmtReliance[ov.first][ov.second].set(id);
+        }
+    }
+}
+
+/*!
+ * Add a reliance between two versions of obj
+ */
+bool VersionedFlowSensitive::addVersionReliance(NodeID obj, Version from, Version to)
+{
+    if (versionReliance[obj][from].insert(to).second)
+    {
+        ++numOfVersionReliances;
+        return true;
+    }
+    return false;
+}
+
+/*!
+ * Propagate a changed version to the versions relying on it
+ */
+void VersionedFlowSensitive::propagateVersion(NodeID obj, Version v)
+{
+    double start = stat->getClk();
+
+    VersionRelianceMap& reliance = versionReliance[obj];
+    VersionToStmtsMap& stmts = stmtReliance[obj];
+
+    FIFOWorkList<Version> worklist;
+    worklist.push(v);
+    while (!worklist.empty())
+    {
+        Version from = worklist.pop();
+
+        VersionToStmtsMap::const_iterator sit = stmts.find(from);
+        if (sit != stmts.end())
+        {
+            for (NodeID stmt : sit->second)
+                pushIntoWorklist(stmt);
+        }
+
+        VersionRelianceMap::const_iterator rit = reliance.find(from);
+        if (rit == reliance.end())
+            continue;
+        const PointsTo& fromPts = getVersionPts(obj, from);
+        for (Version to : rit->second)
+        {
+            if (unionVersionPts(obj, to, fromPts))
+                worklist.push(to);
+        }
+    }
+
+    double end = stat->getClk();
+    versionPropTime += (end - start) / TIMEINTERVAL;
+}
+
+/*!
+ * Process each SVFG node, there are no IN/OUT flags to clear
+ */
+void VersionedFlowSensitive::processNode(NodeID nodeId)
+{
+    SVFGNode* node = svfg->getSVFGNode(nodeId);
+    if (processSVFGNode(node))
+        propagate(&node);
+}
+
+/*!
+ * Process load node: pts(dst) = union pts(o, version of o consumed here)
+ */
+bool VersionedFlowSensitive::processLoad(const LoadSVFGNode* load)
+{
+    double start = stat->getClk();
+    bool changed = false;
+
+    NodeID loadId = load->getId();
+    NodeID dstVar = load->getPAGDstNodeID();
+
+    const PointsTo& srcPts = getPts(load->getPAGSrcNodeID());
+    for (PointsTo::iterator ptdIt = srcPts.begin(); ptdIt != srcPts.end(); ++ptdIt)
+    {
+        NodeID ptd = *ptdIt;
+
+        if (pag->isConstantObj(ptd) || pag->isNonPointerObj(ptd))
+            continue;
+
+        if (Version v = getConsume(loadId, ptd))
+        {
+            if (unionPts(dstVar, getVersionPts(ptd, v)))
+                changed = true;
+        }
+
+        if (isFieldInsensitive(ptd))
+        {
+            const NodeBS& allFields = getAllFieldsObjNode(ptd);
+            for (NodeBS::iterator fieldIt = allFields.begin(), fieldEit = allFields.end();
+                    fieldIt != fieldEit; ++fieldIt)
+            {
+                if (Version v = getConsume(loadId, *fieldIt))
+                {
+                    if (unionPts(dstVar, getVersionPts(*fieldIt, v)))
+                        changed = true;
+                }
+            }
+        }
+    }
+
+    double end = stat->getClk();
+    loadTime += (end - start) / TIMEINTERVAL;
+    return changed;
+}
+
+/*!
+ * Process store node: the yielded version of each object stored to takes pts(src),
+ * and, unless strongly updated, the consumed version
+ */
+bool VersionedFlowSensitive::processStore(const StoreSVFGNode* store)
+{
+    const PointsTo& dstPts = getPts(store->getPAGDstNodeID());
+
+    /// see FlowSensitive::processStore
+    if (dstPts.empty())
+        return false;
+
+    double start = stat->getClk();
+    NodeID storeId = store->getId();
+    NodeBS changedObjs;
+
+    const PointsTo& srcPts = getPts(store->getPAGSrcNodeID());
+    if (srcPts.empty() == false)
+    {
+        for (PointsTo::iterator it = dstPts.begin(), eit = dstPts.end(); it != eit; ++it)
+        {
+            NodeID ptd = *it;
+
+            if (pag->isConstantObj(ptd) || pag->isNonPointerObj(ptd))
+                continue;
+
+            /// no version means nothing reads it after this store
+            Version y = getYield(storeId, ptd);
+            if (y != 0 && unionVersionPts(ptd, y, srcPts))
+                changedObjs.set(ptd);
+        }
+    }
+
+    double end = stat->getClk();
+    storeTime += (end - start) / TIMEINTERVAL;
+
+    double updateStart = stat->getClk();
+    NodeID singleton;
+    bool isSU = isStrongUpdate(store, singleton);
+    if (isSU)
+        svfgHasSU.set(storeId);
+    else
+        svfgHasSU.reset(storeId);
+
+    for (const ObjToVersionMap::value_type& ov : yield[storeId])
+    {
+        NodeID o = ov.first;
+        if (isSU && o == singleton)
+            continue;
+        Version c = getConsume(storeId, o);
+        if (c != 0 && c != ov.second && unionVersionPts(o, ov.second, getVersionPts(o, c)))
+            changedObjs.set(o);
+    }
+    double updateEnd = stat->getClk();
+    updateTime += (updateEnd - updateStart) / TIMEINTERVAL;
+
+    for (NodeID o : changedObjs)
+        propagateVersion(o, getYield(storeId, o));
+
+    return !changedObjs.empty();
+}
+
+/*!
+ * New call edges only reach delta nodes, which have versions of their own:
+ * the consumed version now relies on the yielded one at the other end.
+ */
+void VersionedFlowSensitive::updateConnectedNodes(const SVFG::SVFGEdgeSetTy& edges)
+{
+    NodeBS objs;
+    for (SVFG::SVFGEdgeSetTy::const_iterator it = edges.begin(), eit = edges.end();
+            it != eit; ++it)
+    {
+        const SVFGEdge* edge = *it;
+        SVFGNode* dstNode = edge->getDstNode();
+        if (SVFUtil::isa<PHISVFGNode>(dstNode))
+        {
+            /// If this is a formal-param or actual-ret node, we need to solve this phi
+            /// node in next iteration
+            pushIntoWorklist(dstNode->getId());
+        }
+        else if (const IndirectSVFGEdge* indEdge = SVFUtil::dyn_cast<IndirectSVFGEdge>(edge))
+        {
+            NodeID srcId = indEdge->getSrcID();
+            NodeID dstId = indEdge->getDstID();
+            getEdgeObjs(indEdge, objs);
+            for (NodeID o : objs)
+            {
+                Version y = getYield(srcId, o);
+                Version c = getConsume(dstId, o);
+                if (y == 0 || c == 0 || y == c)
+                    continue;
+                if (addVersionReliance(o, y, c) && unionVersionPts(o, c, getVersionPts(o, y)))
+                    propagateVersion(o, c);
+            }
+        }
+    }
+}
+
+/*!
+ * Points-to set of node in the version consumed at stmt
+ */
+const PointsTo& VersionedFlowSensitive::getDFInPtsSet(const SVFGNode* stmt, const NodeID node)
+{
+    static PointsTo empty;
+    Version v = getConsume(stmt->getId(), node);
+    return v == 0 ? empty : getVersionPts(node, v);
+}
+
+/*!
+ * Points-to set of node in the version yielded at stmt
+ */
+const PointsTo& VersionedFlowSensitive::getDFOutPtsSet(const SVFGNode* stmt, const NodeID node)
+{
+    static PointsTo empty;
+    Version v = getYield(stmt->getId(), node);
+    return v == 0 ? empty : getVersionPts(node, v);
+}
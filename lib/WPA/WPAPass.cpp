@@ -35,11 +35,13 @@
 
 #include "Util/SVFModule.h"
 #include "MemoryModel/PointerAnalysisImpl.h"
+#include "MemoryModel/PTAStat.h"
 #include "WPA/WPAPass.h"
 #include "WPA/Andersen.h"
 #include "WPA/AndersenSFR.h"
 #include "WPA/FlowSensitive.h"
 #include "WPA/FlowSensitiveTBHC.h"
+#include "WPA/VersionedFlowSensitive.h"
 #include "WPA/TypeAnalysis.h"
 #include "SVF-FE/PAGBuilder.h"
 
@@ -67,6 +69,7 @@ static llvm::cl::bits<PointerAnalysis::PTATY> PASelected(llvm::cl::desc("Select
             // clEnumValN(PointerAnalysis::AndersenWaveDiffWithType_WPA, "andertype", "Diff wave propagation with type inclusion-based analysis"),
             clEnumValN(PointerAnalysis::FSSPARSE_WPA, "fspta", "Sparse flow sensitive pointer analysis"),
             clEnumValN(PointerAnalysis::FSTBHC_WPA, "fstbhc", "Sparse flow-sensitive type-based heap cloning pointer analysis"),
+            clEnumValN(PointerAnalysis::VFS_WPA, "vfspta", "Versioned sparse flow-sensitive pointer analysis"),
             clEnumValN(PointerAnalysis::TypeCPP_WPA, "type", "Type-based fast analysis for Callgraph, PAG and CHA")
         ));
 
@@ -94,6 +97,7 @@ WPAPass::~WPAPass()
     for (; it != eit; ++it)
     {
         PointerAnalysis* pta = *it;
+        printAliasCacheStat(pta);
         delete pta;
     }
     ptaVector.clear();
@@ -163,6 +167,9 @@ void WPAPass::runPointerAnalysis(SVFModule* svfModule, u32_t kind)
     case PointerAnalysis::FSTBHC_WPA:
         _pta = new FlowSensitiveTBHC(pag);
         break;
+    case PointerAnalysis::VFS_WPA:
+        _pta = new VersionedFlowSensitive(pag);
+        break;
     case PointerAnalysis::TypeCPP_WPA:
         _pta = new TypeAnalysis(pag);
         break;
@@ -187,6 +194,20 @@ void WPAPass::runPointerAnalysis(SVFModule* svfModule, u32_t kind)
         PrintAliasPairs(_pta);
 }
 
+/*!
+ * Print how many alias queries were answered by the alias cache of a pointer analysis
+ */
+void WPAPass::printAliasCacheStat(PointerAnalysis* pta)
+{
+    const BVDataPTAImpl* bvpta = SVFUtil::dyn_cast<BVDataPTAImpl>(pta);
+    if (bvpta == NULL || pta->getStat() == NULL || !pta->printStat()
+            || bvpta->getNumOfAliasCacheHits() + bvpta->getNumOfAliasCacheMisses() == 0)
+        return;
+
+    pta->getStat()->aliasCacheStat();
+    pta->getStat()->printStat("Alias Query Statistics");
+}
+
 void WPAPass::PrintAliasPairs(PointerAnalysis* pta)
 {
     PAG* pag = pta->getPAG();
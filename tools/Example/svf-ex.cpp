@@ -56,8 +56,8 @@ std::string printPts(PointerAnalysis* pta, Value* val)
     raw_string_ostream rawstr(str);
 
     NodeID pNodeId = pta->getPAG()->getValueNode(val);
-    const NodeBS& pts = pta->getPts(pNodeId);
-    for (NodeBS::iterator ii = pts.begin(), ie = pts.end();
+    const PointsTo& pts = pta->getPts(pNodeId);
+    for (PointsTo::iterator ii = pts.begin(), ie = pts.end();
             ii != ie; ii++)
     {
         rawstr << " " << *ii << " ";